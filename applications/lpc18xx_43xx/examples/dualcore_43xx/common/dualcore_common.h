@@ -75,6 +75,7 @@
 #define TASK_PRIO_TOUCHSCREEN     (tskIDLE_PRIORITY + 1UL)
 #define TASK_PRIO_BLINKY_EVENT    (tskIDLE_PRIORITY + 1UL)
 #define TASK_PRIO_ETHERNET        (tskIDLE_PRIORITY + 2UL)
+#define TASK_PRIO_NETPROXY        (tskIDLE_PRIORITY + 2UL)
 #define TASK_PRIO_IPC_DISPATCH    (tskIDLE_PRIORITY + 3UL)
 #define TASK_PRIO_USBDEVICE       (tskIDLE_PRIORITY + 4UL)
 #define TASK_PRIO_LWIP_THREAD     (tskIDLE_PRIORITY + 5UL)
@@ -246,6 +247,19 @@ extern void USBDEV_Init(void);
  */
 extern void LWIP_Init(void);
 
+/**
+ * @brief	Network proxy example initialisation function
+ *
+ * This function initializes the application side of the network proxy,
+ * which lets this core use the lwIP stack running on the other core (or on
+ * this core when EXAMPLE_LWIP is also defined). *This function is called by
+ * @link EXAMPLE_DUALCORE_CMN_MAIN main()@endlink only when EXAMPLE_NETPROXY
+ * is defined*.
+ *
+ * @return None
+ */
+extern void NETPROXY_Init(void);
+
 /**
  * @brief	emWin dual core example initialisation function
  *
@@ -337,6 +351,19 @@ extern void usb_device_tasks(void);
  */
 extern void lwip_tasks(void);
 
+/**
+ * @brief	Network proxy benchmark task
+ *
+ * Creates the TCP echo and discard services of the network proxy benchmark
+ * and the task reporting their throughput, the proxy latency and the CPU
+ * cycles left to the application. *Called by dual core @link
+ * EXAMPLE_DUALCORE_CMN_MAIN main()@endlink only when EXAMPLE_NETPROXY is
+ * defined*.
+ *
+ * @return None
+ */
+extern void netproxy_tasks(void);
+
 /**
  * @brief	emWin dual core example task
  *
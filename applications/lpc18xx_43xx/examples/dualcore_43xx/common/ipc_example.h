@@ -69,6 +69,8 @@ extern "C" {
 #define IPCEX_ID_FREEMEM       1  /*!< Frees memory allocated by other core */
 #define IPCEX_ID_GBLUPDATE     2  /*!< Update global variable or other core */
 #define IPCEX_ID_BLINKY        4  /*!< Blinky IPC event ID */
+#define IPCEX_ID_NETPROXY      5  /*!< Network proxy request and completion */
+#define IPCEX_ID_NETPROXY_FREE 6  /*!< Network proxy received data release */
 #define IPCEX_ID_USER1         10 /*!< Used by Example IPC code */
 #define IPCEX_ID_USER2         11 /*!< IPC ID that can be used by other user examples */
 
@@ -150,6 +150,9 @@ static void prvSetupHardware(void)
 	#ifdef EXAMPLE_LWIP
 	LWIP_Init();
 	#endif
+	#ifdef EXAMPLE_NETPROXY
+	NETPROXY_Init();
+	#endif
 	#ifdef EXAMPLE_EMWIN
 	EMWIN_Init();
 	#endif
@@ -181,6 +184,9 @@ static void main_tasks(void)
 #ifdef EXAMPLE_LWIP
 		lwip_tasks();
 #endif
+#ifdef EXAMPLE_NETPROXY
+		netproxy_tasks();
+#endif
 #ifdef EXAMPLE_EMWIN
 		emwin_tasks();
 #endif
@@ -0,0 +1,341 @@
+/*
+ * @brief Dual core network proxy, application core side
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "app_dualcore_cfg.h"
+#include "ipc_msg.h"
+#include "ipc_example.h"
+#include "net_proxy.h"
+
+#ifdef EXAMPLE_NETPROXY
+
+#ifndef OS_FREE_RTOS
+#error "The network proxy requires FreeRTOS"
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/** @ingroup EXAMPLE_DUALCORE_NETPROXY
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Request blocks, read and written by the stack core */
+static struct nproxy_req nproxy_reqs[NPROXY_MAX_REQ];
+
+/* Completion semaphore of each request block */
+static SemaphoreHandle_t nproxy_done[NPROXY_MAX_REQ];
+
+/* Counts the free request blocks, nproxy_used marks the ones in use */
+static SemaphoreHandle_t nproxy_slots;
+static uint32_t nproxy_used;
+
+/* Set once the stack core accepts requests */
+static volatile int nproxy_ready;
+
+static struct nproxy_stats nproxy_stats;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Cycle counter, used for the latency statistics */
+static INLINE uint32_t nproxy_cycles(void)
+{
+#if (__CORTEX_M >= 3)
+	return DWT->CYCCNT;
+#else
+	return 0;
+#endif
+}
+
+/* Get a free request block, waits when all are in use */
+static struct nproxy_req *nproxy_get_req(void)
+{
+	int idx;
+
+	if (xSemaphoreTake(nproxy_slots, 0) != pdTRUE) {
+		nproxy_stats.slot_waits++;
+		xSemaphoreTake(nproxy_slots, portMAX_DELAY);
+	}
+
+	taskENTER_CRITICAL();
+	for (idx = 0; nproxy_used & (1 << idx); idx++) {}
+	nproxy_used |= 1 << idx;
+	taskEXIT_CRITICAL();
+
+	return &nproxy_reqs[idx];
+}
+
+/* Return a request block */
+static void nproxy_put_req(struct nproxy_req *req)
+{
+	taskENTER_CRITICAL();
+	nproxy_used &= ~(1 << (req - nproxy_reqs));
+	taskEXIT_CRITICAL();
+
+	xSemaphoreGive(nproxy_slots);
+}
+
+/* Run a request and wait for its completion */
+static int nproxy_call(struct nproxy_req *req)
+{
+	/* Wait until the stack is up */
+	while (!nproxy_ready) {
+#if NPROXY_LOCAL
+		nproxy_ready = nproxy_server_ready();
+		if (nproxy_ready) {
+			break;
+		}
+#endif
+		vTaskDelay(configTICK_RATE_HZ / 100);
+	}
+
+	nproxy_stats.calls++;
+#if NPROXY_LOCAL
+	nproxy_server_exec(req);
+#else
+	ipcex_msgPush(IPCEX_ID_NETPROXY, (uint32_t) req);
+	xSemaphoreTake(nproxy_done[req - nproxy_reqs], portMAX_DELAY);
+#endif
+
+	return req->err;
+}
+
+#if NPROXY_LOCAL == 0
+/* IPC callback, a request completed on the stack core */
+static void nproxy_complete(uint32_t data)
+{
+	struct nproxy_req *req = (struct nproxy_req *) data;
+
+	if (req == NULL) {
+		nproxy_ready = 1;
+	}
+	else {
+		xSemaphoreGive(nproxy_done[req - nproxy_reqs]);
+	}
+}
+
+#endif
+
+/* Issue a request that takes a connection and an address */
+static int nproxy_addr_req(nproxy_conn_t conn, int op, uint32_t addr, uint16_t port)
+{
+	struct nproxy_req *req = nproxy_get_req();
+	int err;
+
+	req->op = (uint8_t) op;
+	req->conn = conn;
+	req->addr = addr;
+	req->port = port;
+	err = nproxy_call(req);
+	nproxy_put_req(req);
+
+	return err;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Initialize the application side of the proxy */
+void nproxy_init(void)
+{
+	int i;
+
+	nproxy_slots = xSemaphoreCreateCounting(NPROXY_MAX_REQ, NPROXY_MAX_REQ);
+	for (i = 0; i < NPROXY_MAX_REQ; i++) {
+		vSemaphoreCreateBinary(nproxy_done[i]);
+		if (nproxy_done[i] != NULL) {
+			xSemaphoreTake(nproxy_done[i], 0);
+		}
+		else {
+			nproxy_slots = NULL;
+		}
+	}
+	if (nproxy_slots == NULL) {
+		DEBUGSTR("ERROR: Unable to create network proxy semaphores\r\n");
+		while (1) {}
+	}
+
+#if (__CORTEX_M >= 3)
+	/* Cycle counter for the latency statistics */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+#if NPROXY_LOCAL == 0
+	ipcex_register_callback(IPCEX_ID_NETPROXY, nproxy_complete);
+#endif
+}
+
+/* Create a new connection */
+nproxy_conn_t nproxy_new(int type)
+{
+	struct nproxy_req *req = nproxy_get_req();
+	nproxy_conn_t conn;
+
+	req->op = NPROXY_OP_NEW;
+	req->port = (uint16_t) type;
+	conn = (nproxy_call(req) == NPROXY_OK) ? req->newconn : NULL;
+	nproxy_put_req(req);
+
+	return conn;
+}
+
+/* Bind a connection to a local port */
+int nproxy_bind(nproxy_conn_t conn, uint32_t addr, uint16_t port)
+{
+	return nproxy_addr_req(conn, NPROXY_OP_BIND, addr, port);
+}
+
+/* Connect to a remote host */
+int nproxy_connect(nproxy_conn_t conn, uint32_t addr, uint16_t port)
+{
+	return nproxy_addr_req(conn, NPROXY_OP_CONNECT, addr, port);
+}
+
+/* Put a bound TCP connection in listen mode */
+int nproxy_listen(nproxy_conn_t conn)
+{
+	return nproxy_addr_req(conn, NPROXY_OP_LISTEN, 0, 0);
+}
+
+/* Wait for an incoming TCP connection */
+int nproxy_accept(nproxy_conn_t conn, nproxy_conn_t *newconn)
+{
+	struct nproxy_req *req = nproxy_get_req();
+	int err;
+
+	req->op = NPROXY_OP_ACCEPT;
+	req->conn = conn;
+	err = nproxy_call(req);
+	*newconn = req->newconn;
+	nproxy_put_req(req);
+
+	return err;
+}
+
+/* Wait for received data */
+int nproxy_recv(nproxy_conn_t conn, struct nproxy_buf *buf)
+{
+	struct nproxy_req *req = nproxy_get_req();
+	int err;
+
+	req->op = NPROXY_OP_RECV;
+	req->conn = conn;
+	req->buf = buf;
+	buf->handle = NULL;
+	buf->nsegs = 0;
+	buf->tot_len = 0;
+	err = nproxy_call(req);
+	nproxy_put_req(req);
+
+	return err;
+}
+
+/* Return received data to the stack core */
+void nproxy_recv_done(struct nproxy_buf *buf)
+{
+	if (buf->handle == NULL) {
+		return;
+	}
+
+#if NPROXY_LOCAL
+	nproxy_server_free(buf->handle);
+#else
+	ipcex_msgPush(IPCEX_ID_NETPROXY_FREE, (uint32_t) buf->handle);
+#endif
+	buf->handle = NULL;
+}
+
+/* Send data to a given host */
+int nproxy_sendto(nproxy_conn_t conn, const void *data, uint32_t len,
+				  uint32_t addr, uint16_t port)
+{
+	struct nproxy_req *req = nproxy_get_req();
+	uint32_t start, cycles;
+	int err;
+
+	start = nproxy_cycles();
+	req->op = NPROXY_OP_SEND;
+	req->conn = conn;
+	req->data = data;
+	req->len = len;
+	req->addr = addr;
+	req->port = port;
+	err = nproxy_call(req);
+	nproxy_put_req(req);
+
+	cycles = nproxy_cycles() - start;
+	nproxy_stats.sends++;
+	nproxy_stats.send_cycles += cycles;
+	if (cycles > nproxy_stats.send_max) {
+		nproxy_stats.send_max = cycles;
+	}
+
+	return err;
+}
+
+/* Send data */
+int nproxy_send(nproxy_conn_t conn, const void *data, uint32_t len)
+{
+	return nproxy_sendto(conn, data, len, 0, 0);
+}
+
+/* Close and delete a connection */
+int nproxy_close(nproxy_conn_t conn)
+{
+	return nproxy_addr_req(conn, NPROXY_OP_CLOSE, 0, 0);
+}
+
+/* Read the proxy statistics of this core */
+void nproxy_get_stats(struct nproxy_stats *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = nproxy_stats;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @}
+ */
+
+#endif /* EXAMPLE_NETPROXY */
@@ -0,0 +1,294 @@
+/*
+ * @brief Dual core network proxy, shared definitions and API
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __NET_PROXY_H_
+#define __NET_PROXY_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup EXAMPLE_DUALCORE_NETPROXY Network proxy between the M0 and M4 cores
+ * @ingroup EXAMPLE_DUALCORE_LWIP
+ * The network proxy runs lwIP and the EMAC driver on one core (the stack
+ * core, normally the M0) and gives the other core (the application core,
+ * normally the M4) a small blocking socket style API. Requests are passed
+ * through the IPC queue in shared memory and executed with the netconn API
+ * by a pool of worker tasks on the stack core.<br>
+ *
+ * Received data is handed over without copying: nproxy_recv() returns
+ * pointers into the pbufs owned by the stack core, which stay valid until
+ * nproxy_recv_done() returns them. Sent data is copied into pbufs by the
+ * stack core, the application core spends no cycles on it.<br>
+ *
+ * When lwIP runs on the same core (EXAMPLE_LWIP defined along with
+ * EXAMPLE_NETPROXY) the requests are executed directly by the calling task,
+ * which gives the single core reference for benchmarks.
+ * @{
+ */
+
+/**
+ * \def NPROXY_MAX_REQ
+ * Maximum number of requests the application core can have outstanding,
+ * which is also the number of worker tasks on the stack core. Every task
+ * blocked in nproxy_accept() or nproxy_recv() holds one.
+ */
+#ifndef NPROXY_MAX_REQ
+#define NPROXY_MAX_REQ          4
+#endif
+
+/**
+ * \def NPROXY_MAX_SEGS
+ * Maximum number of segments returned by one nproxy_recv(). The rest of a
+ * longer TCP pbuf chain is returned by the following nproxy_recv() calls, a
+ * longer UDP datagram is copied into a single buffer by the stack core.
+ */
+#ifndef NPROXY_MAX_SEGS
+#define NPROXY_MAX_SEGS         4
+#endif
+
+/**
+ * \def NPROXY_LOCAL
+ * 1 when lwIP runs on the calling core, requests are then executed
+ * directly instead of going through the IPC queue
+ */
+#if defined(EXAMPLE_LWIP) && defined(EXAMPLE_NETPROXY)
+#define NPROXY_LOCAL            1
+#else
+#define NPROXY_LOCAL            0
+#endif
+
+/* Connection types for nproxy_new() */
+#define NPROXY_TCP              0	/*!< TCP connection */
+#define NPROXY_UDP              1	/*!< UDP connection */
+
+/* Return values, any other negative value is an lwIP err_t */
+#define NPROXY_OK               0	/*!< Request completed */
+#define NPROXY_ERR_MEM          -1	/*!< Out of memory */
+#define NPROXY_ERR_CLSD         -12	/*!< Connection closed by the peer */
+
+/* Request codes */
+#define NPROXY_OP_NEW           0
+#define NPROXY_OP_BIND          1
+#define NPROXY_OP_CONNECT       2
+#define NPROXY_OP_LISTEN        3
+#define NPROXY_OP_ACCEPT        4
+#define NPROXY_OP_RECV          5
+#define NPROXY_OP_SEND          6
+#define NPROXY_OP_CLOSE         7
+
+/** Connection handle, a netconn pointer on the stack core */
+typedef struct nproxy_conn *nproxy_conn_t;
+
+/**
+ * @brief Received data, a view of the pbuf chain on the stack core
+ */
+struct nproxy_buf {
+	void *handle;				/*!< pbuf chain, owned until nproxy_recv_done() */
+	uint32_t addr;				/*!< Sender IPv4 address in network order (UDP) */
+	uint16_t port;				/*!< Sender port (UDP) */
+	uint16_t nsegs;				/*!< Number of valid segments */
+	uint32_t tot_len;			/*!< Total length of all segments */
+	struct {
+		const void *data;		/*!< Segment payload */
+		uint32_t len;			/*!< Segment length */
+	} seg[NPROXY_MAX_SEGS];
+};
+
+/**
+ * @brief Request block shared by the two cores
+ *
+ * Filled by the application core, passed to the stack core by address and
+ * returned through the IPC queue when complete.
+ */
+struct nproxy_req {
+	uint8_t op;					/*!< NPROXY_OP_* request code */
+	int8_t err;					/*!< Result, NPROXY_OK or a negative error */
+	uint16_t port;				/*!< Port for bind, connect and send */
+	nproxy_conn_t conn;			/*!< Connection the request applies to */
+	nproxy_conn_t newconn;		/*!< New connection from new and accept */
+	uint32_t addr;				/*!< IPv4 address in network order */
+	const void *data;			/*!< Data to send */
+	uint32_t len;				/*!< Length of data to send */
+	struct nproxy_buf *buf;		/*!< Receive buffer to fill */
+};
+
+/**
+ * @brief Application core proxy statistics
+ */
+struct nproxy_stats {
+	uint32_t calls;				/*!< Requests issued */
+	uint32_t sends;				/*!< Send requests issued */
+	uint32_t send_cycles;		/*!< Total cycles spent in nproxy_send() */
+	uint32_t send_max;			/*!< Longest nproxy_send(), in cycles */
+	uint32_t slot_waits;		/*!< Requests that waited for a free slot */
+};
+
+/**
+ * @brief	Initialize the application side of the proxy
+ * @return	Nothing
+ * @note	Must be called after IPCEX_Init() and before the scheduler starts.
+ */
+void nproxy_init(void);
+
+/**
+ * @brief	Initialize the stack side of the proxy
+ * @return	Nothing
+ * @note	Called from the lwIP setup task once the network interface is
+ * up. Starts the worker tasks and accepts requests from the other core.
+ */
+void nproxy_server_init(void);
+
+/**
+ * @brief	Check whether the stack side of the proxy is running
+ * @return	Non zero once nproxy_server_init() has completed
+ */
+int nproxy_server_ready(void);
+
+/**
+ * @brief	Execute a request on the stack core
+ * @param	req	: Request to execute
+ * @return	Nothing, the result is stored in req->err
+ * @note	Blocks for accept, connect and receive requests.
+ */
+void nproxy_server_exec(struct nproxy_req *req);
+
+/**
+ * @brief	Release received data on the stack core
+ * @param	handle	: pbuf chain from nproxy_buf.handle
+ * @return	Nothing
+ */
+void nproxy_server_free(void *handle);
+
+/**
+ * @brief	Create a new connection
+ * @param	type	: NPROXY_TCP or NPROXY_UDP
+ * @return	Connection handle, or NULL on error
+ */
+nproxy_conn_t nproxy_new(int type);
+
+/**
+ * @brief	Bind a connection to a local port
+ * @param	conn	: Connection handle
+ * @param	addr	: Local IPv4 address in network order, 0 for any
+ * @param	port	: Local port
+ * @return	NPROXY_OK or a negative error
+ */
+int nproxy_bind(nproxy_conn_t conn, uint32_t addr, uint16_t port);
+
+/**
+ * @brief	Connect to a remote host
+ * @param	conn	: Connection handle
+ * @param	addr	: Remote IPv4 address in network order
+ * @param	port	: Remote port
+ * @return	NPROXY_OK or a negative error
+ */
+int nproxy_connect(nproxy_conn_t conn, uint32_t addr, uint16_t port);
+
+/**
+ * @brief	Put a bound TCP connection in listen mode
+ * @param	conn	: Connection handle
+ * @return	NPROXY_OK or a negative error
+ */
+int nproxy_listen(nproxy_conn_t conn);
+
+/**
+ * @brief	Wait for an incoming TCP connection
+ * @param	conn	: Listening connection handle
+ * @param	newconn	: Returns the new connection
+ * @return	NPROXY_OK or a negative error
+ */
+int nproxy_accept(nproxy_conn_t conn, nproxy_conn_t *newconn);
+
+/**
+ * @brief	Wait for received data
+ * @param	conn	: Connection handle
+ * @param	buf		: Buffer descriptor to fill
+ * @return	NPROXY_OK, NPROXY_ERR_CLSD when the peer closed, or an error
+ * @note	The segments point into memory of the stack core and must be
+ * returned with nproxy_recv_done() once consumed.
+ */
+int nproxy_recv(nproxy_conn_t conn, struct nproxy_buf *buf);
+
+/**
+ * @brief	Return received data to the stack core
+ * @param	buf	: Buffer descriptor filled by nproxy_recv()
+ * @return	Nothing
+ */
+void nproxy_recv_done(struct nproxy_buf *buf);
+
+/**
+ * @brief	Send data
+ * @param	conn	: Connection handle
+ * @param	data	: Data to send
+ * @param	len		: Number of bytes to send
+ * @return	NPROXY_OK or a negative error
+ * @note	The data is copied by the stack core before this returns.
+ */
+int nproxy_send(nproxy_conn_t conn, const void *data, uint32_t len);
+
+/**
+ * @brief	Send a UDP datagram to a given host
+ * @param	conn	: UDP connection handle
+ * @param	data	: Data to send
+ * @param	len		: Number of bytes to send
+ * @param	addr	: Remote IPv4 address in network order
+ * @param	port	: Remote port
+ * @return	NPROXY_OK or a negative error
+ */
+int nproxy_sendto(nproxy_conn_t conn, const void *data, uint32_t len,
+				  uint32_t addr, uint16_t port);
+
+/**
+ * @brief	Close and delete a connection
+ * @param	conn	: Connection handle
+ * @return	NPROXY_OK or a negative error
+ */
+int nproxy_close(nproxy_conn_t conn);
+
+/**
+ * @brief	Read the proxy statistics of this core
+ * @param	stats	: Pointer to structure to fill
+ * @return	Nothing
+ */
+void nproxy_get_stats(struct nproxy_stats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_PROXY_H_ */
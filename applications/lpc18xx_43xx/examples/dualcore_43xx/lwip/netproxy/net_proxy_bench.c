@@ -0,0 +1,217 @@
+/*
+ * @brief Dual core network proxy benchmark
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "app_dualcore_cfg.h"
+#include "net_proxy.h"
+
+#ifdef EXAMPLE_NETPROXY
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** @ingroup EXAMPLE_DUALCORE_NETPROXY
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* TCP ports of the echo and discard services */
+#define NPROXY_ECHO_PORT        7
+#define NPROXY_DISCARD_PORT     9
+
+/* Statistics report period in milliseconds */
+#ifndef NPROXY_REPORT_MS
+#define NPROXY_REPORT_MS        5000
+#endif
+
+/* Task stack sizes */
+#define NPROXY_BENCH_STACK      256
+
+/* Bytes echoed and discarded, and echo requests served */
+static volatile uint32_t echo_bytes, echo_reqs, discard_bytes;
+
+/* Loops of the background load task, a measure of the cycles left to the
+   application on this core */
+static volatile uint32_t load_loops;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Open a listening TCP connection */
+static nproxy_conn_t bench_listen(uint16_t port)
+{
+	nproxy_conn_t conn;
+
+	conn = nproxy_new(NPROXY_TCP);
+	if ((conn == NULL) || (nproxy_bind(conn, 0, port) != NPROXY_OK) ||
+		(nproxy_listen(conn) != NPROXY_OK)) {
+		DEBUGOUT("NProxy: unable to listen on port %d\r\n", port);
+		while (1) {
+			vTaskDelay(portMAX_DELAY);
+		}
+	}
+
+	return conn;
+}
+
+/* TCP echo service, replies with the received data */
+static void vEchoTask(void *pvParameters)
+{
+	nproxy_conn_t listen, conn;
+	struct nproxy_buf buf;
+	int i, err;
+
+	listen = bench_listen(NPROXY_ECHO_PORT);
+	while (1) {
+		if (nproxy_accept(listen, &conn) != NPROXY_OK) {
+			continue;
+		}
+
+		while (nproxy_recv(conn, &buf) == NPROXY_OK) {
+			/* Send straight from the stack core's receive buffers */
+			for (i = 0, err = NPROXY_OK; (i < buf.nsegs) && (err == NPROXY_OK); i++) {
+				err = nproxy_send(conn, buf.seg[i].data, buf.seg[i].len);
+			}
+			echo_bytes += buf.tot_len;
+			echo_reqs++;
+			nproxy_recv_done(&buf);
+			if (err != NPROXY_OK) {
+				break;
+			}
+		}
+
+		nproxy_close(conn);
+	}
+}
+
+/* TCP discard service, measures receive throughput */
+static void vDiscardTask(void *pvParameters)
+{
+	nproxy_conn_t listen, conn;
+	struct nproxy_buf buf;
+
+	listen = bench_listen(NPROXY_DISCARD_PORT);
+	while (1) {
+		if (nproxy_accept(listen, &conn) != NPROXY_OK) {
+			continue;
+		}
+
+		while (nproxy_recv(conn, &buf) == NPROXY_OK) {
+			discard_bytes += buf.tot_len;
+			nproxy_recv_done(&buf);
+		}
+
+		nproxy_close(conn);
+	}
+}
+
+/* Background load, stands in for the signal processing code */
+static void vLoadTask(void *pvParameters)
+{
+	while (1) {
+		load_loops++;
+	}
+}
+
+/* Periodic report of the benchmark counters */
+static void vReportTask(void *pvParameters)
+{
+	uint32_t loops, prev_loops = 0, max_loops = 0;
+	uint32_t echo, prev_echo = 0, reqs, prev_reqs = 0;
+	uint32_t disc, prev_disc = 0;
+	struct nproxy_stats st;
+	uint32_t cyc_per_us = SystemCoreClock / 1000000;
+
+	while (1) {
+		vTaskDelay((configTICK_RATE_HZ * NPROXY_REPORT_MS) / 1000);
+
+		loops = load_loops - prev_loops;
+		prev_loops += loops;
+		echo = echo_bytes - prev_echo;
+		prev_echo += echo;
+		reqs = echo_reqs - prev_reqs;
+		prev_reqs += reqs;
+		disc = discard_bytes - prev_disc;
+		prev_disc += disc;
+
+		/* The quietest period is the reference for the spare cycles */
+		if (loops > max_loops) {
+			max_loops = loops;
+		}
+
+		nproxy_get_stats(&st);
+		DEBUGOUT("NProxy: discard %u KB/s, echo %u KB/s %u req/s, spare %u%%\r\n",
+				 (disc / NPROXY_REPORT_MS) * 1000 / 1024,
+				 (echo / NPROXY_REPORT_MS) * 1000 / 1024,
+				 reqs * 1000 / NPROXY_REPORT_MS,
+				 max_loops ? (uint32_t) (((uint64_t) loops * 100) / max_loops) : 0);
+		DEBUGOUT("NProxy: send avg %u us max %u us, %u calls, %u slot waits\r\n",
+				 st.sends ? (st.send_cycles / st.sends) / cyc_per_us : 0,
+				 st.send_max / cyc_per_us, st.calls, st.slot_waits);
+	}
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Network proxy example initialisation function */
+void NETPROXY_Init(void)
+{
+	nproxy_init();
+}
+
+/* Network proxy benchmark task */
+void netproxy_tasks(void)
+{
+	xTaskCreate(vEchoTask, "NPEcho", NPROXY_BENCH_STACK, NULL,
+				TASK_PRIO_NETPROXY, (TaskHandle_t *) NULL);
+	xTaskCreate(vDiscardTask, "NPDisc", NPROXY_BENCH_STACK, NULL,
+				TASK_PRIO_NETPROXY, (TaskHandle_t *) NULL);
+	xTaskCreate(vReportTask, "NPRep", NPROXY_BENCH_STACK, NULL,
+				TASK_PRIO_NETPROXY + 1, (TaskHandle_t *) NULL);
+	xTaskCreate(vLoadTask, "NPLoad", configMINIMAL_STACK_SIZE, NULL,
+				tskIDLE_PRIORITY, (TaskHandle_t *) NULL);
+}
+
+/**
+ * @}
+ */
+
+#endif /* EXAMPLE_NETPROXY */
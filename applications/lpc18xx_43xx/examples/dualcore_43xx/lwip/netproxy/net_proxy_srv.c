@@ -0,0 +1,387 @@
+/*
+ * @brief Dual core network proxy, stack core side
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "app_dualcore_cfg.h"
+#include "ipc_msg.h"
+#include "ipc_example.h"
+
+#include "lwip/opt.h"
+#include "lwip/api.h"
+#include "lwip/pbuf.h"
+
+#include "net_proxy.h"
+
+#if defined(EXAMPLE_LWIP) && (defined(EXAMPLE_NETPROXY) || defined(EXAMPLE_NETPROXY_SERVER))
+
+#ifndef OS_FREE_RTOS
+#error "The network proxy requires FreeRTOS"
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/** @ingroup EXAMPLE_DUALCORE_NETPROXY
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Set once the proxy accepts requests */
+static volatile int nproxy_started;
+
+/* TCP data left over when a received chain has more pbufs than the segment
+   table, returned by the next receive request on the connection */
+static struct {
+	struct netconn *conn;
+	struct pbuf *p;
+} nproxy_pending[MEMP_NUM_NETCONN];
+
+#if NPROXY_LOCAL == 0
+/* Worker task stack size */
+#define NPROXY_WORKER_STACK     256
+
+/* Requests waiting for a worker */
+static QueueHandle_t nproxy_workq;
+#endif
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Save the rest of a TCP chain for the next receive request */
+static void nproxy_put_pending(struct netconn *conn, struct pbuf *p)
+{
+	int i;
+
+	taskENTER_CRITICAL();
+	for (i = 0; nproxy_pending[i].conn != NULL; i++) {}
+	nproxy_pending[i].conn = conn;
+	nproxy_pending[i].p = p;
+	taskEXIT_CRITICAL();
+}
+
+/* Take the saved data of a connection, NULL if there is none */
+static struct pbuf *nproxy_get_pending(struct netconn *conn)
+{
+	struct pbuf *p = NULL;
+	int i;
+
+	taskENTER_CRITICAL();
+	for (i = 0; i < MEMP_NUM_NETCONN; i++) {
+		if (nproxy_pending[i].conn == conn) {
+			p = nproxy_pending[i].p;
+			nproxy_pending[i].conn = NULL;
+			nproxy_pending[i].p = NULL;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return p;
+}
+
+/* Cut a pbuf chain after NPROXY_MAX_SEGS pbufs, returns the rest */
+static struct pbuf *nproxy_split(struct pbuf *p)
+{
+	struct pbuf *q, *rest;
+	int i;
+
+	for (q = p, i = 1; i < NPROXY_MAX_SEGS; q = q->next, i++) {}
+	rest = q->next;
+	q->next = NULL;
+
+	/* The reference q held on rest now belongs to the caller */
+	for (q = p; q != NULL; q = q->next) {
+		q->tot_len -= rest->tot_len;
+	}
+
+	return rest;
+}
+
+/* Describe a received pbuf chain for the application core */
+static err_t nproxy_fill_buf(struct netconn *conn, struct nproxy_buf *buf, struct pbuf *p)
+{
+	struct pbuf *q;
+	int i;
+
+	if (pbuf_clen(p) > NPROXY_MAX_SEGS) {
+		if (netconn_type(conn) == NETCONN_TCP) {
+			/* Hand over the head of the stream now, the rest with the
+			   next request */
+			nproxy_put_pending(conn, nproxy_split(p));
+		}
+		else {
+			/* A datagram must arrive whole, flatten it. Without memory for
+			   that it is dropped, as on a full receive queue. */
+			p = pbuf_coalesce(p, PBUF_RAW);
+			if (pbuf_clen(p) > NPROXY_MAX_SEGS) {
+				pbuf_free(p);
+				return ERR_MEM;
+			}
+		}
+	}
+
+	buf->handle = p;
+	buf->tot_len = p->tot_len;
+	for (q = p, i = 0; q != NULL; q = q->next, i++) {
+		buf->seg[i].data = q->payload;
+		buf->seg[i].len = q->len;
+	}
+	buf->nsegs = i;
+
+	return ERR_OK;
+}
+
+/* Receive request */
+static err_t nproxy_do_recv(struct netconn *conn, struct nproxy_buf *buf)
+{
+	struct netbuf *nb;
+	struct pbuf *p;
+	err_t err;
+
+	if (netconn_type(conn) == NETCONN_TCP) {
+		p = nproxy_get_pending(conn);
+		if (p == NULL) {
+			err = netconn_recv_tcp_pbuf(conn, &p);
+			if (err != ERR_OK) {
+				return err;
+			}
+		}
+		buf->addr = 0;
+		buf->port = 0;
+	}
+	else {
+		err = netconn_recv(conn, &nb);
+		if (err != ERR_OK) {
+			return err;
+		}
+
+		/* Keep the pbuf, drop the netbuf wrapper */
+		p = nb->p;
+		buf->addr = netbuf_fromaddr(nb)->addr;
+		buf->port = netbuf_fromport(nb);
+		nb->p = nb->ptr = NULL;
+		netbuf_delete(nb);
+	}
+
+	return nproxy_fill_buf(conn, buf, p);
+}
+
+/* Send request, the data is copied into lwIP buffers */
+static err_t nproxy_do_send(struct nproxy_req *req)
+{
+	struct netconn *conn = (struct netconn *) req->conn;
+	struct netbuf *nb;
+	ip_addr_t addr;
+	void *data;
+	err_t err;
+
+	if (netconn_type(conn) == NETCONN_TCP) {
+		return netconn_write(conn, req->data, req->len, NETCONN_COPY);
+	}
+
+	nb = netbuf_new();
+	if (nb == NULL) {
+		return ERR_MEM;
+	}
+	data = netbuf_alloc(nb, (u16_t) req->len);
+	if (data == NULL) {
+		netbuf_delete(nb);
+		return ERR_MEM;
+	}
+	MEMCPY(data, req->data, req->len);
+
+	if (req->addr) {
+		addr.addr = req->addr;
+		err = netconn_sendto(conn, nb, &addr, req->port);
+	}
+	else {
+		err = netconn_send(conn, nb);
+	}
+	netbuf_delete(nb);
+
+	return err;
+}
+
+#if NPROXY_LOCAL == 0
+/* Worker task, executes requests that may block */
+static void nproxy_worker(void *arg)
+{
+	struct nproxy_req *req;
+
+	while (1) {
+		xQueueReceive(nproxy_workq, &req, portMAX_DELAY);
+		nproxy_server_exec(req);
+		ipcex_msgPush(IPCEX_ID_NETPROXY, (uint32_t) req);
+	}
+}
+
+/* IPC callback, new request from the application core */
+static void nproxy_request(uint32_t data)
+{
+	struct nproxy_req *req = (struct nproxy_req *) data;
+
+	/* There is one worker per request the other core can have
+	   outstanding, so this never waits */
+	xQueueSend(nproxy_workq, &req, portMAX_DELAY);
+}
+
+/* IPC callback, the application core is done with received data */
+static void nproxy_free(uint32_t data)
+{
+	nproxy_server_free((void *) data);
+}
+
+#endif /* NPROXY_LOCAL == 0 */
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Execute a request on the stack core */
+void nproxy_server_exec(struct nproxy_req *req)
+{
+	struct netconn *conn = (struct netconn *) req->conn;
+	struct netconn *newconn;
+	struct pbuf *p;
+	ip_addr_t addr;
+	err_t err = ERR_OK;
+
+	switch (req->op) {
+	case NPROXY_OP_NEW:
+		newconn = netconn_new(req->port == NPROXY_UDP ? NETCONN_UDP : NETCONN_TCP);
+		if (newconn == NULL) {
+			err = ERR_MEM;
+		}
+		req->newconn = (nproxy_conn_t) newconn;
+		break;
+
+	case NPROXY_OP_BIND:
+		addr.addr = req->addr;
+		err = netconn_bind(conn, &addr, req->port);
+		break;
+
+	case NPROXY_OP_CONNECT:
+		addr.addr = req->addr;
+		err = netconn_connect(conn, &addr, req->port);
+		break;
+
+	case NPROXY_OP_LISTEN:
+		err = netconn_listen(conn);
+		break;
+
+	case NPROXY_OP_ACCEPT:
+		newconn = NULL;
+		err = netconn_accept(conn, &newconn);
+		req->newconn = (nproxy_conn_t) newconn;
+		break;
+
+	case NPROXY_OP_RECV:
+		err = nproxy_do_recv(conn, req->buf);
+		break;
+
+	case NPROXY_OP_SEND:
+		err = nproxy_do_send(req);
+		break;
+
+	case NPROXY_OP_CLOSE:
+		if (netconn_type(conn) == NETCONN_TCP) {
+			/* Drop data the application core did not read */
+			p = nproxy_get_pending(conn);
+			if (p != NULL) {
+				pbuf_free(p);
+			}
+			netconn_close(conn);
+		}
+		err = netconn_delete(conn);
+		break;
+
+	default:
+		err = ERR_ARG;
+		break;
+	}
+
+	req->err = (int8_t) err;
+}
+
+/* Check whether the stack side of the proxy is running */
+int nproxy_server_ready(void)
+{
+	return nproxy_started;
+}
+
+/* Release received data on the stack core */
+void nproxy_server_free(void *handle)
+{
+	pbuf_free((struct pbuf *) handle);
+}
+
+/* Initialize the stack side of the proxy */
+void nproxy_server_init(void)
+{
+#if NPROXY_LOCAL == 0
+	int i;
+
+	/* Requests come from the other core */
+	nproxy_workq = xQueueCreate(NPROXY_MAX_REQ, sizeof(struct nproxy_req *));
+	if (nproxy_workq == NULL) {
+		DEBUGSTR("ERROR: Unable to create network proxy queue\r\n");
+		while (1) {}
+	}
+
+	for (i = 0; i < NPROXY_MAX_REQ; i++) {
+		xTaskCreate(nproxy_worker, "NProxy", NPROXY_WORKER_STACK, NULL,
+					TASK_PRIO_NETPROXY, (TaskHandle_t *) NULL);
+	}
+
+	ipcex_register_callback(IPCEX_ID_NETPROXY_FREE, nproxy_free);
+	ipcex_register_callback(IPCEX_ID_NETPROXY, nproxy_request);
+
+	/* Requests sent before the callbacks were registered are lost, a
+	   NULL request tells the other core it can start */
+	ipcex_msgPush(IPCEX_ID_NETPROXY, 0);
+#endif
+	nproxy_started = 1;
+}
+
+/**
+ * @}
+ */
+
+#endif /* defined(EXAMPLE_LWIP) && (defined(EXAMPLE_NETPROXY) || defined(EXAMPLE_NETPROXY_SERVER)) */
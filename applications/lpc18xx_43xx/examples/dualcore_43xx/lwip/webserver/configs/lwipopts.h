@@ -64,8 +64,24 @@
 #define IP_SOF_BROADCAST                1
 #define IP_SOF_BROADCAST_RECV           1
 
+/* Checksum profile. With LPC_CHECKSUM_OFFLOAD set to 1, the EMAC inserts
+   and verifies the IP, UDP, TCP, and ICMP checksums and lwIP skips them.
+   Set it to 0 to compute all checksums in software. Note that UDP datagrams
+   fragmented by lwIP are sent without a UDP checksum when offloaded. */
+#define LPC_CHECKSUM_OFFLOAD            1
+
+#if LPC_CHECKSUM_OFFLOAD
+#define CHECKSUM_GEN_IP                 0
+#define CHECKSUM_GEN_UDP                0
+#define CHECKSUM_GEN_TCP                0
+#define CHECKSUM_GEN_ICMP               0
+#define CHECKSUM_CHECK_IP               0
+#define CHECKSUM_CHECK_UDP              0
+#define CHECKSUM_CHECK_TCP              0
+#define LWIP_CHECKSUM_ON_COPY           0
+#else
 /* The ethernet FCS is performed in hardware. The IP, TCP, and UDP
-   CRCs still need to be done in hardware. */
+   CRCs still need to be done in software. */
 #define CHECKSUM_GEN_IP                 1
 #define CHECKSUM_GEN_UDP                1
 #define CHECKSUM_GEN_TCP                1
@@ -73,6 +89,7 @@
 #define CHECKSUM_CHECK_UDP              1
 #define CHECKSUM_CHECK_TCP              1
 #define LWIP_CHECKSUM_ON_COPY           1
+#endif
 
 /* Use LWIP version of htonx() to allow generic functionality across
    all platforms. If you are using the Cortex Mx devices, you might
@@ -100,6 +117,9 @@
 
 #define LWIP_SOCKET                     0
 #define LWIP_NETCONN                    (NO_SYS == 0)
+
+/* Receive timeouts let the netconn HTTP workers drop idle clients */
+#define LWIP_SO_RCVTIMEO                (NO_SYS == 0)
 #define MEMP_NUM_SYS_TIMEOUT            300
 
 #define LWIP_STATS                      0
@@ -136,6 +156,14 @@
 #define MEM_LIBC_MALLOC                 1
 #define MEMP_MEM_MALLOC                 1
 
+/* The C library heap is not thread-safe, under FreeRTOS all tasks use its
+   heap (heap_3 runs malloc() with the scheduler suspended) */
+#ifdef OS_FREE_RTOS
+#include "FreeRTOS.h"
+#define mem_malloc                      pvPortMalloc
+#define mem_free                        vPortFree
+#endif
+
 /* Required for malloc/free */
 #include <stdlib.h>
 
@@ -61,6 +61,10 @@
 #include "arch/lpc_arch.h"
 #include "lpc_phy.h"/* For the PHY monitor support */
 
+#if (defined(EXAMPLE_NETPROXY) || defined(EXAMPLE_NETPROXY_SERVER))
+#include "net_proxy.h"
+#endif
+
 #if (defined(OS_FREE_RTOS) || defined(OS_UCOS_III))
 extern void http_server_netconn_init(void);
 #else
@@ -167,6 +171,11 @@ static void vSetupIFTask(void *pvParameters)
 	/* Initialize and start application */
 	http_server_netconn_init();
 
+#if (defined(EXAMPLE_NETPROXY) || defined(EXAMPLE_NETPROXY_SERVER))
+	/* Serve network requests of the application core */
+	nproxy_server_init();
+#endif
+
 	/* This loop monitors the PHY link and will handle cable events
 	   via the PHY driver. */
 	while (1) {
@@ -39,6 +39,8 @@
 #include "lwip_fs.h"
 #include "app_dualcore_cfg.h"
 #include "ipc_example.h"
+#include "lwip/sys.h"
+#include "lwip/mem.h"
 
 #include "httpd_structs.h"
 
@@ -60,6 +62,19 @@ const static char http_index_html[] =
 
 static FATFS *Fatfs;	/* File system object */
 
+#if !NO_SYS
+/* The netconn worker threads serialize with this mutex the calls into
+   FatFs, which is built without _FS_REENTRANT, and the allocation of
+   file descriptors. These come from mem_malloc(), lwipopts.h maps it to
+   the FreeRTOS heap as the C library heap is not thread-safe. */
+static sys_mutex_t fs_lock;
+#define FS_LOCK()   sys_mutex_lock(&fs_lock)
+#define FS_UNLOCK() sys_mutex_unlock(&fs_lock)
+#else
+#define FS_LOCK()
+#define FS_UNLOCK()
+#endif
+
 /* Internal File descriptor structure */
 struct file_ds {
 	uint8_t scratch[SECTOR_SZ];
@@ -153,6 +168,16 @@ end_fn:
  * Public functions
  ****************************************************************************/
 
+/* Initialize the file system module */
+void fs_init(void)
+{
+#if !NO_SYS
+	if (sys_mutex_new(&fs_lock) != ERR_OK) {
+		DEBUGSTR("DFS: Unable to create file system lock!\r\n");
+	}
+#endif
+}
+
 /* Read http header information into a string */
 int GetHTTP_Header(const char *fName, char *buff)
 {
@@ -165,7 +190,9 @@ struct fs_file *fs_open_default(void) {
 	struct file_ds *fds;
 	struct fs_file *fs;
 
-	fds = malloc(sizeof(*fds));
+	FS_LOCK();
+	fds = mem_malloc(sizeof(*fds));
+	FS_UNLOCK();
 	if (fds == NULL) {
 		DEBUGSTR("Malloc Failure, Out of Memory!\r\n");
 		return NULL;
@@ -192,24 +219,33 @@ struct fs_file *fs_open(const char *name) {
 	if (!ipcex_getGblVal(SHGBL_USBDISKADDR))
 		return NULL;
 
-	if (!Fatfs) {
-		/* One time allocation not to be freed! */
-		Fatfs = malloc(sizeof(*Fatfs));
-		if (Fatfs == NULL) return NULL;
-		f_mount(0, Fatfs); /* Never fails */
-	}
-
 	/* Allocate file descriptor */
-	fds = malloc(sizeof(*fds));
+	FS_LOCK();
+	fds = mem_malloc(sizeof(*fds));
 	if (fds == NULL) {
+		FS_UNLOCK();
 		DEBUGSTR("Malloc Failure, Out of Memory!\r\n");
 		return NULL;
 	}
 
+	if (!Fatfs) {
+		/* One time allocation not to be freed! */
+		Fatfs = mem_malloc(sizeof(*Fatfs));
+		if (Fatfs == NULL) {
+			mem_free(fds);
+			FS_UNLOCK();
+			return NULL;
+		}
+		f_mount(0, Fatfs); /* Never fails */
+	}
+
 	res = f_open(&fds->fi, name, FA_READ);
+	if (res) {
+		mem_free(fds);
+	}
+	FS_UNLOCK();
 	if (res) {
 		LWIP_DEBUGF(HTTPD_DEBUG, ("DFS: OPEN: File %s does not exist\r\n", name));
-		free(fds);
 		return NULL;
 	}
 
@@ -233,9 +269,12 @@ void fs_close(struct fs_file *file)
 		return;
 
 	fds = (struct file_ds *) file->pextension;
-	if (fds->fi_valid)
+	FS_LOCK();
+	if (fds->fi_valid) {
 		f_close(&fds->fi);
- 	free(fds);
+	}
+	mem_free(fds);
+	FS_UNLOCK();
 }
 
 /* File read function */
@@ -243,7 +282,12 @@ int fs_read(struct fs_file *file, char *buffer, int count)
 {
 	uint32_t i = 0;
 	struct file_ds *fds = (struct file_ds *) file->pextension;
-	if (f_read(&fds->fi, (uint8_t *) buffer, count, &i))
+	FRESULT res;
+
+	FS_LOCK();
+	res = f_read(&fds->fi, (uint8_t *) buffer, count, &i);
+	FS_UNLOCK();
+	if (res)
 		return 0; /* Error in reading file */
 	file->index += i;
 	return i;
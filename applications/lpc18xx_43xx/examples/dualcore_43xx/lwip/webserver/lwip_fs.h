@@ -92,6 +92,15 @@ struct fs_file {
 #endif /* LWIP_HTTPD_FILE_STATE */
 };
 
+/**
+ * @brief	Initialize the file system module
+ * @return None
+ * Creates the lock that serializes FatFs access in OS configurations.
+ * Must be called once before the first fs_open() when files are served
+ * from more than one thread.
+ */
+void fs_init(void);
+
 /**
  * @brief	Get HTTP header function
  * @param fName	:   Filename for which the header be generated
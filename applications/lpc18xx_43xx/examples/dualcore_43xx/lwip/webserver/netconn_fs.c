@@ -34,7 +34,9 @@
 #include "lwip/opt.h"
 #include "lwip/arch.h"
 #include "lwip/api.h"
+#include "lwip/sys.h"
 #include "lwip_fs.h"
+#include "netconn_fs.h"
 
 #include "app_dualcore_cfg.h"
 #include "ipc_example.h"
@@ -51,9 +53,17 @@
 const static char http_html_hdr[] = "HTTP/1.1 200 OK\r\nContent-type: text/html\r\n\r\n";
 const static char http_index_html[] = "<html><head><title>Congrats!</title></head><body><h1>Welcome to our lwIP HTTP server!</h1><p>This is a small test page, served by httpserver-netconn.</body></html>";
 
-/* Dynamic header generation based on Filename */
-extern int GetHTTP_Header(const char *fName, char *buff);
-void http_server_netconn_init(void);
+/* Per-worker state; each worker owns its read buffer */
+struct http_worker {
+	uint8_t file_buffer[HTTPD_NETCONN_BUF_SIZE];
+};
+
+static struct http_worker http_workers[HTTPD_NETCONN_WORKERS];
+
+/* Accepted connections waiting for a worker */
+static sys_mbox_t http_conn_queue;
+
+static struct http_netconn_stats http_stats;
 
 #ifndef CRLF
 #define CRLF "\r\n"
@@ -77,19 +87,47 @@ static uint32_t get_version(const char *vstr)
 	return (major << 16) | minor;
 }
 
-/** Serve one HTTP connection accepted in the http thread */
+#ifdef HTTPD_NETCONN_STATS_URI
+/* Format the worker pool statistics as a plain text response */
+static int http_stats_page(char *buff, int size)
+{
+	struct http_netconn_stats st;
+
+	http_server_netconn_get_stats(&st);
+	return snprintf(buff, size,
+					"HTTP/1.0 200 OK" CRLF
+					"Content-type: text/plain" CRLF CRLF
+					"workers %d" CRLF "queue_len %d" CRLF
+					"accepted %lu" CRLF "rejected %lu" CRLF "served %lu" CRLF
+					"queued %lu" CRLF "queued_max %lu" CRLF "busy %lu" CRLF
+					"service_ms_avg %lu" CRLF "service_ms_max %lu" CRLF,
+					HTTPD_NETCONN_WORKERS, HTTPD_NETCONN_QUEUE_LEN,
+					(unsigned long) st.accepted, (unsigned long) st.rejected,
+					(unsigned long) st.served, (unsigned long) st.queued,
+					(unsigned long) st.queued_max, (unsigned long) st.busy,
+					(unsigned long) (st.served ? st.service_ms_total / st.served : 0),
+					(unsigned long) st.service_ms_max);
+}
+#endif
+
+/** Serve one HTTP connection handed to a worker, using the worker's
+ * buffer for file data */
 static void
-http_server_netconn_serve(struct netconn *conn)
+http_server_netconn_serve(struct netconn *conn, uint8_t *file_buffer)
 {
   struct netbuf *inbuf;
   char *buf, *tbuf;
   u16_t buflen;
 	struct fs_file *fs = NULL;
   err_t err;
-	static uint8_t file_buffer[1024];
 	int len;
 	uint32_t req_ver;
 
+#if LWIP_SO_RCVTIMEO && HTTPD_NETCONN_RECV_TIMEOUT
+	/* Do not let a client that never sends a request keep the worker */
+	netconn_set_recvtimeout(conn, HTTPD_NETCONN_RECV_TIMEOUT);
+#endif
+
   /* Read the data from the port, blocking if nothing yet there.
    We assume the request (the part we care about) is in one netbuf */
   err = netconn_recv(conn, &inbuf);
@@ -131,6 +169,15 @@ http_server_netconn_serve(struct netconn *conn)
 		LWIP_DEBUGF(HTTPD_DEBUG, ("HTTPD: Arguements %s in URI ignored\r\n", tbuf));
 		*tbuf++ = 0;
 	}
+#ifdef HTTPD_NETCONN_STATS_URI
+	if (strcmp(buf, HTTPD_NETCONN_STATS_URI) == 0) {
+		len = http_stats_page((char *) file_buffer, HTTPD_NETCONN_BUF_SIZE);
+		if (len > HTTPD_NETCONN_BUF_SIZE - 1)
+			len = HTTPD_NETCONN_BUF_SIZE - 1;
+		netconn_write(conn, file_buffer, len, NETCONN_COPY);
+		goto close_and_exit;
+	}
+#endif
 	if (strlen(buf) == 1 && *buf == '/') {
 		fs = fs_open("/index.htm");
 		if (fs == NULL)
@@ -148,21 +195,21 @@ http_server_netconn_serve(struct netconn *conn)
 		int len;
 		LWIP_DEBUGF(HTTPD_DEBUG, ("HTTPD: Unable to open file[%s]\r\n", buf));
 		len = GetHTTP_Header(NULL, (char *)file_buffer);
-		netconn_write(conn, file_buffer, len, NETCONN_NOCOPY);
+		netconn_write(conn, file_buffer, len, NETCONN_COPY);
 		goto close_and_exit;
 	}
 
-	/***
-	 * FIXME: There is a possible race condition while accessing
-	 *        file_buffer, must use a mutex to protect it.
-	 **/
+	/* The header lives in the file descriptor and the worker buffer is
+	   refilled on every read, so both are copied into the send queue:
+	   netconn_write returns before the data is acknowledged. */
 	if (fs->http_header_included)
 		/* Send the header */
-		netconn_write(conn, fs->data, fs->index, NETCONN_NOCOPY);
+		netconn_write(conn, fs->data, fs->index, NETCONN_COPY);
 
 	 /* Read the file now */
-	 while ((len = fs_read(fs, (char *)file_buffer, sizeof(file_buffer))) > 0) {
-		netconn_write(conn, file_buffer, len, NETCONN_NOCOPY);
+	 while ((len = fs_read(fs, (char *)file_buffer, HTTPD_NETCONN_BUF_SIZE)) > 0) {
+		if (netconn_write(conn, file_buffer, len, NETCONN_COPY) != ERR_OK)
+			break;
 	 }
 
 close_and_exit:
@@ -175,6 +222,62 @@ close_and_exit:
   netbuf_delete(inbuf);
 }
 
+/** Worker thread: serves connections taken from the queue, never returns */
+static void
+http_server_netconn_worker(void *arg)
+{
+	struct http_worker *worker = (struct http_worker *) arg;
+	struct netconn *conn;
+	u32_t start, elapsed;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	while (1) {
+		sys_arch_mbox_fetch(&http_conn_queue, (void **) &conn, 0);
+
+		SYS_ARCH_PROTECT(lev);
+		http_stats.queued--;
+		http_stats.busy++;
+		SYS_ARCH_UNPROTECT(lev);
+
+		start = sys_now();
+		http_server_netconn_serve(conn, worker->file_buffer);
+		netconn_delete(conn);
+		elapsed = sys_now() - start;
+
+		SYS_ARCH_PROTECT(lev);
+		http_stats.busy--;
+		http_stats.served++;
+		http_stats.service_ms_total += elapsed;
+		if (elapsed > http_stats.service_ms_max)
+			http_stats.service_ms_max = elapsed;
+		SYS_ARCH_UNPROTECT(lev);
+	}
+}
+
+/* Hand an accepted connection to the worker pool, drop it if the queue is full */
+static void
+http_server_netconn_dispatch(struct netconn *conn)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	http_stats.accepted++;
+	http_stats.queued++;
+	if (http_stats.queued > http_stats.queued_max)
+		http_stats.queued_max = http_stats.queued;
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (sys_mbox_trypost(&http_conn_queue, conn) != ERR_OK) {
+		LWIP_DEBUGF(HTTPD_DEBUG, ("HTTPD: Worker queue full, connection dropped\r\n"));
+		SYS_ARCH_PROTECT(lev);
+		http_stats.queued--;
+		http_stats.rejected++;
+		SYS_ARCH_UNPROTECT(lev);
+		netconn_close(conn);
+		netconn_delete(conn);
+	}
+}
+
 /** The main function, never returns! */
 static void
 http_server_netconn_thread(void *arg)
@@ -204,8 +307,7 @@ http_server_netconn_thread(void *arg)
 				ipcex_setGblVal(SHGBL_HOSTADDR, remote_ip.addr);
 			}
 
-      http_server_netconn_serve(newconn);
-      netconn_delete(newconn);
+      http_server_netconn_dispatch(newconn);
     }
   } while(err == ERR_OK);
   LWIP_DEBUGF(HTTPD_DEBUG,
@@ -215,17 +317,44 @@ http_server_netconn_thread(void *arg)
   netconn_delete(conn);
 }
 
+/*********************************************************************//**
+ * @brief	Get a snapshot of the server statistics
+ * @param	stats	: Pointer to the structure to fill
+ * @return	None
+ **********************************************************************/
+void
+http_server_netconn_get_stats(struct http_netconn_stats *stats)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	*stats = http_stats;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
 /*********************************************************************//**
  * @brief	Blinky Initialization function
  *
  * This function is called by the common dual-core init,
- * which will start the HTTP server and will serve requests received.
+ * which will start the HTTP workers and the HTTP server thread
+ * that accepts the requests and queues them for the workers.
  *
  * @return	None
  **********************************************************************/
 void
 http_server_netconn_init(void)
 {
+	int i;
+
+	fs_init();
+	if (sys_mbox_new(&http_conn_queue, HTTPD_NETCONN_QUEUE_LEN) != ERR_OK) {
+		LWIP_DEBUGF(HTTPD_DEBUG, ("HTTPD: Unable to create worker queue\r\n"));
+		return;
+	}
+	for (i = 0; i < HTTPD_NETCONN_WORKERS; i++) {
+		sys_thread_new("http_worker", http_server_netconn_worker, &http_workers[i],
+					   HTTPD_NETCONN_WORKER_STACKSIZE, HTTPD_NETCONN_WORKER_PRIO);
+	}
   sys_thread_new("http_server_netconn", http_server_netconn_thread, NULL, DEFAULT_THREAD_STACKSIZE + 128, DEFAULT_THREAD_PRIO);
 }
 
@@ -0,0 +1,114 @@
+/*
+ * @brief	Netconn HTTP server worker pool definitions
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+#ifndef __NETCONN_FS_H_
+#define __NETCONN_FS_H_
+
+#include "lwip/opt.h"
+
+/** @defgroup EXAMPLE_DUALCORE_NETCONN_FS Netconn HTTP server
+ * @ingroup EXAMPLE_DUALCORE_LWIP
+ * The netconn HTTP server accepts connections in one thread and hands them
+ * to a fixed pool of worker threads through a bounded queue, so a slow
+ * client only holds up its own worker.
+ * @{
+ */
+
+/** Number of worker threads serving HTTP connections */
+#ifndef HTTPD_NETCONN_WORKERS
+#define HTTPD_NETCONN_WORKERS         3
+#endif
+
+/** Accepted connections that may wait for a free worker; connections
+ * accepted while the queue is full are closed straight away */
+#ifndef HTTPD_NETCONN_QUEUE_LEN
+#define HTTPD_NETCONN_QUEUE_LEN       4
+#endif
+
+/** Size of the per-worker file read buffer */
+#ifndef HTTPD_NETCONN_BUF_SIZE
+#define HTTPD_NETCONN_BUF_SIZE        1024
+#endif
+
+/** Stack size of each worker thread */
+#ifndef HTTPD_NETCONN_WORKER_STACKSIZE
+#define HTTPD_NETCONN_WORKER_STACKSIZE  (DEFAULT_THREAD_STACKSIZE + 128)
+#endif
+
+/** Priority of the worker threads */
+#ifndef HTTPD_NETCONN_WORKER_PRIO
+#define HTTPD_NETCONN_WORKER_PRIO     DEFAULT_THREAD_PRIO
+#endif
+
+/** Time in milliseconds a worker waits for the request before dropping
+ * the connection (needs LWIP_SO_RCVTIMEO), 0 waits forever */
+#ifndef HTTPD_NETCONN_RECV_TIMEOUT
+#define HTTPD_NETCONN_RECV_TIMEOUT    5000
+#endif
+
+/** URI answered with the worker pool statistics as plain text,
+ * undefine to disable */
+#ifndef HTTPD_NETCONN_STATS_URI
+#define HTTPD_NETCONN_STATS_URI       "/netconn_stats.txt"
+#endif
+
+/**
+ * @brief Netconn HTTP server statistics
+ */
+struct http_netconn_stats {
+	u32_t accepted;         /*!< Connections accepted */
+	u32_t rejected;         /*!< Connections closed because the queue was full */
+	u32_t served;           /*!< Connections completed by a worker */
+	u32_t queued;           /*!< Connections currently waiting for a worker */
+	u32_t queued_max;       /*!< Highest queue depth seen */
+	u32_t busy;             /*!< Workers currently serving a connection */
+	u32_t service_ms_total; /*!< Sum of connection service times */
+	u32_t service_ms_max;   /*!< Longest connection service time */
+};
+
+/**
+ * @brief	Start the netconn HTTP server
+ * @return None
+ * Creates the connection queue, the worker threads and the listening thread.
+ */
+void http_server_netconn_init(void);
+
+/**
+ * @brief	Get a snapshot of the netconn HTTP server statistics
+ * @param stats	:	Pointer to the structure to fill
+ * @return None
+ */
+void http_server_netconn_get_stats(struct http_netconn_stats *stats);
+
+/**
+ * @}
+ */
+
+#endif /* __NETCONN_FS_H_ */
@@ -59,6 +59,16 @@ extern "C"
 /* Defines the number of descriptors used for TX */
 #define LPC_NUM_BUFF_TXDESCS 8
 
+/* Receive into a pool of driver owned pbufs instead of the lwIP heap */
+#define LPC_RX_PBUF_POOL 1
+
+/* Defines the number of frame buffers in the RX pool */
+#define LPC_NUM_RX_POOL_PBUFS 16
+
+/* Mask RX interrupts while the receive task drains up to this many frames
+   per pass, re-enabling them once the RX ring is empty */
+#define LPC_RX_POLL_BUDGET 8
+
 /* Disable slow speed memory buffering */
 #define LPC_CHECK_SLOWMEM 1
 
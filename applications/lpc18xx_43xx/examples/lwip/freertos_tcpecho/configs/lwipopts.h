@@ -133,6 +133,15 @@
 #define MEM_LIBC_MALLOC                 1
 #define MEMP_MEM_MALLOC                 1
 
+/* Lock-free TCPIP thread mailboxes and a BASEPRI based SYS_ARCH_PROTECT,
+   see arch/sys_arch.h */
+#define SYS_ARCH_FAST_MBOX              1
+#define SYS_ARCH_BASEPRI_PROTECT        1
+
+/* Set to 1 to time tcpip_callback() round trips at startup with the DWT
+   cycle counter (printed on the debug UART) */
+#define LWIP_PERF                       0
+
 /* Needed for malloc/free */
 #include <stdlib.h>
 
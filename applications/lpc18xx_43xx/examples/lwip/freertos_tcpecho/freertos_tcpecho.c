@@ -47,6 +47,7 @@
 #include "arch/lpc18xx_43xx_emac.h"
 #include "arch/lpc_arch.h"
 #include "arch/sys_arch.h"
+#include "arch/perf.h"
 #include "lpc_phy.h" /* For the PHY monitor support */
 #include "tcpecho.h"
 
@@ -62,6 +63,11 @@
 /* NETIF data */
 static struct netif lpc_netif;
 
+#if LWIP_PERF
+/* Number of tcpip_callback() round trips timed at startup */
+#define TCPIP_RTT_SAMPLES 1000
+#endif
+
 /*****************************************************************************
  * Public types/enumerations/variables
  ****************************************************************************/
@@ -88,6 +94,39 @@ static void tcpip_init_done_signal(void *arg)
 	*(s32_t *) arg = 1;
 }
 
+#if LWIP_PERF
+/* Callback run in the TCPIP thread, returns control to the caller */
+static void tcpip_rtt_signal(void *arg)
+{
+	sys_sem_signal((sys_sem_t *) arg);
+}
+
+/* Times tcpip_callback() round trips through the TCPIP thread mailbox.
+   Compare the result with SYS_ARCH_FAST_MBOX and SYS_ARCH_BASEPRI_PROTECT
+   on and off in lwipopts.h. */
+static void tcpip_rtt_bench(void)
+{
+	sys_sem_t sem;
+	int i;
+
+	if (sys_sem_new(&sem, 0) != ERR_OK) {
+		return;
+	}
+
+	lpc_perf_init();
+	for (i = 0; i < TCPIP_RTT_SAMPLES; i++) {
+		PERF_START;
+		tcpip_callback_with_block(tcpip_rtt_signal, (void *) &sem, 1);
+		sys_arch_sem_wait(&sem, 0);
+		PERF_STOP("tcpip_callback rtt");
+	}
+
+	sys_sem_free(&sem);
+	lpc_perf_dump();
+}
+
+#endif
+
 /* LWIP kickoff and PHY link monitor thread */
 static void vSetupIFTask(void *pvParameters) {
 	ip_addr_t ipaddr, netmask, gw;
@@ -103,6 +142,10 @@ static void vSetupIFTask(void *pvParameters) {
 		msDelay(1);
 	}
 
+#if LWIP_PERF
+	tcpip_rtt_bench();
+#endif
+
 	LWIP_DEBUGF(LWIP_DBG_ON, ("Starting LWIP TCP echo server...\n"));
 
 	/* Static IP assignment */
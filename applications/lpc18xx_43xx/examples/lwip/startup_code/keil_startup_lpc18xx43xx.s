@@ -43,7 +43,11 @@ __initial_sp
 ;   <o>  Heap Size (in Bytes) <0x0-0xFFFFFFFF:8>
 ; </h>
 
-Heap_Size       EQU     0x00006000
+; lwIP allocates its heap and pools here (MEM_LIBC_MALLOC and MEMP_MEM_MALLOC).
+; The webserver takes up to about 12KB per connection sending a file from the
+; SD card: the two read-ahead buffers plus TCP_SND_BUF of queued data.
+
+Heap_Size       EQU     0x00010000
 
                 AREA    HEAP, NOINIT, READWRITE, ALIGN=3
 __heap_base
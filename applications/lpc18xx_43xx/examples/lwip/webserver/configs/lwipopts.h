@@ -44,6 +44,29 @@
 
 #define LWIP_HTTPD_DYNAMIC_HEADERS      1
 
+/* Serve the files of fsdata_rom.c from flash, sent without copying.
+   Set LWIP_HTTPD_ZEROCOPY to 0 to measure the copying send path. */
+#define LWIP_FS_ROM_IMAGE               1
+#define LWIP_HTTPD_ZEROCOPY             1
+#define LWIP_HTTPD_STATS                1
+
+/* Keep SD card files in a RAM cache, sent without copying. On boards with
+   external SDRAM, define LWIP_FS_CACHE_BASE to place the cache there. */
+#define LWIP_FS_CACHE                   1
+#define LWIP_FS_CACHE_SIZE              (32 * 1024)
+
+/* Persistent connections with pipelined requests, see httpd.c */
+#define LWIP_HTTPD_SUPPORT_REQUESTLIST  1
+#define LWIP_HTTPD_SUPPORT_11_KEEPALIVE 1
+
+/* Serve "<file>.gz" to clients that accept gzip, see makefsrom.c */
+#define LWIP_HTTPD_SUPPORT_GZIP         1
+
+/* Resume downloads with Range requests and read SD card files one block
+   ahead of TCP, see httpd.c */
+#define LWIP_HTTPD_SUPPORT_RANGE        1
+#define LWIP_HTTPD_READAHEAD            1
+
 /* Need for memory protection */
 #define SYS_LIGHTWEIGHT_PROT            0
 
@@ -61,8 +84,24 @@
 #define IP_SOF_BROADCAST                1
 #define IP_SOF_BROADCAST_RECV           1
 
+/* Checksum profile. With LPC_CHECKSUM_OFFLOAD set to 1, the EMAC inserts
+   and verifies the IP, UDP, TCP, and ICMP checksums and lwIP skips them.
+   Set it to 0 to compute all checksums in software. Note that UDP datagrams
+   fragmented by lwIP are sent without a UDP checksum when offloaded. */
+#define LPC_CHECKSUM_OFFLOAD            1
+
+#if LPC_CHECKSUM_OFFLOAD
+#define CHECKSUM_GEN_IP                 0
+#define CHECKSUM_GEN_UDP                0
+#define CHECKSUM_GEN_TCP                0
+#define CHECKSUM_GEN_ICMP               0
+#define CHECKSUM_CHECK_IP               0
+#define CHECKSUM_CHECK_UDP              0
+#define CHECKSUM_CHECK_TCP              0
+#define LWIP_CHECKSUM_ON_COPY           0
+#else
 /* The ethernet FCS is performed in hardware. The IP, TCP, and UDP
-   CRCs still need to be done in hardware. */
+   CRCs still need to be done in software. */
 #define CHECKSUM_GEN_IP                 1
 #define CHECKSUM_GEN_UDP                1
 #define CHECKSUM_GEN_TCP                1
@@ -70,6 +109,7 @@
 #define CHECKSUM_CHECK_UDP              1
 #define CHECKSUM_CHECK_TCP              1
 #define LWIP_CHECKSUM_ON_COPY           1
+#endif
 
 /* Use LWIP version of htonx() to allow generic functionality across
    all platforms. If you are using the Cortex Mx devices, you might
@@ -93,14 +133,18 @@
 
 /* MSS should match the hardware packet size */
 #define TCP_MSS                         1460
-#define TCP_SND_BUF                     (2 * TCP_MSS)
+/* Four segments in flight keep the link busy with read ahead files */
+#define TCP_SND_BUF                     (4 * TCP_MSS)
 
 #define LWIP_SOCKET                     0
 #define LWIP_NETCONN                    0
 #define MEMP_NUM_SYS_TIMEOUT            300
 
-#define LWIP_STATS                      0
-#define LINK_STATS                      0
+/* Protocol statistics are served with the EMAC driver counters at
+   /stats.json, 32-bit counters keep them from wrapping under load */
+#define LWIP_STATS                      1
+#define LWIP_STATS_LARGE                1
+#define LINK_STATS                      1
 #define LWIP_STATS_DISPLAY              0
 
 /* There are more *_DEBUG options that can be selected.
@@ -0,0 +1,192 @@
+/*
+ * @brief HTTP response headers of the webserver file system
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "lwip_fs.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* A part of a header */
+struct fs_hdr_blob {
+	const char *data;
+	u16_t len;
+};
+
+/* A file extension and its content type, index into fs_hdr_types */
+struct fs_hdr_ext {
+	const char *ext;
+	u8_t len;
+	u8_t type;
+};
+
+/* Generated by tools/makehdrtab from httpd_structs.h */
+#include "fs_headers_tab.h"
+
+#if FS_HDR_MAX_LEN > LWIP_FS_HDR_MAX_LEN
+#error "Headers of fs_headers_tab.h are longer than LWIP_FS_HDR_MAX_LEN"
+#endif
+
+/* Length of the Content-Length name ending each status blob */
+#define FS_HDR_CONTENT_LENGTH_LEN (sizeof("Content-Length: ") - 1)
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Perfect hash of an extension, keep in sync with tools/makehdrtab.c */
+static unsigned int fs_hdr_hash(const char *ext, unsigned int len)
+{
+	u32_t h = FS_HDR_HASH_SEED;
+
+	while (len--) {
+		h = (h ^ (u8_t) *ext++) * 16777619UL;
+	}
+	return (unsigned int) (h >> (32 - FS_HDR_HASH_BITS));
+}
+
+/* Content type of an extension, the default type if it is not known */
+static unsigned int fs_hdr_find_type(const char *ext, unsigned int len)
+{
+	const struct fs_hdr_ext *e = &fs_hdr_exts[fs_hdr_hash(ext, len)];
+
+	if ((e->len == len) && (memcmp(e->ext, ext, len) == 0)) {
+		return e->type;
+	}
+	return FS_HDR_TYPE_DEFAULT;
+}
+
+/* Status of a file, error pages have the status code in their name
+   ("404" before "400" before "501") */
+static unsigned int fs_hdr_find_status(const char *name, const char *end)
+{
+	unsigned int status = FS_HDR_STATUS_OK;
+
+	for (; (name + 3) <= end; name++) {
+		if (name[1] != '0') {
+			continue;
+		}
+		if (name[0] == '4') {
+			if (name[2] == '4') {
+				return FS_HDR_STATUS_404;
+			}
+			if (name[2] == '0') {
+				status = FS_HDR_STATUS_400;
+			}
+		}
+		else if ((name[0] == '5') && (name[2] == '1') && (status == FS_HDR_STATUS_OK)) {
+			status = FS_HDR_STATUS_501;
+		}
+	}
+	return status;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Build the HTTP header of a file */
+int fs_get_http_headers(const char *fName, char *buff, long size)
+{
+	const struct fs_hdr_blob *status, *type;
+	const char *pszEnd, *pszExt, *pszDot;
+	char digits[20], *pd;
+	unsigned long num;
+	int len, gzip = 0;
+
+	if ((fName == NULL) || (*fName == 0)) {
+		/* The default "404: Page not found" response */
+		status = &fs_hdr_status[FS_HDR_STATUS_404];
+		type = &fs_hdr_types[FS_HDR_TYPE_404][0];
+	}
+	else {
+		/* Names without an extension are special-case URLs used for control
+		   state notification, they get no headers */
+		pszEnd = fName + strlen(fName);
+		pszExt = strrchr(fName, '.');
+		if (pszExt == NULL) {
+			return 0;
+		}
+		status = &fs_hdr_status[fs_hdr_find_status(fName, pszEnd)];
+
+		/* A precompressed "<file>.<ext>.gz" has the type of <ext>, any other
+		   ".gz" is served as it is */
+		if (((pszEnd - pszExt) == 3) && (pszExt[1] == 'g') && (pszExt[2] == 'z')) {
+			pszDot = pszExt;
+			while ((pszDot != fName) && (*--pszDot != '.') && (*pszDot != '/')) {}
+			if ((pszDot != pszExt) && (*pszDot == '.')) {
+				gzip = 1;
+				pszEnd = pszExt;
+				pszExt = pszDot;
+			}
+		}
+		pszExt++;
+		type = &fs_hdr_types[(pszExt < pszEnd) ?
+							 fs_hdr_find_type(pszExt, pszEnd - pszExt) : FS_HDR_TYPE_DEFAULT][gzip];
+	}
+
+	/* Status line and Server header, the Content-Length if the size is known */
+	if (size >= 0) {
+		memcpy(buff, status->data, status->len);
+		len = status->len;
+		pd = &digits[sizeof(digits)];
+		num = (unsigned long) size;
+		do {
+			*--pd = '0' + (num % 10);
+			num /= 10;
+		} while (num != 0);
+		memcpy(&buff[len], pd, &digits[sizeof(digits)] - pd);
+		len += &digits[sizeof(digits)] - pd;
+		memcpy(&buff[len], type->data, type->len + 1);
+		len += type->len;
+	}
+	else {
+		len = status->len - FS_HDR_CONTENT_LENGTH_LEN;
+		memcpy(buff, status->data, len);
+		memcpy(&buff[len], type->data + 2, type->len - 2 + 1);
+		len += type->len - 2;
+	}
+	return len;
+}
+
+/* Add a Vary header to the header of a file that has a ".gz" variant */
+int fs_add_vary_header(char *buff, int len)
+{
+	static const char vary[] = "Vary: Accept-Encoding\r\n\r\n";
+
+	/* Replaces the empty line ending the header */
+	if (len >= 4) {
+		memcpy(&buff[len - 2], vary, sizeof(vary));
+		len += sizeof(vary) - 1 - 2;
+	}
+	return len;
+}
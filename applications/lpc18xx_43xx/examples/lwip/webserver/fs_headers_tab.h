@@ -0,0 +1,181 @@
+/*
+ * @brief	Webserver HTTP header table
+ *
+ * Generated by tools/makehdrtab from httpd_structs.h, do not edit.
+ */
+
+#ifndef __FS_HEADERS_TAB_H_
+#define __FS_HEADERS_TAB_H_
+
+/* Perfect hash of the file extensions, see fs_hdr_hash() */
+#define FS_HDR_HASH_BITS    5
+#define FS_HDR_HASH_SEED    0x0000065eUL
+
+/* Status line and Server header, followed by "Content-Length: " */
+static const char fs_hdr_status_OK[] = "HTTP/1.0 200 OK\r\n"
+	"Server: lwIP/1.3.1 (http://savannah.nongnu.org/projects/lwip)\r\n"
+	"Content-Length: ";
+static const char fs_hdr_status_404[] = "HTTP/1.0 404 File not found\r\n"
+	"Server: lwIP/1.3.1 (http://savannah.nongnu.org/projects/lwip)\r\n"
+	"Content-Length: ";
+static const char fs_hdr_status_400[] = "HTTP/1.0 400 Bad Request\r\n"
+	"Server: lwIP/1.3.1 (http://savannah.nongnu.org/projects/lwip)\r\n"
+	"Content-Length: ";
+static const char fs_hdr_status_501[] = "HTTP/1.0 501 Not Implemented\r\n"
+	"Server: lwIP/1.3.1 (http://savannah.nongnu.org/projects/lwip)\r\n"
+	"Content-Length: ";
+
+#define FS_HDR_STATUS_OK    0
+#define FS_HDR_STATUS_404   1
+#define FS_HDR_STATUS_400   2
+#define FS_HDR_STATUS_501   3
+
+static const struct fs_hdr_blob fs_hdr_status[] = {
+	{fs_hdr_status_OK, sizeof(fs_hdr_status_OK) - 1},
+	{fs_hdr_status_404, sizeof(fs_hdr_status_404) - 1},
+	{fs_hdr_status_400, sizeof(fs_hdr_status_400) - 1},
+	{fs_hdr_status_501, sizeof(fs_hdr_status_501) - 1},
+};
+
+/* CRLF ending the Content-Length, the Content-Encoding of a ".gz"
+   and the Content-type */
+static const char fs_hdr_type_0[] = "\r\n"
+	"Content-type: text/plain\r\n\r\n";
+static const char fs_hdr_type_0_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: text/plain\r\n\r\n";
+static const char fs_hdr_type_1[] = "\r\n"
+	"Content-type: text/html\r\n\r\n";
+static const char fs_hdr_type_1_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: text/html\r\n\r\n";
+static const char fs_hdr_type_2[] = "\r\n"
+	"Content-type: text/html\r\nExpires: Fri, 10 Apr 2008 14:00:00 GMT\r\nPragma: no-cache\r\n\r\n";
+static const char fs_hdr_type_2_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: text/html\r\nExpires: Fri, 10 Apr 2008 14:00:00 GMT\r\nPragma: no-cache\r\n\r\n";
+static const char fs_hdr_type_3[] = "\r\n"
+	"Content-type: image/gif\r\n\r\n";
+static const char fs_hdr_type_3_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: image/gif\r\n\r\n";
+static const char fs_hdr_type_4[] = "\r\n"
+	"Content-type: image/png\r\n\r\n";
+static const char fs_hdr_type_4_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: image/png\r\n\r\n";
+static const char fs_hdr_type_5[] = "\r\n"
+	"Content-type: image/jpeg\r\n\r\n";
+static const char fs_hdr_type_5_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: image/jpeg\r\n\r\n";
+static const char fs_hdr_type_6[] = "\r\n"
+	"Content-type: image/bmp\r\n\r\n";
+static const char fs_hdr_type_6_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: image/bmp\r\n\r\n";
+static const char fs_hdr_type_7[] = "\r\n"
+	"Content-type: image/x-icon\r\n\r\n";
+static const char fs_hdr_type_7_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: image/x-icon\r\n\r\n";
+static const char fs_hdr_type_8[] = "\r\n"
+	"Content-type: application/octet-stream\r\n\r\n";
+static const char fs_hdr_type_8_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: application/octet-stream\r\n\r\n";
+static const char fs_hdr_type_9[] = "\r\n"
+	"Content-type: application/x-javascript\r\n\r\n";
+static const char fs_hdr_type_9_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: application/x-javascript\r\n\r\n";
+static const char fs_hdr_type_10[] = "\r\n"
+	"Content-type: text/css\r\n\r\n";
+static const char fs_hdr_type_10_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: text/css\r\n\r\n";
+static const char fs_hdr_type_11[] = "\r\n"
+	"Content-type: application/x-shockwave-flash\r\n\r\n";
+static const char fs_hdr_type_11_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: application/x-shockwave-flash\r\n\r\n";
+static const char fs_hdr_type_12[] = "\r\n"
+	"Content-type: text/xml\r\n\r\n";
+static const char fs_hdr_type_12_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: text/xml\r\n\r\n";
+static const char fs_hdr_type_13[] = "\r\n"
+	"Content-type: application/json\r\nCache-Control: no-cache\r\n\r\n";
+static const char fs_hdr_type_13_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: application/json\r\nCache-Control: no-cache\r\n\r\n";
+static const char fs_hdr_type_14[] = "\r\n"
+	"Content-type: application/gzip\r\n\r\n";
+static const char fs_hdr_type_14_gz[] = "\r\n"
+	"Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+	"Content-type: application/gzip\r\n\r\n";
+static const char fs_hdr_type_404[] = "\r\n"
+	"\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n";
+
+#define FS_HDR_TYPE_DEFAULT 0
+#define FS_HDR_TYPE_404     15
+
+static const struct fs_hdr_blob fs_hdr_types[][2] = {
+	{{fs_hdr_type_0, sizeof(fs_hdr_type_0) - 1}, {fs_hdr_type_0_gz, sizeof(fs_hdr_type_0_gz) - 1}},
+	{{fs_hdr_type_1, sizeof(fs_hdr_type_1) - 1}, {fs_hdr_type_1_gz, sizeof(fs_hdr_type_1_gz) - 1}},
+	{{fs_hdr_type_2, sizeof(fs_hdr_type_2) - 1}, {fs_hdr_type_2_gz, sizeof(fs_hdr_type_2_gz) - 1}},
+	{{fs_hdr_type_3, sizeof(fs_hdr_type_3) - 1}, {fs_hdr_type_3_gz, sizeof(fs_hdr_type_3_gz) - 1}},
+	{{fs_hdr_type_4, sizeof(fs_hdr_type_4) - 1}, {fs_hdr_type_4_gz, sizeof(fs_hdr_type_4_gz) - 1}},
+	{{fs_hdr_type_5, sizeof(fs_hdr_type_5) - 1}, {fs_hdr_type_5_gz, sizeof(fs_hdr_type_5_gz) - 1}},
+	{{fs_hdr_type_6, sizeof(fs_hdr_type_6) - 1}, {fs_hdr_type_6_gz, sizeof(fs_hdr_type_6_gz) - 1}},
+	{{fs_hdr_type_7, sizeof(fs_hdr_type_7) - 1}, {fs_hdr_type_7_gz, sizeof(fs_hdr_type_7_gz) - 1}},
+	{{fs_hdr_type_8, sizeof(fs_hdr_type_8) - 1}, {fs_hdr_type_8_gz, sizeof(fs_hdr_type_8_gz) - 1}},
+	{{fs_hdr_type_9, sizeof(fs_hdr_type_9) - 1}, {fs_hdr_type_9_gz, sizeof(fs_hdr_type_9_gz) - 1}},
+	{{fs_hdr_type_10, sizeof(fs_hdr_type_10) - 1}, {fs_hdr_type_10_gz, sizeof(fs_hdr_type_10_gz) - 1}},
+	{{fs_hdr_type_11, sizeof(fs_hdr_type_11) - 1}, {fs_hdr_type_11_gz, sizeof(fs_hdr_type_11_gz) - 1}},
+	{{fs_hdr_type_12, sizeof(fs_hdr_type_12) - 1}, {fs_hdr_type_12_gz, sizeof(fs_hdr_type_12_gz) - 1}},
+	{{fs_hdr_type_13, sizeof(fs_hdr_type_13) - 1}, {fs_hdr_type_13_gz, sizeof(fs_hdr_type_13_gz) - 1}},
+	{{fs_hdr_type_14, sizeof(fs_hdr_type_14) - 1}, {fs_hdr_type_14_gz, sizeof(fs_hdr_type_14_gz) - 1}},
+	{{fs_hdr_type_404, sizeof(fs_hdr_type_404) - 1}, {fs_hdr_type_404, sizeof(fs_hdr_type_404) - 1}},
+};
+
+/* File extensions, indexed by fs_hdr_hash() */
+static const struct fs_hdr_ext fs_hdr_exts[1 << FS_HDR_HASH_BITS] = {
+	{"xml", 3, 12},
+	{"", 0, 0},
+	{"shtml", 5, 2},
+	{"shtm", 4, 2},
+	{"xsl", 3, 12},
+	{"gif", 3, 3},
+	{"html", 4, 1},
+	{"ico", 3, 7},
+	{"json", 4, 13},
+	{"", 0, 0},
+	{"", 0, 0},
+	{"", 0, 0},
+	{"", 0, 0},
+	{"png", 3, 4},
+	{"bmp", 3, 6},
+	{"", 0, 0},
+	{"", 0, 0},
+	{"gz", 2, 14},
+	{"", 0, 0},
+	{"js", 2, 9},
+	{"class", 5, 8},
+	{"", 0, 0},
+	{"ram", 3, 9},
+	{"", 0, 0},
+	{"", 0, 0},
+	{"cls", 3, 8},
+	{"htm", 3, 1},
+	{"", 0, 0},
+	{"css", 3, 10},
+	{"jpg", 3, 5},
+	{"swf", 3, 11},
+	{"ssi", 3, 2},
+};
+
+/* Longest header, with a 10 digit Content-Length and the NUL */
+#define FS_HDR_MAX_LEN      254
+
+#endif /* __FS_HEADERS_TAB_H_ */
@@ -0,0 +1,88 @@
+/*
+ * @brief Host (Linux) stand-in for the board layer used by the webserver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __BOARD_H_
+#define __BOARD_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_HOST Host build of the webserver
+ * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX
+ * httpd.c, lwip_fs.c and net_stats.c are built unchanged for Linux. The
+ * SD card functions used by lwip_fs.c do nothing, FatFs reads a disk image
+ * through fs_image.c instead. See readme.txt in this directory.
+ * @{
+ */
+
+/* Debug output goes to stdout */
+#define DEBUGOUT(...) printf(__VA_ARGS__)
+#define DEBUGSTR(str) printf("%s", str)
+
+/* SD/MMC card, the card is replaced by a disk image */
+typedef struct {
+	void (*evsetup_cb)(void *);
+	uint32_t (*waitfunc_cb)(void);
+	void (*msdelay_func)(uint32_t);
+} SDMMC_CARD_T;
+
+typedef struct {
+	SDMMC_CARD_T card_info;
+} mci_card_struct;
+
+#define LPC_SDMMC                   NULL
+#define LPC_RITIMER                 NULL
+#define SDIO_IRQn                   0
+#define SystemCoreClock             0
+
+#define Board_SDMMC_Init()          do {} while (0)
+#define Chip_SDIF_Init(p)           do {} while (0)
+#define Chip_SDIF_SetIntMask(p, m)  ((void) (m))
+#define Chip_SDIF_ClrIntStatus(p, s) do {} while (0)
+#define Chip_SDIF_GetIntStatus(p)   0
+#define Chip_RIT_GetCounter(p)      0
+#define NVIC_EnableIRQ(irq)         do {} while (0)
+#define NVIC_DisableIRQ(irq)        do {} while (0)
+#define NVIC_ClearPendingIRQ(irq)   do {} while (0)
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOARD_H_ */
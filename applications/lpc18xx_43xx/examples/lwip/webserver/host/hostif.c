@@ -0,0 +1,235 @@
+/*
+ * @brief Host (Linux) tap network interface for the webserver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/if.h>
+#include <linux/if_tun.h>
+
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/snmp.h"
+#include "netif/etharp.h"
+#include "arch/lpc18xx_43xx_emac.h"
+#include "hostif.h"
+
+/**
+ * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_HOST
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Largest frame without FCS */
+#define HOSTIF_FRAME_SZ 1514
+
+/* There is only one interface */
+static int tap_fd = -1;
+static struct lpc_emac_rx_stats rx_stats;
+static struct lpc_emac_tx_stats tx_stats;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Gives the Linux side of the tap device an address and brings it up */
+static int hostif_config(const char *name, const ip_addr_t *addr, const ip_addr_t *mask)
+{
+	struct ifreq ifr;
+	struct sockaddr_in *sin = (struct sockaddr_in *) &ifr.ifr_addr;
+	int s, ret = -1;
+
+	s = socket(AF_INET, SOCK_DGRAM, 0);
+	if (s < 0) {
+		return -1;
+	}
+	memset(&ifr, 0, sizeof(ifr));
+	snprintf(ifr.ifr_name, IFNAMSIZ, "%s", name);
+	sin->sin_family = AF_INET;
+	sin->sin_addr.s_addr = ip4_addr_get_u32(addr);
+	if (ioctl(s, SIOCSIFADDR, &ifr) < 0) {
+		goto out;
+	}
+	sin->sin_addr.s_addr = ip4_addr_get_u32(mask);
+	if (ioctl(s, SIOCSIFNETMASK, &ifr) < 0) {
+		goto out;
+	}
+	if (ioctl(s, SIOCGIFFLAGS, &ifr) < 0) {
+		goto out;
+	}
+	ifr.ifr_flags |= IFF_UP | IFF_RUNNING;
+	if (ioctl(s, SIOCSIFFLAGS, &ifr) < 0) {
+		goto out;
+	}
+	ret = 0;
+
+out:
+	close(s);
+	return ret;
+}
+
+/* Sends a frame to the tap device */
+static err_t hostif_output(struct netif *netif, struct pbuf *p)
+{
+	u8_t frame[HOSTIF_FRAME_SZ];
+	u16_t len;
+
+	len = pbuf_copy_partial(p, frame, sizeof(frame), 0);
+	if (write(tap_fd, frame, len) != len) {
+		tx_stats.errors++;
+		LINK_STATS_INC(link.err);
+		snmp_inc_ifoutdiscards(netif);
+		return ERR_IF;
+	}
+	tx_stats.frames++;
+	LINK_STATS_INC(link.xmit);
+	snmp_add_ifoutoctets(netif, len);
+	return ERR_OK;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Creates the tap device and initializes the netif */
+err_t hostif_init(struct netif *netif)
+{
+	const char *name = netif->state ? (const char *) netif->state : "tap0";
+	struct ifreq ifr;
+
+	tap_fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+	if (tap_fd < 0) {
+		perror("hostif: /dev/net/tun");
+		return ERR_IF;
+	}
+	memset(&ifr, 0, sizeof(ifr));
+	ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+	snprintf(ifr.ifr_name, IFNAMSIZ, "%s", name);
+	if ((ioctl(tap_fd, TUNSETIFF, &ifr) < 0) ||
+		(hostif_config(ifr.ifr_name, &netif->gw, &netif->netmask) < 0)) {
+		perror("hostif: tap setup");
+		close(tap_fd);
+		tap_fd = -1;
+		return ERR_IF;
+	}
+
+	/* Locally administered address */
+	netif->hwaddr_len = ETHARP_HWADDR_LEN;
+	netif->hwaddr[0] = 0x02;
+	netif->hwaddr[1] = 0x00;
+	netif->hwaddr[2] = 0x4c;
+	netif->hwaddr[3] = 0x50;
+	netif->hwaddr[4] = 0x43;
+	netif->hwaddr[5] = 0x01;
+	netif->mtu = 1500;
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET |
+				   NETIF_FLAG_LINK_UP;
+	netif->name[0] = 't';
+	netif->name[1] = 'p';
+	netif->output = etharp_output;
+	netif->linkoutput = hostif_output;
+	netif->state = NULL;
+	NETIF_INIT_SNMP(netif, snmp_ifType_ethernet_csmacd, 100000000);
+
+	return ERR_OK;
+}
+
+/* Waits for a frame on the tap device */
+int hostif_wait(struct netif *netif, int ms)
+{
+	struct pollfd pfd;
+
+	pfd.fd = tap_fd;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	return poll(&pfd, 1, ms) > 0;
+}
+
+/* Reads one frame from the tap device and passes it to lwIP */
+int hostif_input(struct netif *netif)
+{
+	u8_t frame[HOSTIF_FRAME_SZ];
+	struct pbuf *p;
+	ssize_t len;
+
+	len = read(tap_fd, frame, sizeof(frame));
+	if (len <= 0) {
+		return 0;
+	}
+	snmp_add_ifinoctets(netif, len);
+
+	/* Receive buffers come from the pool, as with the EMAC driver */
+	p = pbuf_alloc(PBUF_RAW, (u16_t) len, PBUF_POOL);
+	if (p == NULL) {
+		rx_stats.drops++;
+		LINK_STATS_INC(link.memerr);
+		LINK_STATS_INC(link.drop);
+		snmp_inc_ifindiscards(netif);
+		return 1;
+	}
+	pbuf_take(p, frame, (u16_t) len);
+	rx_stats.frames++;
+	LINK_STATS_INC(link.recv);
+
+	if (netif->input(p, netif) != ERR_OK) {
+		pbuf_free(p);
+	}
+	return 1;
+}
+
+/* Get receive path statistics, only the frame and drop counts apply */
+void lpc_emac_get_rx_stats(struct lpc_emac_rx_stats *stats)
+{
+	*stats = rx_stats;
+}
+
+/* Get transmit path statistics, only the frame and error counts apply */
+void lpc_emac_get_tx_stats(struct lpc_emac_tx_stats *stats)
+{
+	*stats = tx_stats;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,80 @@
+/*
+ * @brief Host (Linux) tap network interface for the webserver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __HOSTIF_H_
+#define __HOSTIF_H_
+
+#include "lwip/netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_HOST
+ * @{
+ */
+
+/**
+ * @brief	Creates the tap device and initializes the netif, used with netif_add()
+ * @param	netif	: lwip network interface structure pointer, netif->state
+ *                    holds the name of the tap device (NULL for "tap0")
+ * @return	ERR_OK or ERR_IF if the tap device could not be set up
+ * @note	The Linux side of the tap device gets the gateway address of the
+ * netif, so the host reaches the webserver through it. Needs CAP_NET_ADMIN.
+ */
+err_t hostif_init(struct netif *netif);
+
+/**
+ * @brief	Waits for a frame on the tap device
+ * @param	netif	: lwip network interface structure pointer
+ * @param	ms		: Longest time to wait in milliseconds
+ * @return	1 if a frame can be read, 0 on timeout
+ */
+int hostif_wait(struct netif *netif, int ms);
+
+/**
+ * @brief	Reads one frame from the tap device and passes it to lwIP
+ * @param	netif	: lwip network interface structure pointer
+ * @return	1 if a frame was read, 0 if there was none
+ * @note	Like lpc_enetif_input(), one frame is handled per call.
+ */
+int hostif_input(struct netif *netif);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOSTIF_H_ */
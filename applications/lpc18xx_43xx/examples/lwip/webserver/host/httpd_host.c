@@ -0,0 +1,277 @@
+/*
+ * @brief Host (Linux) build of the lwIP standalone webserver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lwip/init.h"
+#include "lwip/opt.h"
+#include "lwip/sys.h"
+#include "lwip/mem.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include "lwip/ip_addr.h"
+#include "lwip/netif.h"
+#include "lwip/timers.h"
+#include "netif/etharp.h"
+
+#include "fs_image.h"
+#include "hostif.h"
+#include "httpd.h"
+
+/**
+ * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_HOST
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* NETIF data */
+static struct netif host_netif;
+
+static volatile sig_atomic_t stop;
+static volatile sig_atomic_t report;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  -i addr    address of the webserver (default 10.1.10.234)\n"
+			"  -m mask    netmask (default 255.255.255.0)\n"
+			"  -g addr    gateway, given to the Linux side of the tap device\n"
+			"             (default 10.1.10.1)\n"
+			"  -t name    tap device (default tap0)\n"
+			"  -f image   FAT image used as the SD card, without it only the\n"
+			"             ROM image and /stats.json are served\n"
+			"  -c usec    latency injected per card command\n"
+			"  -l usec    latency injected per sector\n"
+			"The memory report is printed on SIGUSR1 and on exit (SIGINT).\n",
+			prog);
+	exit(2);
+}
+
+static void on_signal(int sig)
+{
+	if (sig == SIGUSR1) {
+		report = 1;
+	}
+	else {
+		stop = 1;
+	}
+}
+
+/* Prints the high-water marks of the heap and the pools, the values
+   MEM_SIZE and the MEMP_NUM_* options have to cover */
+static void print_memory_report(void)
+{
+	int i;
+
+	printf("\n%-16s %8s %8s %8s %8s\n", "", "avail", "used", "max", "err");
+#if MEM_STATS
+	printf("%-16s %8lu %8lu %8lu %8lu\n", "MEM_SIZE",
+		   (unsigned long) lwip_stats.mem.avail, (unsigned long) lwip_stats.mem.used,
+		   (unsigned long) lwip_stats.mem.max, (unsigned long) lwip_stats.mem.err);
+#endif
+#if MEMP_STATS
+	for (i = 0; i < MEMP_MAX; i++) {
+		printf("%-16s %8lu %8lu %8lu %8lu\n", lwip_stats.memp[i].name,
+			   (unsigned long) lwip_stats.memp[i].avail, (unsigned long) lwip_stats.memp[i].used,
+			   (unsigned long) lwip_stats.memp[i].max, (unsigned long) lwip_stats.memp[i].err);
+	}
+#endif
+#if LWIP_HTTPD_STATS
+	{
+		struct httpd_stats hs;
+
+		httpd_get_stats(&hs);
+		printf("httpd: %lu requests, %lu bytes by reference, %lu bytes copied\n",
+			   (unsigned long) hs.requests, (unsigned long) hs.bytes_ref,
+			   (unsigned long) hs.bytes_copied);
+	}
+#endif
+	fflush(stdout);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Milliseconds since the first call, for the lwIP timers */
+u32_t sys_now(void)
+{
+	static time_t start;
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	if (start == 0) {
+		start = ts.tv_sec;
+	}
+	return (u32_t) (((ts.tv_sec - start) * 1000) + (ts.tv_nsec / 1000000));
+}
+
+/* The card has no RTC to set up */
+void rtc_initialize(void)
+{}
+
+/* Displays an error message on assertion, and stops the server */
+void assert_printf(char *msg, int line, char *file)
+{
+	fprintf(stderr, "%s:%d in file %s\n", msg, line, file);
+	abort();
+}
+
+/**
+ * @brief	main routine for the host build of the webserver
+ * @return	0 after SIGINT or SIGTERM
+ */
+int main(int argc, char **argv)
+{
+	extern int fs_init(void);
+	ip_addr_t ipaddr, netmask, gw;
+	const char *tap = NULL, *image = NULL;
+	unsigned long cmd_us = 0, sect_us = 0;
+	int opt;
+
+	IP4_ADDR(&gw, 10, 1, 10, 1);
+	IP4_ADDR(&ipaddr, 10, 1, 10, 234);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+
+	while ((opt = getopt(argc, argv, "i:m:g:t:f:c:l:h")) != -1) {
+		switch (opt) {
+		case 'i':
+			if (!ipaddr_aton(optarg, &ipaddr)) {
+				usage(argv[0]);
+			}
+			break;
+
+		case 'm':
+			if (!ipaddr_aton(optarg, &netmask)) {
+				usage(argv[0]);
+			}
+			break;
+
+		case 'g':
+			if (!ipaddr_aton(optarg, &gw)) {
+				usage(argv[0]);
+			}
+			break;
+
+		case 't':
+			tap = optarg;
+			break;
+
+		case 'f':
+			image = optarg;
+			break;
+
+		case 'c':
+			cmd_us = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'l':
+			sect_us = strtoul(optarg, NULL, 0);
+			break;
+
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if (image != NULL) {
+		if (FSIMG_Open(image) < 0) {
+			perror(image);
+			return 1;
+		}
+		FSIMG_SetLatency(cmd_us, sect_us);
+	}
+	fs_init();
+
+	/* Initialize LWIP */
+	lwip_init();
+
+	if (netif_add(&host_netif, &ipaddr, &netmask, &gw, (void *) tap, hostif_init,
+				  ethernet_input) == NULL) {
+		return 1;
+	}
+	netif_set_default(&host_netif);
+	netif_set_up(&host_netif);
+
+	/* Initialize and start application */
+	httpd_init();
+
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+	signal(SIGUSR1, on_signal);
+	printf("Serving on %s", ipaddr_ntoa(&ipaddr));
+	printf(", host side of the tap device is %s\n", ipaddr_ntoa(&gw));
+	fflush(stdout);
+
+	/* Same loop as the board, the wait stands in for the idle time */
+	while (!stop) {
+		if (hostif_wait(&host_netif, 1)) {
+			hostif_input(&host_netif);
+		}
+
+#if LWIP_HTTPD_READAHEAD
+		httpd_read_ahead();
+#endif
+
+		sys_check_timeouts();
+
+		if (report) {
+			report = 0;
+			print_memory_report();
+		}
+	}
+
+	print_memory_report();
+	FSIMG_Close();
+	return 0;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,660 @@
+/*
+ * @brief HTTP load generator for the webserver (host tool)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_CONNS   256
+#define MAX_PATHS   32
+#define RX_BUF_SZ   4096
+#define REQ_BUF_SZ  512
+#define STATS_BUF_SZ 8192
+#define MAX_POOLS   32
+
+/* Connection states */
+enum {
+	CONN_IDLE,			/* No socket, a request can be started */
+	CONN_CONNECTING,	/* Non-blocking connect in progress */
+	CONN_SENDING,		/* Request partly sent */
+	CONN_HEADER,		/* Waiting for the end of the response header */
+	CONN_BODY,			/* Receiving the response body */
+	CONN_CLOSING		/* Waiting for the server to close */
+};
+
+/* One client connection */
+typedef struct {
+	int fd;
+	int state;
+	struct timespec t0;		/* Start of the current request */
+	char req[REQ_BUF_SZ];
+	int req_len;
+	int req_sent;
+	char rx[RX_BUF_SZ];
+	int rx_len;				/* Header bytes in rx */
+	long clen;				/* Content-Length, -1 if the body ends at close */
+	long body;				/* Body bytes received */
+	int keep;				/* Connection stays open after the response */
+	int reused;				/* Request sent on a kept connection */
+} CONN_T;
+
+/* One memory pool from /stats.json */
+typedef struct {
+	char name[32];
+	unsigned long avail, used, max, err;
+} POOL_T;
+
+/* Memory statistics from /stats.json */
+typedef struct {
+	int valid;
+	int npools;
+	POOL_T pools[MAX_POOLS];	/* pools[0] is the heap (MEM_SIZE) */
+} MEMSTATS_T;
+
+/* Run parameters, see usage() */
+static struct sockaddr_in server;
+static const char *hostName;
+static const char *paths[MAX_PATHS];
+static int nPaths;
+static int nConns = 4;
+static double duration = 10.0;
+static unsigned long maxRequests;
+static int keepAlive;
+static int useGzip;
+static int timeoutMs = 5000;
+static const char *statsPath = "/stats.json";
+
+/* Results */
+static CONN_T conns[MAX_CONNS];
+static unsigned long started, completed, nextPath;
+static unsigned long errConnect, errTimeout, errStatus, errClosed;
+static unsigned long statusClass[6];	/* Responses by status class, [0] unparsable */
+static unsigned long connects, retries;
+static unsigned long long bodyBytes;
+static unsigned int *latUs;
+static unsigned long latCount, latSize;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+			"usage: %s [options] host[:port] path [path...]\n"
+			"  -c conns   concurrent connections (default %d, max %d)\n"
+			"  -d secs    run time (default %.0f)\n"
+			"  -n count   stop after count requests instead\n"
+			"  -k         keep connections open (HTTP/1.1 keep-alive)\n"
+			"  -z         send Accept-Encoding: gzip\n"
+			"  -t msec    response timeout (default %d)\n"
+			"  -s path    statistics document (default %s, - for none)\n"
+			"The paths are requested in turn. Latency is measured from the start\n"
+			"of a request (the connect, without -k) to the last byte of the body.\n"
+			"Requests on kept connections that the server closed before answering\n"
+			"are sent again on a new connection and counted as retried.\n",
+			prog, nConns, MAX_CONNS, duration, timeoutMs, statsPath);
+	exit(2);
+}
+
+static double elapsed(const struct timespec *t0, const struct timespec *t1)
+{
+	return (t1->tv_sec - t0->tv_sec) + (t1->tv_nsec - t0->tv_nsec) / 1e9;
+}
+
+static void record_latency(const struct timespec *t0)
+{
+	struct timespec t1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	if (latCount == latSize) {
+		latSize = latSize ? (latSize * 2) : 65536;
+		latUs = realloc(latUs, latSize * sizeof(*latUs));
+		if (latUs == NULL) {
+			perror("realloc");
+			exit(1);
+		}
+	}
+	latUs[latCount++] = (unsigned int) (elapsed(t0, &t1) * 1e6);
+}
+
+static int cmp_uint(const void *a, const void *b)
+{
+	unsigned int x = *(const unsigned int *) a, y = *(const unsigned int *) b;
+
+	return (x > y) - (x < y);
+}
+
+/* Latency below which pct percent of the requests completed */
+static double percentile(double pct)
+{
+	unsigned long i = (unsigned long) ((pct / 100.0) * latCount);
+
+	if (i >= latCount) {
+		i = latCount - 1;
+	}
+	return latUs[i] / 1000.0;
+}
+
+static void parse_server(const char *arg)
+{
+	char host[256];
+	const char *colon = strrchr(arg, ':');
+	struct addrinfo hints, *res;
+	int port = 80;
+
+	if (colon != NULL) {
+		snprintf(host, sizeof(host), "%.*s", (int) (colon - arg), arg);
+		port = atoi(colon + 1);
+	}
+	else {
+		snprintf(host, sizeof(host), "%s", arg);
+	}
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	if (getaddrinfo(host, NULL, &hints, &res) != 0) {
+		fprintf(stderr, "unknown host %s\n", host);
+		exit(2);
+	}
+	memcpy(&server, res->ai_addr, sizeof(server));
+	server.sin_port = htons(port);
+	freeaddrinfo(res);
+	hostName = arg;
+}
+
+static void conn_close(CONN_T *c)
+{
+	if (c->fd >= 0) {
+		close(c->fd);
+	}
+	c->fd = -1;
+	c->state = CONN_IDLE;
+}
+
+/* Opens a non-blocking connection to the server */
+static int conn_open(CONN_T *c)
+{
+	int one = 1;
+
+	c->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	if (c->fd < 0) {
+		perror("socket");
+		exit(1);
+	}
+	setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	connects++;
+	if ((connect(c->fd, (struct sockaddr *) &server, sizeof(server)) < 0) &&
+		(errno != EINPROGRESS)) {
+		return -1;
+	}
+	c->state = CONN_CONNECTING;
+	return 0;
+}
+
+/* Starts the next request, on the open connection or a new one */
+static void conn_start(CONN_T *c)
+{
+	const char *path = paths[nextPath++ % nPaths];
+
+	started++;
+	clock_gettime(CLOCK_MONOTONIC, &c->t0);
+	c->req_len = snprintf(c->req, sizeof(c->req),
+						  "GET %s HTTP/1.1\r\nHost: %s\r\n%sConnection: %s\r\n\r\n",
+						  path, hostName, useGzip ? "Accept-Encoding: gzip\r\n" : "",
+						  keepAlive ? "keep-alive" : "close");
+	c->req_sent = 0;
+	c->rx_len = 0;
+	c->clen = -1;
+	c->body = 0;
+	c->keep = 0;
+	c->reused = (c->fd >= 0);
+
+	if (c->fd >= 0) {
+		c->state = CONN_SENDING;
+	}
+	else if (conn_open(c) < 0) {
+		errConnect++;
+		conn_close(c);
+	}
+}
+
+/* Parses the response header, returns 0 if the status is 2xx */
+static int parse_header(CONN_T *c, char *end)
+{
+	char *line, *next;
+	int status = 0;
+
+	*end = '\0';
+	if ((sscanf(c->rx, "HTTP/1.%*d %d", &status) != 1) || (status < 100) || (status > 599)) {
+		statusClass[0]++;
+		return -1;
+	}
+	statusClass[status / 100]++;
+	/* HTTP/1.1 responses keep the connection unless told otherwise */
+	c->keep = keepAlive && (strncmp(c->rx, "HTTP/1.1", 8) == 0);
+	for (line = strstr(c->rx, "\r\n"); line != NULL; line = next) {
+		line += 2;
+		next = strstr(line, "\r\n");
+		if (strncasecmp(line, "Content-Length:", 15) == 0) {
+			c->clen = strtol(line + 15, NULL, 10);
+		}
+		else if (strncasecmp(line, "Connection:", 11) == 0) {
+			c->keep = (strstr(line, "lose") == NULL) && keepAlive;
+		}
+	}
+	if (c->clen < 0) {
+		c->keep = 0;
+	}
+	return ((status >= 200) && (status < 300)) ? 0 : -1;
+}
+
+/* Ends the current request, successful or not */
+static void conn_done(CONN_T *c, int ok)
+{
+	if (ok) {
+		completed++;
+		bodyBytes += c->body;
+		record_latency(&c->t0);
+	}
+	if (!ok) {
+		conn_close(c);
+	}
+	else if (!c->keep) {
+		/* The server closes first, so the client ports are not held in
+		   TIME_WAIT and the server's closed connections are measured */
+		c->state = CONN_CLOSING;
+	}
+	else {
+		c->state = CONN_IDLE;
+	}
+}
+
+/* Handles poll events of a connection */
+static void conn_event(CONN_T *c, short revents)
+{
+	char *end;
+	ssize_t n;
+	int err;
+	socklen_t len = sizeof(err);
+
+	switch (c->state) {
+	case CONN_CONNECTING:
+		if (getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &err, &len) || err) {
+			errConnect++;
+			conn_close(c);
+			return;
+		}
+		c->state = CONN_SENDING;
+		/* Fall through */
+
+	case CONN_SENDING:
+		n = send(c->fd, &c->req[c->req_sent], c->req_len - c->req_sent, MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno != EAGAIN) {
+				errClosed++;
+				conn_close(c);
+			}
+			return;
+		}
+		c->req_sent += n;
+		if (c->req_sent == c->req_len) {
+			c->state = CONN_HEADER;
+		}
+		return;
+
+	case CONN_HEADER:
+		n = recv(c->fd, &c->rx[c->rx_len], sizeof(c->rx) - 1 - c->rx_len, 0);
+		if (n <= 0) {
+			if ((n < 0) && (errno == EAGAIN)) {
+				return;
+			}
+			conn_close(c);
+			if (c->reused && (c->rx_len == 0)) {
+				/* The server may close a kept connection at any time,
+				   the request is sent again on a new one */
+				retries++;
+				c->reused = 0;
+				c->req_sent = 0;
+				if (conn_open(c) < 0) {
+					errConnect++;
+					conn_close(c);
+				}
+				return;
+			}
+			errClosed++;
+			return;
+		}
+		c->rx_len += n;
+		c->rx[c->rx_len] = '\0';
+		end = strstr(c->rx, "\r\n\r\n");
+		if (end == NULL) {
+			if (c->rx_len == (sizeof(c->rx) - 1)) {
+				errStatus++;
+				conn_close(c);
+			}
+			return;
+		}
+		c->body = c->rx_len - ((end + 4) - c->rx);
+		if (parse_header(c, end) < 0) {
+			errStatus++;
+			conn_close(c);
+			return;
+		}
+		c->state = CONN_BODY;
+		break;
+
+	case CONN_BODY:
+		n = recv(c->fd, c->rx, sizeof(c->rx), 0);
+		if (n < 0) {
+			if (errno != EAGAIN) {
+				errClosed++;
+				conn_close(c);
+			}
+			return;
+		}
+		if (n == 0) {
+			/* A body without Content-Length ends at close */
+			if (c->clen < 0) {
+				conn_done(c, 1);
+			}
+			else {
+				errClosed++;
+				conn_close(c);
+			}
+			return;
+		}
+		c->body += n;
+		break;
+
+	case CONN_CLOSING:
+		n = recv(c->fd, c->rx, sizeof(c->rx), 0);
+		if ((n == 0) || ((n < 0) && (errno != EAGAIN))) {
+			conn_close(c);
+		}
+		return;
+
+	default:
+		return;
+	}
+
+	if ((c->clen >= 0) && (c->body >= c->clen)) {
+		conn_done(c, 1);
+	}
+}
+
+/* Fetches a document with a blocking connection, returns its length */
+static int http_get(const char *path, char *buf, int size)
+{
+	char req[REQ_BUF_SZ];
+	int fd, len = 0, n;
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if ((fd < 0) || (connect(fd, (struct sockaddr *) &server, sizeof(server)) < 0)) {
+		if (fd >= 0) {
+			close(fd);
+		}
+		return -1;
+	}
+	n = snprintf(req, sizeof(req), "GET %s HTTP/1.0\r\nHost: %s\r\n\r\n", path, hostName);
+	if (send(fd, req, n, MSG_NOSIGNAL) != n) {
+		close(fd);
+		return -1;
+	}
+	while ((len < (size - 1)) && ((n = recv(fd, &buf[len], size - 1 - len, 0)) > 0)) {
+		len += n;
+	}
+	buf[len] = '\0';
+	close(fd);
+	return len;
+}
+
+/* Reads the heap and pool statistics from the statistics document */
+static void get_memstats(MEMSTATS_T *ms)
+{
+	static char buf[STATS_BUF_SZ];
+	POOL_T *p;
+	char *s;
+	int n;
+
+	memset(ms, 0, sizeof(*ms));
+	if ((statsPath == NULL) || (http_get(statsPath, buf, sizeof(buf)) <= 0)) {
+		return;
+	}
+
+	s = strstr(buf, "\"mem\":{");
+	p = &ms->pools[0];
+	if ((s == NULL) ||
+		(sscanf(s, "\"mem\":{\"avail\":%lu,\"used\":%lu,\"max\":%lu,\"err\":%lu}",
+				&p->avail, &p->used, &p->max, &p->err) != 4)) {
+		return;
+	}
+	strcpy(p->name, "MEM_SIZE");
+	ms->npools = 1;
+	ms->valid = 1;
+
+	/* The pools are only listed when they are not taken from the heap */
+	s = strstr(buf, "\"memp\":{");
+	if (s == NULL) {
+		return;
+	}
+	s += 8;
+	while (ms->npools < MAX_POOLS) {
+		p = &ms->pools[ms->npools];
+		n = 0;
+		if ((sscanf(s, "\"%31[^\"]\":{\"avail\":%lu,\"used\":%lu,\"max\":%lu,\"err\":%lu}%n",
+					p->name, &p->avail, &p->used, &p->max, &p->err, &n) != 5) || (n == 0)) {
+			break;
+		}
+		ms->npools++;
+		s += n;
+		if (*s != ',') {
+			break;
+		}
+		s++;
+	}
+}
+
+static void print_memstats(const MEMSTATS_T *before, const MEMSTATS_T *after)
+{
+	int i;
+
+	if (!after->valid) {
+		printf("no memory statistics at %s\n", statsPath ? statsPath : "-");
+		return;
+	}
+	printf("\n%-16s %8s %8s %8s %8s\n", "memory", "avail", "max", "max %", "err");
+	for (i = 0; i < after->npools; i++) {
+		const POOL_T *p = &after->pools[i];
+		unsigned long err0 = 0;
+
+		if (before->valid && (i < before->npools) &&
+			(strcmp(before->pools[i].name, p->name) == 0)) {
+			err0 = before->pools[i].err;
+		}
+		printf("%-16s %8lu %8lu %7.0f%% %8lu\n", p->name, p->avail, p->max,
+			   p->avail ? (100.0 * p->max / p->avail) : 0.0, p->err - err0);
+	}
+	printf("max is the high-water mark since the server started, err counts\n"
+		   "the allocations that failed during this run\n");
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+	struct pollfd pfds[MAX_CONNS];
+	struct timespec t0, now;
+	MEMSTATS_T ms0, ms1;
+	double secs, sum = 0;
+	unsigned long i;
+	int opt, done, n;
+
+	while ((opt = getopt(argc, argv, "c:d:n:kzt:s:h")) != -1) {
+		switch (opt) {
+		case 'c':
+			nConns = atoi(optarg);
+			break;
+
+		case 'd':
+			duration = atof(optarg);
+			break;
+
+		case 'n':
+			maxRequests = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'k':
+			keepAlive = 1;
+			break;
+
+		case 'z':
+			useGzip = 1;
+			break;
+
+		case 't':
+			timeoutMs = atoi(optarg);
+			break;
+
+		case 's':
+			statsPath = strcmp(optarg, "-") ? optarg : NULL;
+			break;
+
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (((argc - optind) < 2) || (nConns < 1) || (nConns > MAX_CONNS)) {
+		usage(argv[0]);
+	}
+	parse_server(argv[optind++]);
+	while ((optind < argc) && (nPaths < MAX_PATHS)) {
+		paths[nPaths++] = argv[optind++];
+	}
+
+	get_memstats(&ms0);
+
+	for (n = 0; n < nConns; n++) {
+		conns[n].fd = -1;
+		conns[n].state = CONN_IDLE;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		done = maxRequests ? (started >= maxRequests) : (elapsed(&t0, &now) >= duration);
+
+		for (n = 0; n < nConns; n++) {
+			CONN_T *c = &conns[n];
+
+			if ((c->state == CONN_IDLE) && !done) {
+				conn_start(c);
+			}
+			else if ((c->state != CONN_IDLE) && (elapsed(&c->t0, &now) * 1000 > timeoutMs)) {
+				errTimeout++;
+				conn_close(c);
+			}
+			pfds[n].fd = (c->state == CONN_IDLE) ? -1 : c->fd;
+			pfds[n].events = ((c->state == CONN_CONNECTING) || (c->state == CONN_SENDING)) ?
+							 POLLOUT : POLLIN;
+			pfds[n].revents = 0;
+		}
+
+		if (poll(pfds, nConns, 10) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("poll");
+			exit(1);
+		}
+		for (n = 0; n < nConns; n++) {
+			if (pfds[n].revents) {
+				conn_event(&conns[n], pfds[n].revents);
+			}
+		}
+
+		/* Keep going until the requests in flight are answered */
+		for (n = 0; n < nConns; n++) {
+			if (conns[n].state != CONN_IDLE) {
+				break;
+			}
+		}
+	} while (!done || (n < nConns));
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	secs = elapsed(&t0, &now);
+
+	for (n = 0; n < nConns; n++) {
+		conn_close(&conns[n]);
+	}
+
+	printf("%lu requests in %.2f s over %d connections%s, %lu connects\n",
+		   completed, secs, nConns, keepAlive ? " (keep-alive)" : "", connects);
+	printf("%.1f requests/s, %.1f KB/s of body data\n",
+		   completed / secs, bodyBytes / secs / 1024.0);
+	printf("status: %lu 2xx, %lu 3xx, %lu 4xx, %lu 5xx, %lu other\n",
+		   statusClass[2], statusClass[3], statusClass[4], statusClass[5],
+		   statusClass[0] + statusClass[1]);
+	printf("errors: %lu connect, %lu timeout, %lu status, %lu closed, %lu retried\n",
+		   errConnect, errTimeout, errStatus, errClosed, retries);
+
+	if (latCount) {
+		qsort(latUs, latCount, sizeof(*latUs), cmp_uint);
+		for (i = 0; i < latCount; i++) {
+			sum += latUs[i];
+		}
+		printf("latency ms: min %.2f avg %.2f p50 %.2f p90 %.2f p99 %.2f p99.9 %.2f max %.2f\n",
+			   latUs[0] / 1000.0, sum / latCount / 1000.0, percentile(50), percentile(90),
+			   percentile(99), percentile(99.9), latUs[latCount - 1] / 1000.0);
+	}
+
+	get_memstats(&ms1);
+	print_memstats(&ms0, &ms1);
+
+	free(latUs);
+	return (errConnect || errTimeout || errStatus || errClosed) ? 1 : 0;
+}
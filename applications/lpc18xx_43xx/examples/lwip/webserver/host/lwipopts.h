@@ -0,0 +1,112 @@
+/*
+ * @brief LWIP build options for the host (Linux) build of the webserver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __HOST_LWIPOPTS_H_
+#define __HOST_LWIPOPTS_H_
+
+/* The options of the board build are measured, only what the host
+   cannot do like the board is changed below */
+#include "../configs/lwipopts.h"
+
+/* arch/cc.h defines BYTE_ORDER for the LPC, the C library of the host
+   has already defined it through <stdlib.h> */
+#undef BYTE_ORDER
+
+/* The tap device has no checksum offload */
+#undef LPC_CHECKSUM_OFFLOAD
+#undef CHECKSUM_GEN_IP
+#undef CHECKSUM_GEN_UDP
+#undef CHECKSUM_GEN_TCP
+#undef CHECKSUM_GEN_ICMP
+#undef CHECKSUM_CHECK_IP
+#undef CHECKSUM_CHECK_UDP
+#undef CHECKSUM_CHECK_TCP
+#undef LWIP_CHECKSUM_ON_COPY
+#define LPC_CHECKSUM_OFFLOAD            0
+#define CHECKSUM_GEN_IP                 1
+#define CHECKSUM_GEN_UDP                1
+#define CHECKSUM_GEN_TCP                1
+#define CHECKSUM_GEN_ICMP               1
+#define CHECKSUM_CHECK_IP               1
+#define CHECKSUM_CHECK_UDP              1
+#define CHECKSUM_CHECK_TCP              1
+#define LWIP_CHECKSUM_ON_COPY           1
+
+/* Take the heap and the pools from MEM_SIZE and the MEMP_NUM_* options
+   instead of malloc(), so their high-water marks show what they must be
+   set to. The statistics are served in /stats.json. The target takes
+   everything from the C heap without a limit, so the sizes here are large
+   enough not to fail under load; build with smaller ones (CC="gcc -D...")
+   to see how the server behaves when they run out. */
+#undef MEM_LIBC_MALLOC
+#undef MEMP_MEM_MALLOC
+#define MEM_LIBC_MALLOC                 0
+#define MEMP_MEM_MALLOC                 0
+#define MEM_STATS                       1
+#define MEMP_STATS                      1
+
+#ifndef HOST_MEM_SIZE
+#define HOST_MEM_SIZE                   (512 * 1024)
+#endif
+#undef MEM_SIZE
+#define MEM_SIZE                        HOST_MEM_SIZE
+
+#ifndef HOST_PBUF_POOL_SIZE
+#define HOST_PBUF_POOL_SIZE             64
+#endif
+#undef PBUF_POOL_SIZE
+#define PBUF_POOL_SIZE                  HOST_PBUF_POOL_SIZE
+
+#ifndef MEMP_NUM_TCP_PCB
+#define MEMP_NUM_TCP_PCB                64
+#endif
+#ifndef MEMP_NUM_TCP_SEG
+#define MEMP_NUM_TCP_SEG                256
+#endif
+#ifndef MEMP_NUM_PBUF
+#define MEMP_NUM_PBUF                   256
+#endif
+
+/* Room for the "memp" group in /stats.json */
+#ifndef NET_STATS_JSON_SZ
+#define NET_STATS_JSON_SZ               4096
+#endif
+
+/* Assertions abort the server, see assert_printf() in httpd_host.c */
+#ifndef LWIP_DEBUG
+#define LWIP_DEBUG                      1
+#endif
+/* lwip_fs.c does not get a default from httpd.c */
+#ifndef HTTPD_DEBUG
+#define HTTPD_DEBUG                     LWIP_DBG_OFF
+#endif
+
+#endif /* __HOST_LWIPOPTS_H_ */
@@ -90,7 +90,9 @@
 
 #if (defined(BOARD_HITEX_EVA_1850) || defined(BOARD_HITEX_EVA_4350))
 #define fs_open(nam) NULL
+#define fs_open_gz(nam) NULL
 #define fs_read(fp,buff,sz) 0
+#define fs_seek(fp,off) 1
 #endif
 
 #if LWIP_TCP
@@ -183,6 +185,83 @@
 #endif
 #endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
 
+/** Set this to 1 to keep connections open after a response (HTTP/1.1, or
+ * HTTP/1.0 with "Connection: keep-alive") and to serve requests that are
+ * pipelined behind it. A response is only kept alive if its file header
+ * includes a Content-Length. Needs LWIP_HTTPD_SUPPORT_REQUESTLIST and
+ * LWIP_HTTPD_DYNAMIC_HEADERS.
+ */
+#ifndef LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+#define LWIP_HTTPD_SUPPORT_11_KEEPALIVE     0
+#endif
+
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+#if !LWIP_HTTPD_SUPPORT_REQUESTLIST || !LWIP_HTTPD_DYNAMIC_HEADERS
+#error LWIP_HTTPD_SUPPORT_11_KEEPALIVE needs LWIP_HTTPD_SUPPORT_REQUESTLIST and LWIP_HTTPD_DYNAMIC_HEADERS
+#endif
+
+/** Number of requests served on one connection before it is closed */
+#ifndef LWIP_HTTPD_MAX_KEEPALIVE_REQUESTS
+#define LWIP_HTTPD_MAX_KEEPALIVE_REQUESTS   100
+#endif
+
+/** Number of poll intervals a persistent connection may stay idle between
+ * two requests before it is closed -> default is 3*2s = 6s */
+#ifndef HTTPD_KEEPALIVE_TIMEOUT
+#define HTTPD_KEEPALIVE_TIMEOUT             3
+#endif
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
+/** Set this to 1 to serve the precompressed variant "<uri>.gz" of a file
+ * if it exists and the client sends "Accept-Encoding: gzip". The file
+ * system adds the Content-Encoding header for files named
+ * "<file>.<ext>.gz", and a Vary header to files that have such a variant.
+ * Files processed for SSI tags are never served compressed.
+ */
+#ifndef LWIP_HTTPD_SUPPORT_GZIP
+#define LWIP_HTTPD_SUPPORT_GZIP             0
+#endif
+
+#if LWIP_HTTPD_SUPPORT_GZIP
+/** Longest URI for which a precompressed variant is looked for */
+#ifndef LWIP_HTTPD_MAX_GZIP_URI_LEN
+#define LWIP_HTTPD_MAX_GZIP_URI_LEN         63
+#endif
+#endif /* LWIP_HTTPD_SUPPORT_GZIP */
+
+/** Set this to 1 to answer a "Range: bytes=" request for a single byte
+ * range of a file with "206 Partial Content", so that an interrupted
+ * download can be resumed. Only files whose header (included by the file
+ * system) has a Content-Length are sent partially, requests with several
+ * ranges or an If-Range header get the whole file.
+ */
+#ifndef LWIP_HTTPD_SUPPORT_RANGE
+#define LWIP_HTTPD_SUPPORT_RANGE            0
+#endif
+
+#if LWIP_HTTPD_SUPPORT_RANGE
+#if !LWIP_HTTPD_DYNAMIC_HEADERS
+#error LWIP_HTTPD_SUPPORT_RANGE needs LWIP_HTTPD_DYNAMIC_HEADERS
+#endif
+/** Size of the buffer the header of a partial response is built in */
+#ifndef LWIP_HTTPD_RANGE_HDR_LEN
+#define LWIP_HTTPD_RANGE_HDR_LEN            320
+#endif
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+
+#if LWIP_HTTPD_READAHEAD
+/** Size of each of the two file read buffers of a connection */
+#ifndef LWIP_HTTPD_READ_BUF_SIZE
+#define LWIP_HTTPD_READ_BUF_SIZE            2048
+#endif
+
+/** Reads end on a multiple of this, so the file system reads whole
+ * sectors straight into the buffer */
+#ifndef LWIP_HTTPD_READ_ALIGN
+#define LWIP_HTTPD_READ_ALIGN               512
+#endif
+#endif /* LWIP_HTTPD_READAHEAD */
+
 /** Maximum length of the filename to send as response to a POST request,
  * filled in by the application when a POST is finished.
  */
@@ -216,25 +295,60 @@
 
 #define CRLF "\r\n"
 
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+#define HTTP11_CONNECTIONKEEPALIVE  "Connection: keep-alive"
+#define HTTP11_CONNECTIONKEEPALIVE2 "Connection: Keep-Alive"
+#define HTTP11_CONNECTIONCLOSE      "Connection: close"
+#define HTTP11_CONNECTIONCLOSE2     "Connection: Close"
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
 /** These defines check whether tcp_write has to copy data or not */
 
 /** This was TI's check whether to let TCP copy data or not
 #define HTTP_IS_DATA_VOLATILE(hs) ((hs->file < (char *)0x20000000) ? 0 : TCP_WRITE_FLAG_COPY)*/
+
+/** Set this to 0 to copy all file data into the TCP send buffer, even for
+ * files that stay valid after fs_close() (fs_file.is_static, the ROM
+ * image). Used to compare the zero-copy send path against the copying one.
+ */
+#ifndef LWIP_HTTPD_ZEROCOPY
+#define LWIP_HTTPD_ZEROCOPY 1
+#endif
+
+/** The file data is sent from file-system memory that outlives the
+ * connection, so tcp_write may reference it instead of copying it */
+#if LWIP_HTTPD_ZEROCOPY
+#define HTTP_IS_FILE_STATIC(hs) (((hs)->file != NULL) && ((hs)->handle != NULL) && \
+                                 (hs)->handle->is_static && ((hs)->file == \
+                                 (char*)(hs)->handle->data + (hs)->handle->len - (hs)->left))
+#else /* LWIP_HTTPD_ZEROCOPY */
+#define HTTP_IS_FILE_STATIC(hs) 0
+#endif /* LWIP_HTTPD_ZEROCOPY */
+
 #ifndef HTTP_IS_DATA_VOLATILE
 #if LWIP_HTTPD_SSI
-/* Copy for SSI files, no copy for non-SSI files */
-#define HTTP_IS_DATA_VOLATILE(hs)   ((hs)->tag_check ? TCP_WRITE_FLAG_COPY : 0)
+/* Copy for SSI files, no copy for static non-SSI files */
+#define HTTP_IS_DATA_VOLATILE(hs)   ((!(hs)->tag_check && HTTP_IS_FILE_STATIC(hs)) ? \
+                                     0 : TCP_WRITE_FLAG_COPY)
 #else /* LWIP_HTTPD_SSI */
-/** Default: don't copy if the data is sent from file-system directly */
-#define HTTP_IS_DATA_VOLATILE(hs) (((hs->file != NULL) && (hs->handle != NULL) && (hs->file == \
-                                   (char*)hs->handle->data + hs->handle->len - hs->left)) \
-                                   ? 0 : TCP_WRITE_FLAG_COPY)
+/** Default: don't copy if the data is sent from static file-system memory.
+ * Data read into hs->buf or built in a file's scratch buffer is copied,
+ * since it is reused or freed before the segments are acknowledged. */
+#define HTTP_IS_DATA_VOLATILE(hs) (HTTP_IS_FILE_STATIC(hs) ? 0 : TCP_WRITE_FLAG_COPY)
 #endif /* LWIP_HTTPD_SSI */
 #endif
 
-/** Default: headers are sent from ROM */
+/** Default: headers are sent from ROM, except the header of a partial
+ * response which is built in http_state */
 #ifndef HTTP_IS_HDR_VOLATILE
+#if LWIP_HTTPD_SUPPORT_RANGE
+#define HTTP_IS_HDR_VOLATILE(hs, ptr) ((((hs)->range_hdr != NULL) && \
+                                        ((const char*)(ptr) >= (hs)->range_hdr) && \
+                                        ((const char*)(ptr) < (hs)->range_hdr + LWIP_HTTPD_RANGE_HDR_LEN)) ? \
+                                       TCP_WRITE_FLAG_COPY : 0)
+#else /* LWIP_HTTPD_SUPPORT_RANGE */
 #define HTTP_IS_HDR_VOLATILE(hs, ptr) 0
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
 #endif
 
 #if LWIP_HTTPD_SSI
@@ -266,6 +380,23 @@ const default_filename g_psDefaultFilenames[] = {
 static char httpd_req_buf[LWIP_HTTPD_MAX_REQ_LENGTH+1];
 #endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
 
+#if LWIP_HTTPD_STATS
+/** Counters returned by httpd_get_stats() */
+static struct httpd_stats httpd_stats;
+#endif /* LWIP_HTTPD_STATS */
+
+#if LWIP_HTTPD_SUPPORT_GZIP
+/** The URI of the precompressed variant is built here */
+static char http_gzip_uri[LWIP_HTTPD_MAX_GZIP_URI_LEN + sizeof(".gz")];
+#endif /* LWIP_HTTPD_SUPPORT_GZIP */
+
+#if LWIP_HTTPD_SUPPORT_RANGE
+/** Kinds of byte range requested */
+#define HTTP_RANGE_NONE     0 /* no (usable) Range header */
+#define HTTP_RANGE_FROM     1 /* "bytes=first-" or "bytes=first-last" */
+#define HTTP_RANGE_SUFFIX   2 /* "bytes=-length", the end of the file */
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+
 #if LWIP_HTTPD_SUPPORT_POST
 /** Filename for response file to send when POST is finished */
 static char http_post_response_filename[LWIP_HTTPD_POST_MAX_RESPONSE_URI_LEN+1];
@@ -342,6 +473,31 @@ struct http_state {
 #if LWIP_HTTPD_TIMING
   u32_t time_started;
 #endif /* LWIP_HTTPD_TIMING */
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  u8_t keepalive;        /* Keep the connection open after this response */
+  u8_t idle;             /* Persistent connection waiting for a request */
+  u16_t num_requests;    /* Number of requests received on this connection */
+  u16_t req_len;         /* Length of the request being served in req */
+  const char *conn_hdr;  /* Connection header still to be sent */
+  const char *hdr_tail;  /* Final CRLF of the file header, conn_hdr goes here */
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_SUPPORT_GZIP
+  u8_t accept_gzip;      /* The client accepts a gzip Content-Encoding */
+#endif /* LWIP_HTTPD_SUPPORT_GZIP */
+#if LWIP_HTTPD_SUPPORT_RANGE
+  u8_t range_req;        /* HTTP_RANGE_* requested */
+  u32_t range_first;     /* First byte, or the length of a suffix range */
+  u32_t range_last;      /* Last byte, 0xffffffff for the end of the file */
+  char *range_hdr;       /* Header of a partial response, NULL if none */
+  u32_t range_left;      /* Bytes of the range still to read from the file */
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+#if LWIP_HTTPD_READAHEAD
+  char *ra_buf;          /* Buffer half holding the block read ahead */
+  int ra_len;            /* Length of that block, 0 if none */
+  u32_t read_off;        /* Offset in the file data of the next read */
+  struct http_state *ra_next; /* Next connection waiting to read ahead */
+  u8_t ra_queued;        /* In the read ahead list */
+#endif /* LWIP_HTTPD_READAHEAD */
 #if LWIP_HTTPD_SUPPORT_POST
   u32_t post_content_len_left;
 #if LWIP_HTTPD_POST_MANUAL_WND
@@ -355,6 +511,15 @@ struct http_state {
 static err_t http_find_file(struct http_state *hs, const char *uri, int is_09);
 static err_t http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const char *uri);
 static err_t http_poll(void *arg, struct tcp_pcb *pcb);
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+static err_t http_parse_request(struct pbuf **inp, struct http_state *hs, struct tcp_pcb *pcb);
+static void http_req_done(struct http_state *hs, err_t parsed);
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
+#if LWIP_HTTPD_READAHEAD
+/** Connections that have sent data and can read the next block */
+static struct http_state *http_ra_list;
+#endif /* LWIP_HTTPD_READAHEAD */
 
 #if LWIP_HTTPD_SSI
 /* SSI insert handler function pointer. */
@@ -415,6 +580,46 @@ http_state_alloc(void)
   return ret;
 }
 
+/** Close the file of the response that has been sent and reset the
+ * per-request state, so a persistent connection can take the next request.
+ * The file read buffer is kept for the next response.
+ */
+static void
+http_state_eof(struct http_state *hs)
+{
+  if(hs->handle) {
+#if LWIP_HTTPD_TIMING
+    u32_t ms_needed = sys_now() - hs->time_started;
+    u32_t needed = LWIP_MAX(1, (ms_needed/100));
+    LWIP_DEBUGF(HTTPD_DEBUG_TIMING, ("httpd: needed %"U32_F" ms to send file of %d bytes -> %"U32_F" bytes/sec\n",
+      ms_needed, hs->handle->len, ((((u32_t)hs->handle->len) * 10) / needed)));
+#endif /* LWIP_HTTPD_TIMING */
+    fs_close(hs->handle);
+    hs->handle = NULL;
+  }
+  hs->file = NULL;
+  hs->left = 0;
+  hs->retries = 0;
+#if LWIP_HTTPD_DYNAMIC_HEADERS
+  hs->hdr_index = NUM_FILE_HDR_STRINGS;
+#endif /* LWIP_HTTPD_DYNAMIC_HEADERS */
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  hs->keepalive = 0;
+  hs->conn_hdr = NULL;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_SUPPORT_RANGE
+  if (hs->range_hdr != NULL) {
+    mem_free(hs->range_hdr);
+    hs->range_hdr = NULL;
+  }
+  hs->range_left = 0;
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+#if LWIP_HTTPD_READAHEAD
+  hs->ra_len = 0;
+  hs->read_off = 0;
+#endif /* LWIP_HTTPD_READAHEAD */
+}
+
 /** Free a struct http_state.
  * Also frees the file data if dynamic.
  */
@@ -422,22 +627,28 @@ static void
 http_state_free(struct http_state *hs)
 {
   if (hs != NULL) {
-    if(hs->handle) {
-#if LWIP_HTTPD_TIMING
-      u32_t ms_needed = sys_now() - hs->time_started;
-      u32_t needed = LWIP_MAX(1, (ms_needed/100));
-      LWIP_DEBUGF(HTTPD_DEBUG_TIMING, ("httpd: needed %"U32_F" ms to send file of %d bytes -> %"U32_F" bytes/sec\n",
-        ms_needed, hs->handle->len, ((((u32_t)hs->handle->len) * 10) / needed)));
-#endif /* LWIP_HTTPD_TIMING */
-      fs_close(hs->handle);
-      hs->handle = NULL;
+    http_state_eof(hs);
+#if LWIP_HTTPD_READAHEAD
+    if (hs->ra_queued) {
+      struct http_state **pp = &http_ra_list;
+      while (*pp != hs) {
+        pp = &(*pp)->ra_next;
+      }
+      *pp = hs->ra_next;
     }
+#endif /* LWIP_HTTPD_READAHEAD */
 #if LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS
     if (hs->buf != NULL) {
       mem_free(hs->buf);
       hs->buf = NULL;
     }
 #endif /* LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS */
+#if LWIP_HTTPD_SUPPORT_REQUESTLIST
+    if (hs->req != NULL) {
+      pbuf_free(hs->req);
+      hs->req = NULL;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
 #if HTTPD_USE_MEM_POOL
     memp_free(MEMP_HTTPD_STATE, hs);
 #else /* HTTPD_USE_MEM_POOL */
@@ -759,6 +970,217 @@ get_http_headers(struct http_state *pState, char *pszURI)
 }
 #endif /* LWIP_HTTPD_DYNAMIC_HEADERS */
 
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+/**
+ * Send the file header up to its final CRLF, followed by the Connection
+ * header. The rest of the file is sent the usual way.
+ *
+ * @param pcb the pcb to send data
+ * @param hs connection state
+ * @return 1 if the Connection header has been sent, 0 to try again later
+ */
+static u8_t
+http_send_conn_hdr(struct tcp_pcb *pcb, struct http_state *hs)
+{
+  err_t err;
+  u16_t len, hdrlen;
+
+  if (hs->file < hs->hdr_tail) {
+    len = (u16_t)(hs->hdr_tail - hs->file);
+    if (len > tcp_sndbuf(pcb)) {
+      len = tcp_sndbuf(pcb);
+    }
+    err = http_write(pcb, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
+    if (err != ERR_OK) {
+      return 0;
+    }
+    hs->file += len;
+    hs->left -= len;
+    if (hs->file < hs->hdr_tail) {
+      return 0;
+    }
+  }
+
+  hdrlen = (u16_t)strlen(hs->conn_hdr);
+  len = hdrlen;
+  if (len > tcp_sndbuf(pcb)) {
+    len = tcp_sndbuf(pcb);
+  }
+  err = http_write(pcb, hs->conn_hdr, &len, HTTP_IS_HDR_VOLATILE(hs, hs->conn_hdr));
+  if (err != ERR_OK) {
+    return 0;
+  }
+  if (len < hdrlen) {
+    hs->conn_hdr += len;
+    return 0;
+  }
+  hs->conn_hdr = NULL;
+  return 1;
+}
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
+/** Possible results of http_eof() */
+#define HTTP_EOF_CLOSED   0 /* connection closed, hs has been freed */
+#define HTTP_EOF_IDLE     1 /* connection kept open for the next request */
+#define HTTP_EOF_NEXT     2 /* a pipelined request is ready to be sent */
+
+/**
+ * The response has been sent completely. Close the connection or, for a
+ * persistent connection, get ready for the next request and start on a
+ * request already pipelined behind this one.
+ *
+ * @param pcb the pcb of the connection
+ * @param hs connection state
+ * @return HTTP_EOF_CLOSED, HTTP_EOF_IDLE or HTTP_EOF_NEXT
+ */
+static u8_t
+http_eof(struct tcp_pcb *pcb, struct http_state *hs)
+{
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  if (hs->keepalive) {
+    struct pbuf *p = NULL;
+    err_t parsed;
+
+    LWIP_DEBUGF(HTTPD_DEBUG, ("End of file, keeping connection open.\n"));
+    http_state_eof(hs);
+    hs->idle = 1;
+    if (hs->req == NULL) {
+      return HTTP_EOF_IDLE;
+    }
+    parsed = http_parse_request(&p, hs, pcb);
+    http_req_done(hs, parsed);
+    if (parsed == ERR_OK) {
+      return HTTP_EOF_NEXT;
+    } else if (parsed == ERR_INPROGRESS) {
+      return HTTP_EOF_IDLE;
+    }
+  }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+  LWIP_DEBUGF(HTTPD_DEBUG, ("End of file.\n"));
+  http_close_conn(pcb, hs);
+  return HTTP_EOF_CLOSED;
+}
+
+/**
+ * Check whether all data of the response has been read from the file.
+ *
+ * @param hs connection state
+ * @return 1 if nothing is left to read, 0 otherwise
+ */
+static u8_t
+http_file_read_done(struct http_state *hs)
+{
+#if LWIP_HTTPD_READAHEAD
+  if (hs->ra_len != 0) {
+    return 0;
+  }
+#endif /* LWIP_HTTPD_READAHEAD */
+#if LWIP_HTTPD_SUPPORT_RANGE
+  if ((hs->range_hdr != NULL) && (hs->range_left == 0)) {
+    return 1;
+  }
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+  return fs_bytes_left(hs->handle) <= 0;
+}
+
+#if LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS
+/**
+ * Read the next block of the response from the file.
+ *
+ * @param hs connection state
+ * @param buf buffer to read into
+ * @param count size of the buffer
+ * @return number of bytes read, negative on error
+ */
+static int
+http_read_file(struct http_state *hs, char *buf, int count)
+{
+#if LWIP_HTTPD_READAHEAD
+  if (count > LWIP_HTTPD_READ_ALIGN) {
+    /* End on a sector boundary, the following reads are then aligned */
+    count -= (int)((hs->read_off + count) % LWIP_HTTPD_READ_ALIGN);
+  }
+#endif /* LWIP_HTTPD_READAHEAD */
+#if LWIP_HTTPD_SUPPORT_RANGE
+  if ((hs->range_hdr != NULL) && ((u32_t)count > hs->range_left)) {
+    count = (int)hs->range_left;
+  }
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+
+  LWIP_DEBUGF(HTTPD_DEBUG, ("Trying to read %d bytes.\n", count));
+  count = fs_read(hs->handle, buf, count);
+  if (count > 0) {
+#if LWIP_HTTPD_READAHEAD
+    hs->read_off += count;
+#endif /* LWIP_HTTPD_READAHEAD */
+#if LWIP_HTTPD_SUPPORT_RANGE
+    if (hs->range_hdr != NULL) {
+      hs->range_left -= count;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+  }
+  return count;
+}
+#endif /* LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS */
+
+#if LWIP_HTTPD_READAHEAD
+/**
+ * Queue a connection to read the next block of its file. The block is
+ * read by httpd_read_ahead(), after the segments written by the caller
+ * have been passed to the netif.
+ *
+ * @param hs connection state
+ */
+static void
+http_ra_queue(struct http_state *hs)
+{
+  if (!hs->ra_queued && (hs->buf != NULL) && (hs->ra_len == 0) &&
+#if LWIP_HTTPD_SSI
+      !hs->tag_check &&
+#endif /* LWIP_HTTPD_SSI */
+      !http_file_read_done(hs)) {
+    hs->ra_next = http_ra_list;
+    http_ra_list = hs;
+    hs->ra_queued = 1;
+  }
+}
+
+/**
+ * Read the next block of the file of each queued connection into the half
+ * of its buffer that is not being sent.
+ */
+void
+httpd_read_ahead(void)
+{
+  struct http_state *hs;
+  char *next;
+  int half, count;
+
+  while (http_ra_list != NULL) {
+    hs = http_ra_list;
+    http_ra_list = hs->ra_next;
+    hs->ra_queued = 0;
+    if ((hs->handle == NULL) || (hs->ra_len != 0) ||
+#if LWIP_HTTPD_SSI
+        hs->tag_check ||
+#endif /* LWIP_HTTPD_SSI */
+        http_file_read_done(hs)) {
+      continue;
+    }
+    half = hs->buf_len / 2;
+    next = hs->buf;
+    if ((hs->left != 0) && (hs->file >= hs->buf) && (hs->file < hs->buf + half)) {
+      next = hs->buf + half;
+    }
+    count = http_read_file(hs, next, half);
+    if (count > 0) {
+      hs->ra_buf = next;
+      hs->ra_len = count;
+    }
+  }
+}
+#endif /* LWIP_HTTPD_READAHEAD */
+
 /**
  * Try to send more data on this pcb.
  *
@@ -771,6 +1193,7 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
   err_t err;
   u16_t len;
   u16_t mss;
+  u8_t apiflags;
   u8_t data_to_send = false;
 #if LWIP_HTTPD_DYNAMIC_HEADERS
   u16_t hdrlen, sendlen;
@@ -791,6 +1214,13 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
     return 0;
   }
 
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  if (hs->idle) {
+    /* Waiting for the next request, nothing to send */
+    return 0;
+  }
+next_response:
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
   /* Assume no error until we find otherwise */
   err = ERR_OK;
 
@@ -850,9 +1280,13 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
 
   /* Have we run out of file data to send? If so, we need to read the next
    * block from the file. */
+#if LWIP_HTTPD_READAHEAD
+next_block:
+#endif /* LWIP_HTTPD_READAHEAD */
   if (hs->left == 0) {
 #if LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS
     int count;
+    char *buf;
 #endif /* LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS */
 
     /* Do we have a valid file handle? */
@@ -861,12 +1295,18 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
       http_close_conn(pcb, hs);
       return 0;
     }
-    if (fs_bytes_left(hs->handle) <= 0) {
-      /* We reached the end of the file so this request is done.
-       * @todo: don't close here for HTTP/1.1? */
-      LWIP_DEBUGF(HTTPD_DEBUG, ("End of file.\n"));
-      http_close_conn(pcb, hs);
-      return 0;
+    if (http_file_read_done(hs)) {
+      /* We reached the end of the file so this request is done. */
+      switch (http_eof(pcb, hs)) {
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+      case HTTP_EOF_NEXT:
+        goto next_response;
+      case HTTP_EOF_IDLE:
+        return data_to_send;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+      default:
+        return 0;
+      }
     }
 #if LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS
     /* Do we already have a send buffer allocated? */
@@ -874,8 +1314,13 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
       /* Yes - get the length of the buffer */
       count = hs->buf_len;
     } else {
+#if LWIP_HTTPD_READAHEAD
+      /* We don't have a send buffer so allocate one for two blocks. */
+      count = 2 * LWIP_HTTPD_READ_BUF_SIZE;
+#else /* LWIP_HTTPD_READAHEAD */
       /* We don't have a send buffer so allocate one up to 2mss bytes long. */
       count = 2 * tcp_mss(pcb);
+#endif /* LWIP_HTTPD_READAHEAD */
       do {
         hs->buf = (char*)mem_malloc((mem_size_t)count);
         if (hs->buf != NULL) {
@@ -892,10 +1337,25 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
       }
     }
 
+#if LWIP_HTTPD_READAHEAD
+    if (hs->ra_len != 0) {
+      /* The block has been read while the previous one was sent */
+      buf = hs->ra_buf;
+      count = hs->ra_len;
+      hs->ra_len = 0;
+#if LWIP_HTTPD_STATS
+      httpd_stats.readahead++;
+#endif /* LWIP_HTTPD_STATS */
+    } else {
+      /* Read a block of data from the file. */
+      buf = hs->buf;
+      count = http_read_file(hs, buf, hs->buf_len / 2);
+    }
+#else /* LWIP_HTTPD_READAHEAD */
     /* Read a block of data from the file. */
-    LWIP_DEBUGF(HTTPD_DEBUG, ("Trying to read %d bytes.\n", count));
-
-    count = fs_read(hs->handle, hs->buf, count);
+    buf = hs->buf;
+    count = http_read_file(hs, buf, count);
+#endif /* LWIP_HTTPD_READAHEAD */
     if(count < 0) {
       /* We reached the end of the file so this request is done.
        * @todo: don't close here for HTTP/1.1? */
@@ -907,16 +1367,26 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
     /* Set up to send the block of data we just read */
     LWIP_DEBUGF(HTTPD_DEBUG, ("Read %d bytes.\n", count));
     hs->left = count;
-    hs->file = hs->buf;
+    hs->file = buf;
 #if LWIP_HTTPD_SSI
     hs->parse_left = count;
-    hs->parsed = hs->buf;
+    hs->parsed = buf;
 #endif /* LWIP_HTTPD_SSI */
 #else /* LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS */
     LWIP_ASSERT("SSI and DYNAMIC_HEADERS turned off but eof not reached", 0);
 #endif /* LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS */
   }
 
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  if (hs->conn_hdr != NULL) {
+    u8_t sent = http_send_conn_hdr(pcb, hs);
+    data_to_send = true;
+    if (!sent) {
+      return data_to_send;
+    }
+  }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
 #if LWIP_HTTPD_SSI
   if(!hs->tag_check) {
 #endif /* LWIP_HTTPD_SSI */
@@ -932,15 +1402,36 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
       LWIP_ASSERT("hs->left did not fit into u16_t!", (len == hs->left));
     }
     mss = tcp_mss(pcb);
-    if(len > (2 * mss)) {
-      len = 2 * mss;
+    apiflags = HTTP_IS_DATA_VOLATILE(hs);
+    if (apiflags & TCP_WRITE_FLAG_COPY) {
+      if(len > (2 * mss)) {
+        len = 2 * mss;
+      }
+    } else if ((len < hs->left) && (len > mss)) {
+      /* Sent by reference: queue what fits into the send buffer, in full
+         segments unless this is the end of the file */
+      len -= len % mss;
     }
 
-    err = http_write(pcb, hs->file, &len, TCP_WRITE_FLAG_COPY);
+    err = http_write(pcb, hs->file, &len, apiflags);
     if (err == ERR_OK) {
       data_to_send = true;
       hs->file += len;
       hs->left -= len;
+#if LWIP_HTTPD_STATS
+      if (apiflags & TCP_WRITE_FLAG_COPY) {
+        httpd_stats.bytes_copied += len;
+      } else {
+        httpd_stats.bytes_ref += len;
+      }
+#endif /* LWIP_HTTPD_STATS */
+#if LWIP_HTTPD_READAHEAD
+      if ((hs->left == 0) && (tcp_sndbuf(pcb) >= mss) &&
+          (tcp_sndqueuelen(pcb) < TCP_SND_QUEUELEN) && !http_file_read_done(hs)) {
+        /* Fill the send buffer with the next block */
+        goto next_block;
+      }
+#endif /* LWIP_HTTPD_READAHEAD */
     }
 #if LWIP_HTTPD_SSI
   } else {
@@ -1279,13 +1770,26 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
   }
 #endif /* LWIP_HTTPD_SSI */
 
-  if((hs->left == 0) && (fs_bytes_left(hs->handle) <= 0)) {
+#if LWIP_HTTPD_READAHEAD
+  if (data_to_send) {
+    http_ra_queue(hs);
+  }
+#endif /* LWIP_HTTPD_READAHEAD */
+
+  if((hs->left == 0) && http_file_read_done(hs)) {
     /* We reached the end of the file so this request is done.
-     * This adds the FIN flag right into the last data segment.
-     * @todo: don't close here for HTTP/1.1? */
-    LWIP_DEBUGF(HTTPD_DEBUG, ("End of file.\n"));
-    http_close_conn(pcb, hs);
-    return 0;
+     * Closing adds the FIN flag right into the last data segment. */
+    switch (http_eof(pcb, hs)) {
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    case HTTP_EOF_NEXT:
+      data_to_send = true;
+      goto next_response;
+    case HTTP_EOF_IDLE:
+      return true;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+    default:
+      return 0;
+    }
   }
   LWIP_DEBUGF(HTTPD_DEBUG | LWIP_DBG_TRACE, ("send_data end.\n"));
   return data_to_send;
@@ -1555,6 +2059,514 @@ void httpd_post_data_recved(void *connection, u16_t recved_len)
 
 #endif /* LWIP_HTTPD_SUPPORT_POST */
 
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+/** Decide whether the connection stays open after the response.
+ *
+ * @param hs the connection state
+ * @param version the protocol version of the request line
+ * @param hdrs the request header lines
+ * @param hdrs_len length of the header lines
+ * @return 1 to keep the connection open, 0 to close it
+ */
+static u8_t
+http_want_keepalive(struct http_state *hs, const char *version, const char *hdrs, u16_t hdrs_len)
+{
+  hs->num_requests++;
+  if (hs->num_requests >= LWIP_HTTPD_MAX_KEEPALIVE_REQUESTS) {
+    /* the last response of this connection */
+    return 0;
+  }
+  if (!strncmp(version, "HTTP/1.1", 8)) {
+    /* HTTP/1.1 connections are persistent unless the client objects */
+    return (strnstr(hdrs, HTTP11_CONNECTIONCLOSE, hdrs_len) == NULL) &&
+           (strnstr(hdrs, HTTP11_CONNECTIONCLOSE2, hdrs_len) == NULL);
+  }
+  /* HTTP/1.0 clients have to ask for it */
+  return (strnstr(hdrs, HTTP11_CONNECTIONKEEPALIVE, hdrs_len) != NULL) ||
+         (strnstr(hdrs, HTTP11_CONNECTIONKEEPALIVE2, hdrs_len) != NULL);
+}
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
+#if LWIP_HTTPD_SUPPORT_GZIP
+/** Skip optional white space (RFC 7230 OWS) */
+static const char *
+http_skip_ows(const char *p, const char *end)
+{
+  while ((p < end) && ((*p == ' ') || (*p == '\t'))) {
+    p++;
+  }
+  return p;
+}
+
+/** Compare a content coding with a (lower case) name, ignoring case */
+static u8_t
+http_coding_is(const char *tok, u16_t tok_len, const char *name)
+{
+  u16_t i;
+
+  if (tok_len != strlen(name)) {
+    return 0;
+  }
+  for (i = 0; i < tok_len; i++) {
+    char c = tok[i];
+    if ((c >= 'A') && (c <= 'Z')) {
+      c += 'a' - 'A';
+    }
+    if (c != name[i]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/** Parse a qvalue (RFC 7231 section 5.3.1), "0" to "1.000".
+ *
+ * @param p start of the value
+ * @param end end of the header line
+ * @param q set to 0 if the value is 0, to 1 otherwise
+ * @return the first character after the value
+ */
+static const char *
+http_parse_qvalue(const char *p, const char *end, u8_t *q)
+{
+  *q = 1;
+  if ((p < end) && (*p == '0')) {
+    /* "0", "0.", "0.0" ... up to "0.999" */
+    *q = 0;
+    for (p++; (p < end) && ((*p == '.') || ((*p >= '0') && (*p <= '9'))); p++) {
+      if (*p > '0') {
+        *q = 1;
+      }
+    }
+  }
+  return p;
+}
+
+/** Check the Accept-Encoding request header for gzip. A coding given with
+ * a quality value of 0 ("gzip;q=0", "gzip ; q=0.0") is refused by the
+ * client. "*" stands for every coding that is not listed.
+ *
+ * @param hdrs the request header lines, starting with a CRLF
+ * @param hdrs_len length of the header lines
+ * @return 1 if the response may be gzip encoded, 0 otherwise
+ */
+static u8_t
+http_accepts_gzip(const char *hdrs, u16_t hdrs_len)
+{
+  const char *end = hdrs + hdrs_len;
+  const char *val;
+  const char *eol;
+  const char *tok;
+  u16_t tok_len;
+  u8_t q;
+  u8_t star = 0;
+
+  val = strnstr(hdrs, CRLF "Accept-Encoding:", hdrs_len);
+  if (val == NULL) {
+    val = strnstr(hdrs, CRLF "accept-encoding:", hdrs_len);
+  }
+  if (val == NULL) {
+    return 0;
+  }
+  val += sizeof(CRLF "Accept-Encoding:") - 1;
+  eol = strnstr(val, CRLF, end - val);
+  if (eol == NULL) {
+    eol = end;
+  }
+
+  /* #( coding *( OWS ";" OWS name "=" value ) ) */
+  while (val < eol) {
+    val = http_skip_ows(val, eol);
+    tok = val;
+    while ((val < eol) && (*val != ';') && (*val != ',') && (*val != ' ') && (*val != '\t')) {
+      val++;
+    }
+    tok_len = (u16_t)(val - tok);
+
+    q = 1;
+    for (val = http_skip_ows(val, eol); (val < eol) && (*val == ';'); val = http_skip_ows(val, eol)) {
+      val = http_skip_ows(val + 1, eol);
+      if ((val < eol) && ((*val == 'q') || (*val == 'Q'))) {
+        val = http_skip_ows(val + 1, eol);
+        if ((val < eol) && (*val == '=')) {
+          val = http_parse_qvalue(http_skip_ows(val + 1, eol), eol, &q);
+        }
+      }
+      /* rest of the parameter */
+      while ((val < eol) && (*val != ';') && (*val != ',')) {
+        val++;
+      }
+    }
+
+    if (http_coding_is(tok, tok_len, "gzip") || http_coding_is(tok, tok_len, "x-gzip")) {
+      return q;
+    }
+    if ((tok_len == 1) && (*tok == '*')) {
+      star = q;
+    }
+
+    while ((val < eol) && (*val != ',')) {
+      val++;
+    }
+    if (val < eol) {
+      val++;
+    }
+  }
+  /* gzip is not listed */
+  return star;
+}
+
+/** Open a file, preferring its precompressed variant if the client
+ * accepts gzip.
+ *
+ * @param hs the connection state
+ * @param uri the file to open
+ * @return the opened file or NULL if neither exists
+ */
+static struct fs_file *
+http_fs_open(struct http_state *hs, const char *uri)
+{
+  struct fs_file *file;
+  const char *base = strrchr(uri, '/');
+  size_t len = strlen(uri);
+#if LWIP_HTTPD_SSI
+  size_t loop;
+
+  for (loop = 0; loop < NUM_SHTML_EXTENSIONS; loop++) {
+    if (strstr(uri, g_pcSSIExtensions[loop])) {
+      return fs_open(uri);
+    }
+  }
+#endif /* LWIP_HTTPD_SSI */
+
+  /* Only files with an extension have a variant, "<uri>.gz" would
+     otherwise be served with the type of its ".gz" */
+  if (hs->accept_gzip && (len <= LWIP_HTTPD_MAX_GZIP_URI_LEN) &&
+      (strchr((base != NULL) ? base : uri, '.') != NULL)) {
+    MEMCPY(http_gzip_uri, uri, len);
+    MEMCPY(&http_gzip_uri[len], ".gz", sizeof(".gz"));
+    file = fs_open_gz(http_gzip_uri);
+    if (file != NULL) {
+      LWIP_DEBUGF(HTTPD_DEBUG | LWIP_DBG_TRACE, ("Opened %s\n", http_gzip_uri));
+#if LWIP_HTTPD_STATS
+      httpd_stats.gzip++;
+#endif /* LWIP_HTTPD_STATS */
+      return file;
+    }
+  }
+  return fs_open(uri);
+}
+#else /* LWIP_HTTPD_SUPPORT_GZIP */
+#define http_fs_open(hs, uri) fs_open(uri)
+#endif /* LWIP_HTTPD_SUPPORT_GZIP */
+
+#if LWIP_HTTPD_SUPPORT_RANGE
+/** Parse a decimal number.
+ *
+ * @param str the digits
+ * @param end end of the string
+ * @param val the number is returned here
+ * @return pointer after the digits, NULL if there are none or on overflow
+ */
+static const char *
+http_parse_u32(const char *str, const char *end, u32_t *val)
+{
+  const char *start = str;
+  u32_t v = 0;
+
+  while ((str < end) && (*str >= '0') && (*str <= '9')) {
+    if (v > (0xffffffffUL - 9) / 10) {
+      return NULL;
+    }
+    v = (v * 10) + (u32_t)(*str - '0');
+    str++;
+  }
+  *val = v;
+  return (str != start) ? str : NULL;
+}
+
+/** Check the request headers for a single byte range ("Range: bytes=").
+ * The range is ignored, and the whole file sent, if there are several or
+ * if the client sends If-Range: the file has no validator to compare.
+ *
+ * @param hs the connection state, range_req, range_first and range_last
+ *        are set
+ * @param hdrs the request header lines, starting with a CRLF
+ * @param hdrs_len length of the header lines
+ */
+static void
+http_parse_range(struct http_state *hs, const char *hdrs, u16_t hdrs_len)
+{
+  const char *end = hdrs + hdrs_len;
+  const char *val;
+  const char *eol;
+  u32_t first, last = 0xffffffffUL;
+  u8_t kind = HTTP_RANGE_FROM;
+
+  val = strnstr(hdrs, CRLF "Range:", hdrs_len);
+  if (val == NULL) {
+    val = strnstr(hdrs, CRLF "range:", hdrs_len);
+  }
+  if ((val == NULL) || (strnstr(hdrs, CRLF "If-Range:", hdrs_len) != NULL) ||
+      (strnstr(hdrs, CRLF "if-range:", hdrs_len) != NULL)) {
+    return;
+  }
+  val += 8;
+  eol = strnstr(val, CRLF, end - val);
+  if (eol == NULL) {
+    eol = end;
+  }
+  while ((val < eol) && (*val == ' ')) {
+    val++;
+  }
+  if ((eol - val < 6) || strncmp(val, "bytes=", 6)) {
+    return;
+  }
+  val += 6;
+  if ((val < eol) && (*val == '-')) {
+    kind = HTTP_RANGE_SUFFIX;
+    val = http_parse_u32(val + 1, eol, &first);
+  } else {
+    val = http_parse_u32(val, eol, &first);
+    if ((val == NULL) || (val >= eol) || (*val != '-')) {
+      return;
+    }
+    val++;
+    if ((val < eol) && (*val >= '0') && (*val <= '9')) {
+      val = http_parse_u32(val, eol, &last);
+      if ((val != NULL) && (last < first)) {
+        return;
+      }
+    }
+  }
+  if (val == NULL) {
+    return;
+  }
+  while ((val < eol) && (*val == ' ')) {
+    val++;
+  }
+  if (val != eol) {
+    /* a list of ranges */
+    return;
+  }
+  hs->range_req = kind;
+  hs->range_first = first;
+  hs->range_last = last;
+}
+
+/** Append to the header of a partial response.
+ *
+ * @param out the header buffer of LWIP_HTTPD_RANGE_HDR_LEN bytes
+ * @param pos current length of the header, negative if it did not fit
+ * @param str string to append
+ * @param len length of str
+ * @return the new length, negative if it did not fit
+ */
+static int
+http_range_append(char *out, int pos, const char *str, int len)
+{
+  if ((pos < 0) || (pos + len >= LWIP_HTTPD_RANGE_HDR_LEN)) {
+    return -1;
+  }
+  MEMCPY(&out[pos], str, len);
+  return pos + len;
+}
+
+/** Append a decimal number to the header of a partial response.
+ *
+ * @param out the header buffer
+ * @param pos current length of the header, negative if it did not fit
+ * @param val the number
+ * @return the new length, negative if it did not fit
+ */
+static int
+http_range_append_u32(char *out, int pos, u32_t val)
+{
+  char digits[10];
+  int i = sizeof(digits);
+
+  do {
+    digits[--i] = (char)('0' + (val % 10));
+    val /= 10;
+  } while (val != 0);
+  return http_range_append(out, pos, &digits[i], sizeof(digits) - i);
+}
+
+/** Set up the partial response to the range requested. The status line
+ * of the file header becomes "206 Partial Content" with a Content-Range
+ * and the Content-Length of the range; a range that starts past the end
+ * of the file gets "416 Requested Range Not Satisfiable" and no data.
+ * If the range can't be served, nothing is changed and the whole file is
+ * sent.
+ *
+ * @param hs http connection state, hs->file points to the file header
+ */
+static void
+http_init_range(struct http_state *hs)
+{
+  const char *hdr = hs->file;
+  const char *hdr_end;
+  const char *line;
+  const char *eol;
+  char *out;
+  u32_t total, first, last, hdr_len, avail;
+  u8_t satisfiable;
+  int pos, ver_len;
+
+  hdr_end = strnstr(hdr, CRLF CRLF, hs->left);
+  if (hdr_end == NULL) {
+    return;
+  }
+  hdr_len = (u32_t)(hdr_end + 4 - hdr);
+  eol = strnstr(hdr, CRLF, hdr_len);
+  line = strnstr(hdr, " ", eol - hdr);
+  if ((line == NULL) || strncmp(line, " 200 ", 5)) {
+    /* only the whole file can be split */
+    return;
+  }
+  ver_len = (int)(line - hdr);
+  line = strnstr(hdr, CRLF "Content-Length: ", hdr_len);
+  if ((line == NULL) || (http_parse_u32(line + 18, hdr_end, &total) == NULL)) {
+    return;
+  }
+
+  if (hs->range_req == HTTP_RANGE_SUFFIX) {
+    first = (hs->range_first < total) ? total - hs->range_first : 0;
+    satisfiable = (hs->range_first != 0) && (total != 0);
+  } else {
+    first = hs->range_first;
+    satisfiable = first < total;
+  }
+  last = satisfiable ? LWIP_MIN(hs->range_last, total - 1) : 0;
+  /* file data that is in memory behind the header */
+  avail = hs->left - hdr_len;
+
+  out = (char*)mem_malloc(LWIP_HTTPD_RANGE_HDR_LEN);
+  if (out == NULL) {
+    return;
+  }
+  /* the status line keeps the protocol version */
+  pos = http_range_append(out, 0, hdr, ver_len);
+  if (satisfiable) {
+    pos = http_range_append(out, pos, " 206 Partial Content" CRLF, 22);
+  } else {
+    pos = http_range_append(out, pos, " 416 Requested Range Not Satisfiable" CRLF, 38);
+  }
+  /* then the header lines of the file, except its Content-Length */
+  for (line = eol + 2; line < hdr_end + 2; line = eol + 2) {
+    eol = strnstr(line, CRLF, hdr_end + 2 - line);
+    if (strncmp(line, "Content-Length: ", 16)) {
+      pos = http_range_append(out, pos, line, eol + 2 - line);
+    }
+  }
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  if (hs->conn_hdr != NULL) {
+    pos = http_range_append(out, pos, hs->conn_hdr, strlen(hs->conn_hdr));
+  }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+  pos = http_range_append(out, pos, "Content-Range: bytes ", 21);
+  if (satisfiable) {
+    pos = http_range_append_u32(out, pos, first);
+    pos = http_range_append(out, pos, "-", 1);
+    pos = http_range_append_u32(out, pos, last);
+  } else {
+    pos = http_range_append(out, pos, "*", 1);
+  }
+  pos = http_range_append(out, pos, "/", 1);
+  pos = http_range_append_u32(out, pos, total);
+  pos = http_range_append(out, pos, CRLF "Content-Length: ", 18);
+  pos = http_range_append_u32(out, pos, satisfiable ? last - first + 1 : 0);
+  pos = http_range_append(out, pos, CRLF CRLF, 4);
+  if ((pos < 0) ||
+      (satisfiable && (first >= avail) && fs_seek(hs->handle, first))) {
+    LWIP_DEBUGF(HTTPD_DEBUG, ("Range not served\n"));
+    mem_free(out);
+    return;
+  }
+  out[pos] = 0;
+
+  /* The new header replaces the one of the file */
+  hs->range_hdr = out;
+  hs->hdrs[NUM_FILE_HDR_STRINGS - 1] = out;
+  hs->hdr_index = NUM_FILE_HDR_STRINGS - 1;
+  hs->hdr_pos = 0;
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  hs->conn_hdr = NULL;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+  if (satisfiable && (first < avail)) {
+    /* send from memory */
+    hs->file += hdr_len + first;
+    hs->left = LWIP_MIN(avail - first, last - first + 1);
+  } else {
+    hs->file += hs->left;
+    hs->left = 0;
+  }
+  hs->range_left = satisfiable ? (last - first + 1) - hs->left : 0;
+#if LWIP_HTTPD_READAHEAD
+  hs->read_off = first;
+#endif /* LWIP_HTTPD_READAHEAD */
+#if LWIP_HTTPD_STATS
+  if (satisfiable) {
+    httpd_stats.ranges++;
+  }
+#endif /* LWIP_HTTPD_STATS */
+}
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+/** Remove the request that has been served from the front of the request
+ * queue, keeping any request pipelined behind it.
+ *
+ * @param p the request queue
+ * @param len number of bytes to remove
+ * @return the remaining queue, NULL if empty
+ */
+static struct pbuf *
+http_req_consume(struct pbuf *p, u16_t len)
+{
+  struct pbuf *q;
+
+  while ((p != NULL) && (len >= p->len)) {
+    len -= p->len;
+    q = p->next;
+    if (q != NULL) {
+      /* keep the rest of the chain when freeing its head */
+      pbuf_ref(q);
+    }
+    pbuf_free(p);
+    p = q;
+  }
+  if ((p != NULL) && (len > 0)) {
+    pbuf_header(p, -(s16_t)len);
+  }
+  return p;
+}
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+
+#if LWIP_HTTPD_SUPPORT_REQUESTLIST
+/** Free the request queue once a request has been parsed. With keep-alive,
+ * only the parsed request is freed, pipelined requests are kept.
+ *
+ * @param hs the connection state
+ * @param parsed return value of http_parse_request
+ */
+static void
+http_req_done(struct http_state *hs, err_t parsed)
+{
+  if ((parsed != ERR_INPROGRESS) && (hs->req != NULL)) {
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    if (hs->keepalive) {
+      hs->req = http_req_consume(hs->req, hs->req_len);
+    } else
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+    {
+      pbuf_free(hs->req);
+      hs->req = NULL;
+    }
+  }
+}
+#endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
+
 /**
  * When data has been received in the correct state, try to parse it
  * as a HTTP request.
@@ -1573,6 +2585,9 @@ http_parse_request(struct pbuf **inp, struct http_state *hs, struct tcp_pcb *pcb
   char *crlf;
   u16_t data_len;
   struct pbuf *p = *inp;
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  char *hdr_end;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
 #if LWIP_HTTPD_SUPPORT_REQUESTLIST
   u16_t clen;
 #endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
@@ -1581,8 +2596,20 @@ http_parse_request(struct pbuf **inp, struct http_state *hs, struct tcp_pcb *pcb
 #endif /* LWIP_HTTPD_SUPPORT_POST */
 
   LWIP_UNUSED_ARG(pcb); /* only used for post */
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  /* p is NULL when parsing a request already queued in hs->req */
+  LWIP_ASSERT("p != NULL", (p != NULL) || (hs->req != NULL));
+  hs->keepalive = 0;
+#else /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
   LWIP_ASSERT("p != NULL", p != NULL);
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
   LWIP_ASSERT("hs != NULL", hs != NULL);
+#if LWIP_HTTPD_SUPPORT_GZIP
+  hs->accept_gzip = 0;
+#endif /* LWIP_HTTPD_SUPPORT_GZIP */
+#if LWIP_HTTPD_SUPPORT_RANGE
+  hs->range_req = HTTP_RANGE_NONE;
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
 
   if ((hs->handle != NULL) || (hs->file != NULL)) {
     LWIP_DEBUGF(HTTPD_DEBUG, ("Received data while sending a file\n"));
@@ -1593,15 +2620,18 @@ http_parse_request(struct pbuf **inp, struct http_state *hs, struct tcp_pcb *pcb
 
 #if LWIP_HTTPD_SUPPORT_REQUESTLIST
 
-  LWIP_DEBUGF(HTTPD_DEBUG, ("Received %"U16_F" bytes\n", p->tot_len));
-
   /* first check allowed characters in this pbuf? */
 
   /* enqueue the pbuf */
-  if (hs->req == NULL) {
+  if (p == NULL) {
+    LWIP_DEBUGF(HTTPD_DEBUG, ("Parsing queued request\n"));
+    p = hs->req;
+  } else if (hs->req == NULL) {
+    LWIP_DEBUGF(HTTPD_DEBUG, ("Received %"U16_F" bytes\n", p->tot_len));
     LWIP_DEBUGF(HTTPD_DEBUG, ("First pbuf\n"));
     hs->req = p;
   } else {
+    LWIP_DEBUGF(HTTPD_DEBUG, ("Received %"U16_F" bytes\n", p->tot_len));
     LWIP_DEBUGF(HTTPD_DEBUG, ("pbuf enqueued\n"));
     pbuf_cat(hs->req, p);
   }
@@ -1624,6 +2654,21 @@ http_parse_request(struct pbuf **inp, struct http_state *hs, struct tcp_pcb *pcb
   if (data_len >= MIN_REQ_LEN) {
     /* wait for CRLF before parsing anything */
     crlf = strnstr(data, CRLF, data_len);
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    hdr_end = NULL;
+    if ((crlf != NULL) && (strnstr(data, " HTTP/1.", crlf - data) != NULL)) {
+      /* HTTP/1.x: wait for the end of the header lines, a request pipelined
+         behind this one starts after them */
+      hdr_end = strnstr(crlf, CRLF CRLF, data_len - (crlf - data));
+      if (hdr_end == NULL) {
+        crlf = NULL;
+      } else {
+        hs->req_len = (u16_t)(hdr_end + 4 - data);
+      }
+    } else if (crlf != NULL) {
+      hs->req_len = (u16_t)(crlf + 2 - data);
+    }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
     if (crlf != NULL) {
 #if LWIP_HTTPD_SUPPORT_POST
       int is_post = 0;
@@ -1698,6 +2743,33 @@ http_parse_request(struct pbuf **inp, struct http_state *hs, struct tcp_pcb *pcb
         } else
 #endif /* LWIP_HTTPD_SUPPORT_POST */
         {
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+          if (hdr_end != NULL) {
+            hs->keepalive = http_want_keepalive(hs, sp2 + 1, crlf, (u16_t)(hdr_end - crlf));
+          }
+          if (hs->keepalive) {
+            /* No FIN pushes out the last (short) segment of a response on a
+               persistent connection: with Nagle it would wait for the
+               client's delayed ACK of the previous segment (~40ms). */
+            tcp_nagle_disable(pcb);
+          }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_SUPPORT_GZIP || LWIP_HTTPD_SUPPORT_RANGE
+          if (!is_09) {
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+            /* don't look into a request pipelined behind this one */
+            u16_t hdrs_len = (u16_t)((hdr_end != NULL ? hdr_end + 2 : data + data_len) - crlf);
+#else /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+            u16_t hdrs_len = (u16_t)(data_len - (crlf - data));
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_SUPPORT_GZIP
+            hs->accept_gzip = http_accepts_gzip(crlf, hdrs_len);
+#endif /* LWIP_HTTPD_SUPPORT_GZIP */
+#if LWIP_HTTPD_SUPPORT_RANGE
+            http_parse_range(hs, crlf, hdrs_len);
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
+          }
+#endif /* LWIP_HTTPD_SUPPORT_GZIP || LWIP_HTTPD_SUPPORT_RANGE */
           return http_find_file(hs, uri, is_09);
         }
       } else {
@@ -1758,7 +2830,7 @@ http_find_file(struct http_state *hs, const char *uri, int is_09)
        that exists. */
     for (loop = 0; loop < NUM_DEFAULT_FILENAMES; loop++) {
       LWIP_DEBUGF(HTTPD_DEBUG | LWIP_DBG_TRACE, ("Looking for %s...\n", g_psDefaultFilenames[loop].name));
-      file = fs_open((char *)g_psDefaultFilenames[loop].name);
+      file = http_fs_open(hs, g_psDefaultFilenames[loop].name);
       uri = (char *)g_psDefaultFilenames[loop].name;
       if(file != NULL) {
         LWIP_DEBUGF(HTTPD_DEBUG | LWIP_DBG_TRACE, ("Opened.\n"));
@@ -1808,7 +2880,7 @@ http_find_file(struct http_state *hs, const char *uri, int is_09)
 
     LWIP_DEBUGF(HTTPD_DEBUG | LWIP_DBG_TRACE, ("Opening %s\n", uri));
 
-    file = fs_open(uri);
+    file = http_fs_open(hs, uri);
     if (file == NULL) {
       file = http_get_404_file(&uri);
     }
@@ -1844,6 +2916,9 @@ http_find_file(struct http_state *hs, const char *uri, int is_09)
 static err_t
 http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const char *uri)
 {
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+  hs->idle = 0;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
   if (file != NULL) {
     /* file opened, initialise struct http_state */
 #if LWIP_HTTPD_SSI
@@ -1855,6 +2930,9 @@ http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const cha
 #endif /* LWIP_HTTPD_SSI */
     hs->handle = file;
     hs->file = (char*)file->data;
+#if LWIP_HTTPD_STATS
+    httpd_stats.requests++;
+#endif /* LWIP_HTTPD_STATS */
     LWIP_ASSERT("File length must be positive!", (file->len >= 0));
     hs->left = file->index;
     hs->retries = 0;
@@ -1876,11 +2954,43 @@ http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const cha
       }
     }
 #endif /* LWIP_HTTPD_SUPPORT_V09*/
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    hs->conn_hdr = NULL;
+    if (hs->handle->http_header_included && !is_09) {
+      /* The Connection header is inserted before the final CRLF of the
+         file header. Without a Content-Length, the client can only find
+         the end of the response by the connection closing. */
+      const char *hdr_end = strnstr(hs->file, CRLF CRLF, hs->left);
+      if ((hdr_end == NULL) ||
+          (strnstr(hs->file, "Content-Length: ", hdr_end - hs->file) == NULL)) {
+        hs->keepalive = 0;
+      }
+      if (hdr_end != NULL) {
+        hs->hdr_tail = hdr_end + 2;
+        hs->conn_hdr = g_psHTTPHeaderStrings[hs->keepalive ?
+          HTTP_HDR_CONN_KEEPALIVE : HTTP_HDR_CONN_CLOSE];
+      }
+    } else {
+      hs->keepalive = 0;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_SUPPORT_RANGE
+    if ((hs->range_req != HTTP_RANGE_NONE) && hs->handle->http_header_included &&
+#if LWIP_HTTPD_SSI
+        !hs->tag_check &&
+#endif /* LWIP_HTTPD_SSI */
+        !is_09) {
+      http_init_range(hs);
+    }
+#endif /* LWIP_HTTPD_SUPPORT_RANGE */
   } else {
     hs->handle = NULL;
     hs->file = NULL;
     hs->left = 0;
     hs->retries = 0;
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    hs->keepalive = 0;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
   }
 #if LWIP_HTTPD_DYNAMIC_HEADERS
     /* Determine the HTTP headers to send based on the file extension of
@@ -1964,6 +3074,16 @@ http_poll(void *arg, struct tcp_pcb *pcb)
     return ERR_OK;
   } else {
     hs->retries++;
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    if (hs->idle) {
+      /* Persistent connection waiting for its next request */
+      if (hs->retries >= HTTPD_KEEPALIVE_TIMEOUT) {
+        LWIP_DEBUGF(HTTPD_DEBUG, ("http_poll: keep-alive timeout, close\n"));
+        http_close_conn(pcb, hs);
+      }
+      return ERR_OK;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
     if (hs->retries == HTTPD_MAX_RETRIES) {
       LWIP_DEBUGF(HTTPD_DEBUG, ("http_poll: too many retries, close\n"));
       http_close_conn(pcb, hs);
@@ -2042,17 +3162,35 @@ http_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
       parsed = http_parse_request(&p, hs, pcb);
       LWIP_ASSERT("http_parse_request: unexpected return value", parsed == ERR_OK
         || parsed == ERR_INPROGRESS ||parsed == ERR_ARG || parsed == ERR_USE);
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    } else if (hs->keepalive) {
+      /* A pipelined request, it is parsed once the response is sent */
+      if ((hs->req != NULL) &&
+          ((hs->req->tot_len + p->tot_len > LWIP_HTTPD_REQ_BUFSIZE) ||
+           (pbuf_clen(hs->req) + pbuf_clen(p) > LWIP_HTTPD_REQ_QUEUELEN))) {
+        LWIP_DEBUGF(HTTPD_DEBUG, ("http_recv: too many pipelined requests, close\n"));
+        pbuf_free(p);
+        http_close_conn(pcb, hs);
+        return ERR_OK;
+      }
+      LWIP_DEBUGF(HTTPD_DEBUG, ("http_recv: queueing pipelined request\n"));
+      if (hs->req == NULL) {
+        hs->req = p;
+      } else {
+        pbuf_cat(hs->req, p);
+      }
+      return ERR_OK;
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
     } else {
       LWIP_DEBUGF(HTTPD_DEBUG, ("http_recv: already sending data\n"));
-    }
 #if LWIP_HTTPD_SUPPORT_REQUESTLIST
-    if (parsed != ERR_INPROGRESS) {
-      /* request fully parsed or error */
-      if (hs->req != NULL) {
-        pbuf_free(hs->req);
-        hs->req = NULL;
-      }
+      /* not queued, free it now */
+      pbuf_free(p);
+#endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
     }
+#if LWIP_HTTPD_SUPPORT_REQUESTLIST
+    /* request fully parsed or error */
+    http_req_done(hs, parsed);
 #else /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
     if (p != NULL) {
       /* pbuf not passed to application, free it now */
@@ -2150,6 +3288,19 @@ httpd_init(void)
   httpd_init_addr(IP_ADDR_ANY);
 }
 
+#if LWIP_HTTPD_STATS
+/**
+ * Copy the file send counters.
+ *
+ * @param stats receives the counters
+ */
+void
+httpd_get_stats(struct httpd_stats *stats)
+{
+  *stats = httpd_stats;
+}
+#endif /* LWIP_HTTPD_STATS */
+
 #if LWIP_HTTPD_SSI
 /**
  * Set the SSI handler function.
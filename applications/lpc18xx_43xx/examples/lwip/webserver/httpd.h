@@ -233,4 +233,37 @@ void httpd_post_data_recved(void *connection, u16_t recved_len);
 
 void httpd_init(void);
 
+/** Set this to 1 to read files through two buffers per connection: while
+ * TCP sends one, httpd_read_ahead() reads the next block of the file into
+ * the other, so it is ready when the client acknowledges the data.
+ */
+#ifndef LWIP_HTTPD_READAHEAD
+#define LWIP_HTTPD_READAHEAD      0
+#endif
+
+#if LWIP_HTTPD_READAHEAD
+/** Read ahead the files of the connections that sent data. Call from the
+ * main loop after the received packets have been processed, the file is
+ * then read while the interface sends the segments queued for it. */
+void httpd_read_ahead(void);
+#endif /* LWIP_HTTPD_READAHEAD */
+
+/** Set this to 1 to count the files served and how their data was sent */
+#ifndef LWIP_HTTPD_STATS
+#define LWIP_HTTPD_STATS          0
+#endif
+
+#if LWIP_HTTPD_STATS
+struct httpd_stats {
+  u32_t requests;      /* Files opened for a request */
+  u32_t bytes_ref;     /* File bytes sent by reference (not copied) */
+  u32_t bytes_copied;  /* File bytes copied into the TCP send buffer */
+  u32_t gzip;          /* Precompressed files served for a request */
+  u32_t ranges;        /* Partial (206) responses to a Range request */
+  u32_t readahead;     /* File blocks that were read ahead when needed */
+};
+
+void httpd_get_stats(struct httpd_stats *stats);
+#endif /* LWIP_HTTPD_STATS */
+
 #endif /* __HTTPD_H__ */
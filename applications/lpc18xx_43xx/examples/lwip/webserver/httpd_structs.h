@@ -56,7 +56,10 @@ static const char * const g_psHTTPHeaderStrings[] =
  "Connection: Close\r\n",
  "Connection: keep-alive\r\n",
  "Server: "HTTPD_SERVER_AGENT"\r\n",
- "\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n"
+ "\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n",
+ "Content-type: application/json\r\nCache-Control: no-cache\r\n\r\n",
+ "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n",
+ "Content-type: application/gzip\r\n\r\n"
 };
 
 /* Indexes into the g_psHTTPHeaderStrings array */
@@ -87,6 +90,9 @@ static const char * const g_psHTTPHeaderStrings[] =
 #define HTTP_HDR_CONN_KEEPALIVE 24 /* Connection: keep-alive (HTTP 1.1) */
 #define HTTP_HDR_SERVER         25 /* Server: HTTPD_SERVER_AGENT */
 #define DEFAULT_404_HTML        26 /* default 404 body */
+#define HTTP_HDR_JSON           27 /* application/json, not cached */
+#define HTTP_HDR_GZIP           28 /* Content-Encoding: gzip */
+#define HTTP_HDR_GZ             29 /* application/gzip */
 
 /** A list of extension-to-HTTP header strings */
 const static tHTTPHeader g_psHTTPHeaders[] =
@@ -108,7 +114,9 @@ const static tHTTPHeader g_psHTTPHeaders[] =
  { "css",  HTTP_HDR_CSS},
  { "swf",  HTTP_HDR_SWF},
  { "xml",  HTTP_HDR_XML},
- { "xsl",  HTTP_HDR_XML}
+ { "xsl",  HTTP_HDR_XML},
+ { "json", HTTP_HDR_JSON},
+ { "gz",   HTTP_HDR_GZ}
 };
 
 #define NUM_HTTP_HEADERS (sizeof(g_psHTTPHeaders) / sizeof(tHTTPHeader))
@@ -35,10 +35,14 @@
 
 #include "lwip/mem.h"
 #include "lwip/memp.h"
+#include "lwip/sys.h"
+#if LWIP_FS_CACHE
+#include "lwip/tcp_impl.h"
+#endif
 #include "board.h"
 #include "ff.h"
 #include "lwip_fs.h"
-#include "httpd_structs.h"
+#include "net_stats.h"
 
 /**
  * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_FS
@@ -52,6 +56,9 @@
 #define SECTOR_SZ  512
 #endif
 
+/* Room left for the HTTP header in front of the statistics document */
+#define STATS_HDR_SZ 192
+
 /* Default html file */
 const static char http_index_html[] =
 	"<html><head><title>Congrats!</title></head>"
@@ -70,6 +77,34 @@ struct file_ds {
 };
 static volatile int32_t sdio_wait_exit = 0;
 
+#if LWIP_FS_CACHE
+/* A cached file, its header and data are at cache_mem[off] */
+struct fs_cache_entry {
+	char name[LWIP_FS_CACHE_NAME_LEN + 1];
+	u32_t off;
+	u32_t len;			/* Header and data bytes */
+	DWORD fsize;		/* File size and time when cached */
+	WORD fdate;
+	WORD ftime;
+	u32_t checked;		/* sys_now() of the last revalidation */
+	u32_t last_use;		/* cache_clock of the last hit */
+	u16_t refs;			/* Open fs_files of this entry */
+	u8_t used;			/* Holds cache memory */
+	u8_t valid;			/* Matches the file on the card */
+};
+
+#ifdef LWIP_FS_CACHE_BASE
+static u8_t *const cache_mem = (u8_t *) LWIP_FS_CACHE_BASE;
+#else
+static u32_t cache_mem_buf[LWIP_FS_CACHE_SIZE / 4];
+#define cache_mem ((u8_t *) cache_mem_buf)
+#endif
+
+static struct fs_cache_entry cache[LWIP_FS_CACHE_ENTRIES];
+static u32_t cache_clock;
+static struct fs_cache_stats cache_stats;
+#endif /* LWIP_FS_CACHE */
+
 /*****************************************************************************
  * Public types/enumerations/variables
  ****************************************************************************/
@@ -170,83 +205,6 @@ static void mutex_unlock(int *mx)
 
 #endif
 
-/**
- * Generate the relevant HTTP headers for the given filename and write
- * them into the supplied buffer.
- */
-static int
-get_http_headers(const char *fName, char *buff)
-{
-	unsigned int iLoop;
-	const char *pszExt = NULL;
-	const char *hdrs[4];
-
-	/* Ensure that we initialize the loop counter. */
-	iLoop = 0;
-
-	/* In all cases, the second header we send is the server identification
-	   so set it here. */
-	hdrs[1] = g_psHTTPHeaderStrings[HTTP_HDR_SERVER];
-
-	/* Is this a normal file or the special case we use to send back the
-	   default "404: Page not found" response? */
-	if (( fName == NULL) || ( *fName == 0) ) {
-		hdrs[0] = g_psHTTPHeaderStrings[HTTP_HDR_NOT_FOUND];
-		hdrs[2] = g_psHTTPHeaderStrings[DEFAULT_404_HTML];
-		goto end_fn;
-	}
-	/* We are dealing with a particular filename. Look for one other
-	    special case.  We assume that any filename with "404" in it must be
-	    indicative of a 404 server error whereas all other files require
-	    the 200 OK header. */
-	if (strstr(fName, "404")) {
-		iLoop = HTTP_HDR_NOT_FOUND;
-	}
-	else if (strstr(fName, "400")) {
-		iLoop = HTTP_HDR_BAD_REQUEST;
-	}
-	else if (strstr(fName, "501")) {
-		iLoop = HTTP_HDR_NOT_IMPL;
-	}
-	else {
-		iLoop = HTTP_HDR_OK;
-	}
-	hdrs[0] = g_psHTTPHeaderStrings[iLoop];
-
-	/* Get a pointer to the file extension.  We find this by looking for the
-	     last occurrence of "." in the filename passed. */
-	pszExt = strrchr(fName, '.');
-
-	/* Does the FileName passed have any file extension?  If not, we assume it
-	     is a special-case URL used for control state notification and we do
-	     not send any HTTP headers with the response. */
-	if (pszExt == NULL) {
-		return 0;
-	}
-
-	pszExt++;
-	/* Now determine the content type and add the relevant header for that. */
-	for (iLoop = 0; (iLoop < NUM_HTTP_HEADERS); iLoop++)
-		/* Have we found a matching extension? */
-		if (!strcmp(g_psHTTPHeaders[iLoop].extension, pszExt)) {
-			hdrs[2] =
-				g_psHTTPHeaderStrings[g_psHTTPHeaders[iLoop].headerIndex];
-			break;
-		}
-
-	/* Did we find a matching extension? */
-	if (iLoop == NUM_HTTP_HEADERS) {
-		/* No - use the default, plain text file type. */
-		hdrs[2] = g_psHTTPHeaderStrings[HTTP_HDR_DEFAULT_TYPE];
-	}
-
-end_fn:
-	iLoop = strlen(hdrs[0]);
-	strcpy(buff, hdrs[0]);
-	strcat(buff, hdrs[1]);
-	strcat(buff, hdrs[2]);
-	return strlen(buff);
-}
 /* Delay callback for timed SDIF/SDMMC functions */
 static void sdmmc_waitms(uint32_t time)
 {
@@ -323,9 +281,18 @@ static void App_SDMMC_Init()
 /* Read http header information into a string */
 int GetHTTP_Header(const char *fName, char *buff)
 {
-	return get_http_headers(fName, buff);
+	return fs_get_http_headers(fName, buff, -1);
 }
 
+#if LWIP_FS_CACHE
+/* Get the file cache counters */
+void fs_cache_get_stats(struct fs_cache_stats *stats)
+{
+	*stats = cache_stats;
+}
+
+#endif
+
 /* Initialize the file system */
 int fs_init(void)
 {
@@ -363,7 +330,7 @@ struct fs_file *fs_open_default(void) {
 	memset(fds, 0, sizeof(*fds));
 	fs = &fds->fs;
 	fs->pextension = (void *) fds;	/* Store this for later use */
-	hlen = get_http_headers("default.htm", (char *) fds->scratch);
+	hlen = fs_get_http_headers("default.htm", (char *) fds->scratch, sizeof(http_index_html) - 1);
 	fs->data = (const char *) fds->scratch;
 	memcpy((void *) &fs->data[hlen], (void *) http_index_html, sizeof(http_index_html) - 1);
 	fs->len = hlen + sizeof(http_index_html) - 1;
@@ -372,6 +339,352 @@ struct fs_file *fs_open_default(void) {
 	return fs;
 }
 
+/* Opens the statistics document, generated at open time */
+static struct fs_file *fs_open_stats(const char *name) {
+	int hlen, jlen;
+	struct file_ds *fds;
+	struct fs_file *fs;
+	char *data;
+
+	/* The document is built after the file descriptor */
+	fds = (struct file_ds *)mem_malloc(sizeof(*fds) + NET_STATS_JSON_SZ);
+	if (fds == NULL) {
+		DEBUGSTR("Malloc Failure, Out of Memory!\r\n");
+		return NULL;
+	}
+	memset(fds, 0, sizeof(*fds));
+	fs = &fds->fs;
+	fs->pextension = (void *) fds;	/* Store this for later use */
+	data = (char *) (fds + 1);
+
+	/* The document goes after the largest header, then the header with
+	   its length is put in front of it */
+	jlen = NetStats_GetJSON(&data[STATS_HDR_SZ], NET_STATS_JSON_SZ - STATS_HDR_SZ);
+	if (jlen < 0) {
+		LWIP_DEBUGF(HTTPD_DEBUG, ("DFS: STATS: NET_STATS_JSON_SZ too small\r\n"));
+		mem_free(fds);
+		return NULL;
+	}
+	hlen = fs_get_http_headers(name, (char *) fds->scratch, jlen);
+	memmove(&data[hlen], &data[STATS_HDR_SZ], jlen);
+	memcpy(data, fds->scratch, hlen);
+	fs->data = (const char *) data;
+	fs->len = hlen + jlen;
+	fs->index = fs->len;
+	fs->http_header_included = 1;
+	return fs;
+}
+
+#if LWIP_FS_ROM_IMAGE
+/* Finds a file of the ROM image */
+static const struct fsdata_file *fs_find_rom(const char *name) {
+	int lo, hi, mid, cmp;
+
+	/* The image is sorted by name */
+	lo = 0;
+	hi = fsdata_rom_numfiles - 1;
+	while (lo <= hi) {
+		mid = (lo + hi) / 2;
+		cmp = strcmp(name, fsdata_rom_files[mid].name);
+		if (cmp == 0) {
+			return &fsdata_rom_files[mid];
+		}
+		if (cmp < 0) {
+			hi = mid - 1;
+		}
+		else {
+			lo = mid + 1;
+		}
+	}
+	return NULL;
+}
+
+/* Opens a file of the ROM image, its data is sent in place */
+static struct fs_file *fs_open_rom(const char *name) {
+	const struct fsdata_file *f;
+	struct fs_file *fs;
+
+	f = fs_find_rom(name);
+	if (f == NULL) {
+		return NULL;
+	}
+
+	/* Only the descriptor is allocated, no scratch buffer */
+	fs = (struct fs_file *)mem_malloc(sizeof(*fs));
+	if (fs == NULL) {
+		DEBUGSTR("Malloc Failure, Out of Memory!\r\n");
+		return NULL;
+	}
+	memset(fs, 0, sizeof(*fs));
+	fs->data = (const char *) f->data;
+	fs->len = f->len;
+	fs->index = f->len;
+	fs->http_header_included = 1;
+	fs->is_static = 1;
+	return fs;
+}
+
+#endif
+
+/* Longest name that is checked for a variant, httpd's default
+   LWIP_HTTPD_MAX_GZIP_URI_LEN */
+#define FS_GZIP_NAME_LEN 63
+
+/* Builds the header of a card file. httpd may serve "<file>.<ext>.gz"
+   instead of it, so the header gets a Vary if that variant exists. On
+   the card such a name needs long file names. */
+static int fs_file_headers(const char *name, char *buff, long size)
+{
+	int hlen = fs_get_http_headers(name, buff, size);
+#if LWIP_HTTPD_SUPPORT_GZIP && (LWIP_FS_ROM_IMAGE || _USE_LFN)
+	const char *base = strrchr(name, '/');
+	char gzname[FS_GZIP_NAME_LEN + sizeof(".gz")];
+	int found = 0;
+#if _USE_LFN
+	FILINFO fno;
+#endif
+
+	if ((hlen <= 0) || (strchr((base != NULL) ? base : name, '.') == NULL) ||
+		(strlen(name) > FS_GZIP_NAME_LEN)) {
+		return hlen;
+	}
+	strcpy(gzname, name);
+	strcat(gzname, ".gz");
+#if LWIP_FS_ROM_IMAGE
+	found = (fs_find_rom(gzname) != NULL);
+#endif
+#if _USE_LFN
+	if (!found) {
+		fno.lfname = NULL;
+		fno.lfsize = 0;
+		found = (f_stat(gzname, &fno) == FR_OK);
+	}
+#endif
+	if (found) {
+		hlen = fs_add_vary_header(buff, hlen);
+	}
+#endif
+	return hlen;
+}
+
+#if LWIP_FS_CACHE
+/* Checks if TCP still holds segments that refer to an entry's memory.
+   Files are sent by reference, so the memory of an evicted or changed
+   file is only reused once all of its data has been acknowledged. */
+static int fs_cache_in_flight(const struct fs_cache_entry *e)
+{
+	const u8_t *start = &cache_mem[e->off];
+	const u8_t *end = start + e->len;
+	struct tcp_pcb *pcb;
+	struct tcp_seg *seg;
+	struct pbuf *q;
+	int queue;
+
+	for (pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next) {
+		for (queue = 0; queue < 2; queue++) {
+			for (seg = queue ? pcb->unacked : pcb->unsent; seg != NULL; seg = seg->next) {
+				for (q = seg->p; q != NULL; q = q->next) {
+					if (((const u8_t *) q->payload >= start) && ((const u8_t *) q->payload < end)) {
+						return 1;
+					}
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+/* Releases the memory of entries that are no longer valid or used */
+static void fs_cache_reclaim(void)
+{
+	int i;
+
+	for (i = 0; i < LWIP_FS_CACHE_ENTRIES; i++) {
+		if (cache[i].used && !cache[i].valid && (cache[i].refs == 0) &&
+			!fs_cache_in_flight(&cache[i])) {
+			cache[i].used = 0;
+			cache_stats.bytes_used -= cache[i].len;
+		}
+	}
+}
+
+/* Drops the least recently used file that is neither open nor being sent */
+static int fs_cache_evict(void)
+{
+	struct fs_cache_entry *lru = NULL;
+	int i;
+
+	for (i = 0; i < LWIP_FS_CACHE_ENTRIES; i++) {
+		if (cache[i].valid && (cache[i].refs == 0) &&
+			((lru == NULL) || ((s32_t) (cache[i].last_use - lru->last_use) < 0)) &&
+			!fs_cache_in_flight(&cache[i])) {
+			lru = &cache[i];
+		}
+	}
+	if (lru == NULL) {
+		return 0;
+	}
+	lru->valid = 0;
+	cache_stats.files--;
+	cache_stats.evictions++;
+	return 1;
+}
+
+/* Finds the smallest free block of cache memory that holds len bytes */
+static int fs_cache_alloc(u32_t len, u32_t *off)
+{
+	u32_t start, end, best = 0, best_len = 0;
+	int i, j;
+
+	/* Free blocks start at 0 or after a used entry */
+	for (i = -1; i < LWIP_FS_CACHE_ENTRIES; i++) {
+		if (i < 0) {
+			start = 0;
+		}
+		else if (cache[i].used) {
+			start = cache[i].off + ((cache[i].len + 3) & ~3);
+		}
+		else {
+			continue;
+		}
+		end = LWIP_FS_CACHE_SIZE;
+		for (j = 0; j < LWIP_FS_CACHE_ENTRIES; j++) {
+			if (cache[j].used && (cache[j].off >= start) && (cache[j].off < end)) {
+				end = cache[j].off;
+			}
+		}
+		if ((end > start) && ((end - start) >= len) &&
+			((best_len == 0) || ((end - start) < best_len))) {
+			best = start;
+			best_len = end - start;
+		}
+	}
+	*off = best;
+	return best_len != 0;
+}
+
+/* Opens a cached file, its data is sent in place */
+static struct fs_file *fs_cache_open(struct fs_cache_entry *e)
+{
+	struct fs_file *fs;
+
+	fs = (struct fs_file *)mem_malloc(sizeof(*fs));
+	if (fs == NULL) {
+		DEBUGSTR("Malloc Failure, Out of Memory!\r\n");
+		return NULL;
+	}
+	memset(fs, 0, sizeof(*fs));
+	fs->data = (const char *) &cache_mem[e->off];
+	fs->len = e->len;
+	fs->index = e->len;
+	fs->http_header_included = 1;
+	fs->is_static = 1;
+	fs->pextension = (void *) e;
+	e->refs++;
+	e->last_use = ++cache_clock;
+	return fs;
+}
+
+/* Looks up a file in the cache, a changed file is dropped */
+static struct fs_cache_entry *fs_cache_lookup(const char *name)
+{
+	struct fs_cache_entry *e = NULL;
+	FILINFO fno;
+	u32_t now;
+	int i;
+
+	for (i = 0; i < LWIP_FS_CACHE_ENTRIES; i++) {
+		if (cache[i].valid && (strcmp(cache[i].name, name) == 0)) {
+			e = &cache[i];
+			break;
+		}
+	}
+	if (e == NULL) {
+		return NULL;
+	}
+
+	now = sys_now();
+	if ((u32_t) (now - e->checked) >= LWIP_FS_CACHE_REVALIDATE_MS) {
+		if ((f_stat(name, &fno) != FR_OK) || (fno.fsize != e->fsize) ||
+			(fno.fdate != e->fdate) || (fno.ftime != e->ftime)) {
+			LWIP_DEBUGF(HTTPD_DEBUG, ("DFS: CACHE: %s changed\r\n", name));
+			e->valid = 0;
+			cache_stats.files--;
+			cache_stats.invalidations++;
+			return NULL;
+		}
+		e->checked = now;
+	}
+
+	cache_stats.hits++;
+	return e;
+}
+
+/* Reads an opened file into the cache. On success the file is closed,
+   otherwise it is left open at its start for reading it uncached. */
+static struct fs_cache_entry *fs_cache_add(const char *name, FIL *fi)
+{
+	struct fs_cache_entry *e = NULL;
+	FILINFO fno;
+	u32_t off, len;
+	UINT br;
+	int i, hlen;
+	char hdr[LWIP_FS_HDR_MAX_LEN];
+
+	hlen = fs_file_headers(name, hdr, f_size(fi));
+	len = hlen + f_size(fi);
+	if ((len > LWIP_FS_CACHE_MAX_FILE) || (len > LWIP_FS_CACHE_SIZE) ||
+		(strlen(name) > LWIP_FS_CACHE_NAME_LEN) || (f_stat(name, &fno) != FR_OK)) {
+		cache_stats.uncached++;
+		return NULL;
+	}
+
+	/* Find an entry and memory, replacing old files if needed */
+	fs_cache_reclaim();
+	for (;;) {
+		for (i = 0; (e == NULL) && (i < LWIP_FS_CACHE_ENTRIES); i++) {
+			if (!cache[i].used) {
+				e = &cache[i];
+			}
+		}
+		if ((e != NULL) && fs_cache_alloc(len, &off)) {
+			break;
+		}
+		if (!fs_cache_evict()) {
+			cache_stats.uncached++;
+			return NULL;
+		}
+		fs_cache_reclaim();
+	}
+
+	memcpy(&cache_mem[off], hdr, hlen);
+	if ((f_read(fi, &cache_mem[off + hlen], f_size(fi), &br) != FR_OK) ||
+		(br != f_size(fi))) {
+		LWIP_DEBUGF(HTTPD_DEBUG, ("DFS: CACHE: Read error on %s\r\n", name));
+		f_lseek(fi, 0);
+		cache_stats.uncached++;
+		return NULL;
+	}
+	f_close(fi);
+
+	strcpy(e->name, name);
+	e->off = off;
+	e->len = len;
+	e->fsize = fno.fsize;
+	e->fdate = fno.fdate;
+	e->ftime = fno.ftime;
+	e->checked = sys_now();
+	e->refs = 0;
+	e->used = 1;
+	e->valid = 1;
+	cache_stats.bytes_used += len;
+	cache_stats.files++;
+	cache_stats.misses++;
+	return e;
+}
+
+#endif /* LWIP_FS_CACHE */
+
 /* File open function */
 struct fs_file *fs_open(const char *name) {
 	FRESULT res;
@@ -381,11 +694,37 @@ struct fs_file *fs_open(const char *name) {
 
 	/* Too huge to keep in stack, must be protected with mutex */
 	static struct file_ds tmpds;
+#if LWIP_FS_CACHE
+	struct fs_cache_entry *centry;
+#endif
+
+	/* Statistics are not read from the file system */
+	if (strcmp(name, NET_STATS_URI) == 0) {
+		return fs_open_stats(name);
+	}
+
+#if LWIP_FS_ROM_IMAGE
+	fs = fs_open_rom(name);
+	if (fs != NULL) {
+		return fs;
+	}
+#endif
 
 	if (mutex_lock(&open_lock)) {
 		LWIP_DEBUGF(HTTPD_DEBUG, ("DFS: ERROR: Mutex Timeout!\r\n"));
 		return NULL;
 	}
+
+#if LWIP_FS_CACHE
+	/* Only cache misses go to the card */
+	centry = fs_cache_lookup(name);
+	if (centry != NULL) {
+		fs = fs_cache_open(centry);
+		mutex_unlock(&open_lock);
+		return fs;
+	}
+#endif
+
 	memset(&tmpds, 0, sizeof(tmpds));
 	fds = &tmpds;
 
@@ -396,6 +735,15 @@ struct fs_file *fs_open(const char *name) {
 		return NULL;
 	}
 
+#if LWIP_FS_CACHE
+	centry = fs_cache_add(name, &fds->fi);
+	if (centry != NULL) {
+		fs = fs_cache_open(centry);
+		mutex_unlock(&open_lock);
+		return fs;
+	}
+#endif
+
 	fds = (struct file_ds *)mem_malloc(sizeof(*fds));
  	if (fds == NULL) {
 		DEBUGSTR("Malloc Failure, Out of Memory!\r\n");
@@ -408,7 +756,7 @@ struct fs_file *fs_open(const char *name) {
 	fs = &fds->fs;
 	fds->fi_valid = 1;
 	fs->pextension = (void *) fds;	/* Store this for later use */
-	hlen = get_http_headers(name, (char *) fds->scratch);
+	hlen = fs_file_headers(name, (char *) fds->scratch, f_size(&fds->fi));
 	fs->data = (const char *) fds->scratch;
 	fs->index = hlen;
 	fs->len = f_size(&fds->fi) + hlen;
@@ -417,6 +765,26 @@ struct fs_file *fs_open(const char *name) {
 	return fs;
 }
 
+/* Open the precompressed variant of a file */
+struct fs_file *fs_open_gz(const char *name)
+{
+#if !_USE_LFN
+	const char *base = strrchr(name, '/');
+
+	/* Without long file names "<file>.<ext>.gz" is no valid 8.3 name, it
+	   can only be in the ROM image */
+	if (strchr((base != NULL) ? base : name, '.') != strrchr(name, '.')) {
+#if LWIP_FS_ROM_IMAGE
+		return fs_open_rom(name);
+#else
+		return NULL;
+#endif
+	}
+#endif
+
+	return fs_open(name);
+}
+
 /* File close function */
 void fs_close(struct fs_file *file)
 {
@@ -425,6 +793,19 @@ void fs_close(struct fs_file *file)
 	if(file == NULL)
 		return;
 
+	/* ROM image and cached files have no file descriptor */
+	if (file->is_static) {
+#if LWIP_FS_CACHE
+		/* The entry is replaced or released by fs_open, which like fs_close
+		   is only called by httpd */
+		if (file->pextension != NULL) {
+			((struct fs_cache_entry *) file->pextension)->refs--;
+		}
+#endif
+		mem_free(file);
+		return;
+	}
+
 	fds = (struct file_ds *) file->pextension;
 
 #if (!defined(BOARD_HITEX_EVA_1850) && !defined(BOARD_HITEX_EVA_4350))
@@ -446,6 +827,28 @@ int fs_read(struct fs_file *file, char *buffer, int count)
 	return i;
 }
 
+/* File seek function */
+int fs_seek(struct fs_file *file, u32_t offset)
+{
+	struct file_ds *fds;
+	DWORD fsize;
+
+	if (file->is_static) {
+		return 1;
+	}
+	fds = (struct file_ds *) file->pextension;
+	if (!fds->fi_valid) {
+		return 1;
+	}
+
+	fsize = f_size(&fds->fi);
+	if ((offset > fsize) || (f_lseek(&fds->fi, offset) != FR_OK)) {
+		return 1;
+	}
+	file->index = file->len - (int) (fsize - offset);
+	return 0;
+}
+
 /* Number of bytes left in the file */
 int fs_bytes_left(struct fs_file *file)
 {
@@ -75,6 +75,88 @@ struct fsdata_chksum {
 };
 #endif /* HTTPD_PRECALCULATED_CHECKSUM */
 
+/** LWIP_FS_ROM_IMAGE==1: serve the files of the image in fsdata_rom.c
+ * (generated by tools/makefsrom) before looking on the SD card. The
+ * image is const data, linked into (internal or SPIFI) flash, and its
+ * files are sent by reference instead of being copied. */
+#ifndef LWIP_FS_ROM_IMAGE
+#define LWIP_FS_ROM_IMAGE             0
+#endif
+
+#if LWIP_FS_ROM_IMAGE
+/** One file of the ROM image, headers included */
+struct fsdata_file {
+  const char *name;
+  const unsigned char *data;
+  int len;
+  int hdr_len;
+};
+
+/** Files of the ROM image, sorted by name */
+extern const struct fsdata_file fsdata_rom_files[];
+/** Number of files in fsdata_rom_files */
+extern const int fsdata_rom_numfiles;
+#endif /* LWIP_FS_ROM_IMAGE */
+
+/** LWIP_FS_CACHE==1: keep files read from the SD card in a RAM cache, so
+ * repeated requests are served without FatFs and sent by reference. The
+ * least recently used files are replaced when the cache is full, and a
+ * file is reloaded when its size or modification time has changed. */
+#ifndef LWIP_FS_CACHE
+#define LWIP_FS_CACHE                 0
+#endif
+
+#if LWIP_FS_CACHE
+/** Bytes of cache memory, HTTP headers included */
+#ifndef LWIP_FS_CACHE_SIZE
+#define LWIP_FS_CACHE_SIZE            (32 * 1024)
+#endif
+
+/** Define LWIP_FS_CACHE_BASE to the address of LWIP_FS_CACHE_SIZE bytes of
+ * memory for the cache, for example external SDRAM set up by the board
+ * EMC init. A static array is used if it is not defined. The Ethernet DMA
+ * must be able to read it (see LPC_CHECK_SLOWMEM). */
+/* #define LWIP_FS_CACHE_BASE         0x28000000 */
+
+/** Largest file that is cached, HTTP header included */
+#ifndef LWIP_FS_CACHE_MAX_FILE
+#define LWIP_FS_CACHE_MAX_FILE        (8 * 1024)
+#endif
+
+/** Maximum number of cached files */
+#ifndef LWIP_FS_CACHE_ENTRIES
+#define LWIP_FS_CACHE_ENTRIES         16
+#endif
+
+/** Longest name of a cached file */
+#ifndef LWIP_FS_CACHE_NAME_LEN
+#define LWIP_FS_CACHE_NAME_LEN        31
+#endif
+
+/** Milliseconds a cached file is served before its modification time is
+ * checked again with f_stat(), 0 checks on every request */
+#ifndef LWIP_FS_CACHE_REVALIDATE_MS
+#define LWIP_FS_CACHE_REVALIDATE_MS   2000
+#endif
+
+/** Counters returned by fs_cache_get_stats() */
+struct fs_cache_stats {
+  u32_t hits;          /* Files served from the cache */
+  u32_t misses;        /* Files read from the card into the cache */
+  u32_t uncached;      /* Files read from the card, too large or no room */
+  u32_t evictions;     /* Files replaced to make room */
+  u32_t invalidations; /* Files changed on the card since cached */
+  u32_t bytes_used;    /* Cache memory in use */
+  u32_t files;         /* Files in the cache */
+};
+#endif /* LWIP_FS_CACHE */
+
+/** Size of the buffer passed to fs_get_http_headers(), checked against the
+ * longest header of fs_headers_tab.h (generated by tools/makehdrtab) */
+#ifndef LWIP_FS_HDR_MAX_LEN
+#define LWIP_FS_HDR_MAX_LEN           256
+#endif
+
 struct fs_file {
   const char *data;
   int len;
@@ -85,6 +167,9 @@ struct fs_file {
   u16_t chksum_count;
 #endif /* HTTPD_PRECALCULATED_CHECKSUM */
   u8_t http_header_included;
+  /** data stays valid after fs_close() while TCP segments refer to it,
+   * and may be sent by reference (ROM image, cache) */
+  u8_t is_static;
 #if LWIP_HTTPD_CUSTOM_FILES
   u8_t is_custom_file;
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
@@ -104,6 +189,42 @@ struct fs_file {
  */
 int GetHTTP_Header(const char *fName, char *buff);
 
+/**
+ * @brief	Build the HTTP response header of a file
+ * @param fName	:   Filename for which the header be generated, NULL or ""
+ *                  for the default 404 response
+ * @param buff	:   buffer of LWIP_FS_HDR_MAX_LEN bytes for the header
+ * @param size	:   Content-Length to send, none if negative
+ * @return Number of bytes in header
+ * @note
+ * The header is copied from the table in fs_headers_tab.h, the content
+ * type is found from the file extension by a perfect hash. Files named
+ * "<file>.<ext>.gz" get a Content-Encoding header and the type of <ext>,
+ * other "*.gz" files are application/gzip.
+ */
+int fs_get_http_headers(const char *fName, char *buff, long size);
+
+/**
+ * @brief	Add "Vary: Accept-Encoding" to a header built by fs_get_http_headers()
+ * @param buff	:   buffer of LWIP_FS_HDR_MAX_LEN bytes holding the header
+ * @param len	:   Number of bytes in header
+ * @return New number of bytes in header
+ * @note
+ * For the header of a file that has a "<file>.<ext>.gz" variant, caches
+ * must not send the one to clients that asked for the other.
+ */
+int fs_add_vary_header(char *buff, int len);
+
+#if LWIP_FS_CACHE
+/**
+ * @brief	Get the file cache counters
+ * @param stats	:	Filled with the counters
+ * @return	Nothing
+ */
+void fs_cache_get_stats(struct fs_cache_stats *stats);
+
+#endif /* LWIP_FS_CACHE */
+
 /**
  * @brief	Initialize the filesystem and device on it
  * @return	0 on success non-Zero on failure
@@ -131,6 +252,17 @@ struct fs_file *fs_open_default(void);
  */
 struct fs_file *fs_open(const char *name);
 
+/**
+ * @brief	Open the precompressed variant "<uri>.gz" of a file
+ * @param name	:	Name of the variant to be opened
+ * @return Pointer to File structure on success
+ *         NULL on failure
+ * @note
+ * Same as fs_open(), but without long file name support in FatFs a name
+ * with a second '.' in its last part is only looked for in the ROM image.
+ */
+struct fs_file *fs_open_gz(const char *name);
+
 /**
  * @brief	Closes/Frees a previously opened file function
  * The function will close the file & free the resources.
@@ -150,6 +282,18 @@ void fs_close(struct fs_file *file);
  */
 int fs_read(struct fs_file *file, char *buffer, int count);
 
+/**
+ * @brief	Move the read position of a file read through fs_read()
+ * @param file	:	Pointer to File structure of opened file
+ * @param	offset	:	Position in the file data, not counting the header
+ * @return 0 on success, non-zero if the file is held in memory or the
+ *         offset is past its end
+ * @note
+ * Used to send a byte range of a file. Files held in memory (ROM image,
+ * cache, generated documents) have all their data in fs_file.data.
+ */
+int fs_seek(struct fs_file *file, u32_t offset);
+
 /**
  * @brief	Get number of bytes yet to be read in a file function
  * The function will return the number bytes yet to be read from the file.
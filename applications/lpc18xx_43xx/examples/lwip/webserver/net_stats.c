@@ -0,0 +1,225 @@
+/*
+ * @brief	Network statistics module
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "lwip/opt.h"
+#include "lwip/sys.h"
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#include "arch/lpc18xx_43xx_emac.h"
+#include "httpd.h"
+#include "lwip_fs.h"
+#include "net_stats.h"
+
+/**
+ * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_STATS
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Output buffer state */
+struct json_out {
+	char *buff;
+	int size;
+	int len;
+	int overflow;
+};
+
+#if MEMP_STATS && !MEMP_MEM_MALLOC
+/* Pool names, in memp_t order */
+static const char *const memp_names[MEMP_MAX] = {
+#define LWIP_MEMPOOL(name, num, size, desc) #name,
+#include "lwip/memp_std.h"
+};
+#endif
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Appends formatted text to the document */
+static void json_printf(struct json_out *out, const char *fmt, ...)
+{
+	va_list args;
+	int n;
+
+	if (out->overflow) {
+		return;
+	}
+
+	va_start(args, fmt);
+	n = vsnprintf(&out->buff[out->len], out->size - out->len, fmt, args);
+	va_end(args);
+
+	if ((n < 0) || (n >= (out->size - out->len))) {
+		out->overflow = 1;
+		return;
+	}
+	out->len += n;
+}
+
+#if LWIP_STATS
+/* Appends one lwIP protocol statistics group */
+static void json_proto(struct json_out *out, const char *name,
+					   const struct stats_proto *proto)
+{
+	json_printf(out, "\"%s\":{\"xmit\":%lu,\"recv\":%lu,\"fw\":%lu,\"drop\":%lu,"
+				"\"chkerr\":%lu,\"lenerr\":%lu,\"memerr\":%lu,\"rterr\":%lu,"
+				"\"proterr\":%lu,\"opterr\":%lu,\"err\":%lu},", name,
+				(unsigned long) proto->xmit, (unsigned long) proto->recv,
+				(unsigned long) proto->fw, (unsigned long) proto->drop,
+				(unsigned long) proto->chkerr, (unsigned long) proto->lenerr,
+				(unsigned long) proto->memerr, (unsigned long) proto->rterr,
+				(unsigned long) proto->proterr, (unsigned long) proto->opterr,
+				(unsigned long) proto->err);
+}
+
+#endif
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Formats the current network statistics as JSON */
+int NetStats_GetJSON(char *buff, int size)
+{
+	struct json_out out;
+	struct lpc_emac_rx_stats rx;
+	struct lpc_emac_tx_stats tx;
+
+	out.buff = buff;
+	out.size = size;
+	out.len = 0;
+	out.overflow = 0;
+
+	json_printf(&out, "{\"uptime_ms\":%lu,", (unsigned long) sys_now());
+
+#if LINK_STATS
+	json_proto(&out, "link", &lwip_stats.link);
+#endif
+#if ETHARP_STATS
+	json_proto(&out, "etharp", &lwip_stats.etharp);
+#endif
+#if IPFRAG_STATS
+	json_proto(&out, "ip_frag", &lwip_stats.ip_frag);
+#endif
+#if IP_STATS
+	json_proto(&out, "ip", &lwip_stats.ip);
+#endif
+#if ICMP_STATS
+	json_proto(&out, "icmp", &lwip_stats.icmp);
+#endif
+#if UDP_STATS
+	json_proto(&out, "udp", &lwip_stats.udp);
+#endif
+#if TCP_STATS
+	json_proto(&out, "tcp", &lwip_stats.tcp);
+#endif
+#if MEM_STATS
+	json_printf(&out, "\"mem\":{\"avail\":%lu,\"used\":%lu,\"max\":%lu,\"err\":%lu},",
+				(unsigned long) lwip_stats.mem.avail, (unsigned long) lwip_stats.mem.used,
+				(unsigned long) lwip_stats.mem.max, (unsigned long) lwip_stats.mem.err);
+#endif
+#if MEMP_STATS && !MEMP_MEM_MALLOC
+	{
+		int i;
+
+		/* High-water marks of the pools, for sizing the MEMP_NUM_* options */
+		json_printf(&out, "\"memp\":{");
+		for (i = 0; i < MEMP_MAX; i++) {
+			json_printf(&out, "%s\"%s\":{\"avail\":%lu,\"used\":%lu,\"max\":%lu,\"err\":%lu}",
+						i ? "," : "", memp_names[i],
+						(unsigned long) lwip_stats.memp[i].avail, (unsigned long) lwip_stats.memp[i].used,
+						(unsigned long) lwip_stats.memp[i].max, (unsigned long) lwip_stats.memp[i].err);
+		}
+		json_printf(&out, "},");
+	}
+#endif
+
+#if LWIP_HTTPD_STATS
+	{
+		struct httpd_stats hs;
+
+		httpd_get_stats(&hs);
+		json_printf(&out, "\"httpd\":{\"requests\":%lu,\"bytes_ref\":%lu,\"bytes_copied\":%lu,\"gzip\":%lu,"
+					"\"ranges\":%lu,\"readahead\":%lu},",
+					(unsigned long) hs.requests, (unsigned long) hs.bytes_ref,
+					(unsigned long) hs.bytes_copied, (unsigned long) hs.gzip,
+					(unsigned long) hs.ranges, (unsigned long) hs.readahead);
+	}
+#endif
+
+#if LWIP_FS_CACHE
+	{
+		struct fs_cache_stats cs;
+
+		fs_cache_get_stats(&cs);
+		json_printf(&out, "\"fscache\":{\"hits\":%lu,\"misses\":%lu,\"uncached\":%lu,"
+					"\"evictions\":%lu,\"invalidations\":%lu,\"bytes_used\":%lu,\"files\":%lu},",
+					(unsigned long) cs.hits, (unsigned long) cs.misses, (unsigned long) cs.uncached,
+					(unsigned long) cs.evictions, (unsigned long) cs.invalidations,
+					(unsigned long) cs.bytes_used, (unsigned long) cs.files);
+	}
+#endif
+
+	/* EMAC driver counters */
+	lpc_emac_get_rx_stats(&rx);
+	lpc_emac_get_tx_stats(&tx);
+	json_printf(&out, "\"emac\":{\"rx\":{\"frames\":%lu,\"irqs\":%lu,\"max_batch\":%lu,"
+				"\"budget_hits\":%lu,\"drops\":%lu,\"refill_fail\":%lu,\"dma_unavail\":%lu,"
+				"\"ring_free\":%lu,\"pool_size\":%lu,\"pool_free\":%lu,\"pool_min_free\":%lu},",
+				(unsigned long) rx.frames, (unsigned long) rx.irqs,
+				(unsigned long) rx.max_batch, (unsigned long) rx.budget_hits,
+				(unsigned long) rx.drops, (unsigned long) rx.refill_fail,
+				(unsigned long) rx.dma_unavail, (unsigned long) rx.ring_free,
+				(unsigned long) rx.pool_size, (unsigned long) rx.pool_free,
+				(unsigned long) rx.pool_min_free);
+	json_printf(&out, "\"tx\":{\"frames\":%lu,\"stalls\":%lu,\"timeouts\":%lu,"
+				"\"errors\":%lu,\"bounced\":%lu,\"ring_free\":%lu}}}\n",
+				(unsigned long) tx.frames, (unsigned long) tx.stalls,
+				(unsigned long) tx.timeouts, (unsigned long) tx.errors,
+				(unsigned long) tx.bounced, (unsigned long) tx.ring_free);
+
+	return out.overflow ? -1 : out.len;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,76 @@
+/*
+ * @brief	Network statistics module header
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __NET_STATS_H_
+#define __NET_STATS_H_
+
+#include "lwip/opt.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup EXAMPLE_LWIP_WEBSERVER_18XX43XX_STATS Network statistics
+ * @ingroup EXAMPLE_LWIP_WEBSERVER_18XX43XX
+ * Combines the lwIP protocol statistics (LWIP_STATS) with the EMAC driver
+ * counters into a JSON document. The webserver serves it as /stats.json
+ * so a running system can be monitored over HTTP.
+ * @{
+ */
+
+/** URI of the statistics document */
+#define NET_STATS_URI "/stats.json"
+
+/** Largest statistics document */
+#ifndef NET_STATS_JSON_SZ
+#define NET_STATS_JSON_SZ 2048
+#endif
+
+/**
+ * @brief	Formats the current network statistics as JSON
+ * @param	buff	: Buffer for the document
+ * @param	size	: Size of buff in bytes
+ * @return	Length of the document, or -1 if it did not fit in buff
+ * @note	Counters are sampled one group at a time, so counters of
+ * different groups may be a few packets apart under load.
+ */
+int NetStats_GetJSON(char *buff, int size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_STATS_H_ */
@@ -0,0 +1,241 @@
+/*
+ * @brief Host microbenchmark of the webserver HTTP header builder
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+/* Builds and runs on the host (from the webserver example directory):
+ *
+ *   gcc -O2 -I. -Iconfigs -I../../../../../software/lwip/lwip/src/include \
+ *       -I../../../../../software/lwip/lwip/src/include/ipv4 \
+ *       -I../../../../../software/lwip/lpclwip -o hdrbench tools/hdrbench.c fs_headers.c
+ *   ./hdrbench [iterations]
+ *
+ * Compares fs_get_http_headers() (fs_headers.c, table lookup) with the
+ * string search and strcat() builder it replaced, which is kept here.
+ * Both must produce the same bytes for every test name, then each is
+ * timed over the names and the time per header is printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwip_fs.h"
+#include "httpd_structs.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* File names of a typical page load, error pages and corner cases */
+static const char *const names[] = {
+	"/index.htm", "/static.htm", "/rom.css", "/stats.json", "/logo.png",
+	"/photo.jpg", "/favicon.ico", "/script.js", "/applet.class", "/page.shtml",
+	"/data.xml", "/static.htm.gz", "/rom.css.gz", "/img/dir.x/readme",
+	"/404.html", "/400.htm", "/501.htm", "/4004.htm", "/archive.gz",
+	"/unknown.ext", "/noext", "/file.", ".gz", "/logs.gz", "/dir.x/logs.gz",
+	"/.htm.gz", "/a.gz.gz", "",
+};
+
+#define NUM_NAMES (sizeof(names) / sizeof(names[0]))
+
+/* Content lengths to build headers with, -1 is no Content-Length */
+static const long sizes[] = {-1, 0, 5931, 2147483647L};
+
+#define NUM_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/* Keeps the compiler from dropping the calls */
+static volatile int sink;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* The previous builder of lwip_fs.c, for comparison */
+static int
+old_get_http_headers(const char *fName, char *buff, long size)
+{
+	unsigned int iLoop;
+	const char *pszExt = NULL;
+	const char *hdrs[4];
+	const char *pszEnd;
+	int gzip = 0;
+
+	/* Ensure that we initialize the loop counter. */
+	iLoop = 0;
+
+	/* In all cases, the second header we send is the server identification
+	   so set it here. */
+	hdrs[1] = g_psHTTPHeaderStrings[HTTP_HDR_SERVER];
+
+	/* Is this a normal file or the special case we use to send back the
+	   default "404: Page not found" response? */
+	if (( fName == NULL) || ( *fName == 0) ) {
+		hdrs[0] = g_psHTTPHeaderStrings[HTTP_HDR_NOT_FOUND];
+		hdrs[2] = g_psHTTPHeaderStrings[DEFAULT_404_HTML];
+		goto end_fn;
+	}
+	/* We are dealing with a particular filename. Look for one other
+	    special case.  We assume that any filename with "404" in it must be
+	    indicative of a 404 server error whereas all other files require
+	    the 200 OK header. */
+	if (strstr(fName, "404")) {
+		iLoop = HTTP_HDR_NOT_FOUND;
+	}
+	else if (strstr(fName, "400")) {
+		iLoop = HTTP_HDR_BAD_REQUEST;
+	}
+	else if (strstr(fName, "501")) {
+		iLoop = HTTP_HDR_NOT_IMPL;
+	}
+	else {
+		iLoop = HTTP_HDR_OK;
+	}
+	hdrs[0] = g_psHTTPHeaderStrings[iLoop];
+
+	/* Get a pointer to the file extension.  We find this by looking for the
+	     last occurrence of "." in the filename passed. */
+	pszExt = strrchr(fName, '.');
+
+	/* Does the FileName passed have any file extension?  If not, we assume it
+	     is a special-case URL used for control state notification and we do
+	     not send any HTTP headers with the response. */
+	if (pszExt == NULL) {
+		return 0;
+	}
+
+	/* A precompressed "<file>.<ext>.gz" has the type of <ext>, any other
+	   ".gz" is served as it is */
+	pszEnd = pszExt + strlen(pszExt);
+	if ((strcmp(pszExt, ".gz") == 0) && (pszExt != fName)) {
+		pszEnd = pszExt;
+		do {
+			pszExt--;
+		} while ((pszExt != fName) && (*pszExt != '.') && (*pszExt != '/'));
+		if (*pszExt == '.') {
+			gzip = 1;
+		}
+		else {
+			pszExt = pszEnd;
+			pszEnd = pszExt + strlen(pszExt);
+		}
+	}
+
+	pszExt++;
+	/* Now determine the content type and add the relevant header for that. */
+	for (iLoop = 0; (iLoop < NUM_HTTP_HEADERS); iLoop++)
+		/* Have we found a matching extension? */
+		if ((strncmp(g_psHTTPHeaders[iLoop].extension, pszExt, pszEnd - pszExt) == 0) &&
+			(g_psHTTPHeaders[iLoop].extension[pszEnd - pszExt] == 0)) {
+			hdrs[2] =
+				g_psHTTPHeaderStrings[g_psHTTPHeaders[iLoop].headerIndex];
+			break;
+		}
+
+	/* Did we find a matching extension? */
+	if (iLoop == NUM_HTTP_HEADERS) {
+		/* No - use the default, plain text file type. */
+		hdrs[2] = g_psHTTPHeaderStrings[HTTP_HDR_DEFAULT_TYPE];
+	}
+
+end_fn:
+	iLoop = strlen(hdrs[0]);
+	strcpy(buff, hdrs[0]);
+	strcat(buff, hdrs[1]);
+	if (size >= 0) {
+		iLoop = strlen(buff);
+		sprintf(&buff[iLoop], "%s%ld\r\n", g_psHTTPHeaderStrings[HTTP_HDR_CONTENT_LENGTH], size);
+	}
+	if (gzip) {
+		strcat(buff, g_psHTTPHeaderStrings[HTTP_HDR_GZIP]);
+	}
+	strcat(buff, hdrs[2]);
+	return strlen(buff);
+}
+
+/* Seconds of the monotonic clock */
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/* Time per header in ns of a builder */
+static double bench(int (*fn)(const char *, char *, long), long iterations)
+{
+	char buff[LWIP_FS_HDR_MAX_LEN];
+	double start;
+	long i;
+	unsigned int n;
+
+	start = now();
+	for (i = 0; i < iterations; i++) {
+		for (n = 0; n < NUM_NAMES; n++) {
+			sink += fn(names[n], buff, sizes[n % NUM_SIZES]);
+		}
+	}
+	return ((now() - start) * 1e9) / ((double) iterations * NUM_NAMES);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	char b1[1024], b2[LWIP_FS_HDR_MAX_LEN];
+	long iterations = (argc > 1) ? atol(argv[1]) : 200000;
+	unsigned int n, s;
+	int l1, l2, errors = 0;
+	double t_old, t_new;
+
+	for (n = 0; n < NUM_NAMES; n++) {
+		for (s = 0; s < NUM_SIZES; s++) {
+			l1 = old_get_http_headers(names[n], b1, sizes[s]);
+			l2 = fs_get_http_headers(names[n], b2, sizes[s]);
+			if ((l1 != l2) || (memcmp(b1, b2, l1) != 0) || ((l2 > 0) && (b2[l2] != 0))) {
+				printf("MISMATCH \"%s\" size %ld:\n%.*s---\n%.*s---\n",
+					   names[n], sizes[s], l1, b1, l2, b2);
+				errors++;
+			}
+		}
+	}
+	if (errors) {
+		return 1;
+	}
+	printf("%u names x %u sizes: headers identical\n", (unsigned int) NUM_NAMES, (unsigned int) NUM_SIZES);
+
+	t_old = bench(old_get_http_headers, iterations);
+	t_new = bench(fs_get_http_headers, iterations);
+	printf("strstr/strcat builder: %7.1f ns/header\n", t_old);
+	printf("table builder:         %7.1f ns/header (%.1fx)\n", t_new, t_old / t_new);
+	return 0;
+}
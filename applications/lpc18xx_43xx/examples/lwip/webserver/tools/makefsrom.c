@@ -0,0 +1,505 @@
+/*
+ * @brief Host tool that converts a directory into the webserver ROM file image
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+/* Builds and runs on the host (from the webserver example directory):
+ *
+ *   gcc -O2 -o makefsrom tools/makefsrom.c -lz
+ *   ./makefsrom fs_rom fsdata_rom.c
+ *
+ * Every file below the input directory becomes one entry of the image,
+ * served as "/" followed by its path relative to the directory. The HTTP
+ * header of each entry is generated here the way fs_get_http_headers() in
+ * fs_headers.c builds it at run time, plus a Content-Length, so the webserver
+ * can send an entry straight from flash.
+ *
+ * Each file is also gzip compressed and, if that saves at least 1/8 of its
+ * size, added as a second entry "<uri>.gz" with a Content-Encoding header.
+ * httpd serves it to clients that accept gzip (LWIP_HTTPD_SUPPORT_GZIP),
+ * the header of the first entry then gets "Vary: Accept-Encoding". Files
+ * processed for SSI tags, files without an extension and files that
+ * already are a ".gz" are not compressed. Option -n turns this off.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Longest URI of a file in the image */
+#define MAX_URI_LEN 256
+
+/* Keep in sync with HTTPD_SERVER_AGENT in httpd_structs.h */
+#define SERVER_HDR "Server: lwIP/1.3.1 (http://savannah.nongnu.org/projects/lwip)\r\n"
+
+/* Extension to content type, keep in sync with g_psHTTPHeaders */
+static const struct {
+	const char *extension;
+	const char *header;
+} content_types[] = {
+	{"html",  "Content-type: text/html\r\n\r\n"},
+	{"htm",   "Content-type: text/html\r\n\r\n"},
+	{"shtml", "Content-type: text/html\r\nExpires: Fri, 10 Apr 2008 14:00:00 GMT\r\nPragma: no-cache\r\n\r\n"},
+	{"shtm",  "Content-type: text/html\r\nExpires: Fri, 10 Apr 2008 14:00:00 GMT\r\nPragma: no-cache\r\n\r\n"},
+	{"ssi",   "Content-type: text/html\r\nExpires: Fri, 10 Apr 2008 14:00:00 GMT\r\nPragma: no-cache\r\n\r\n"},
+	{"gif",   "Content-type: image/gif\r\n\r\n"},
+	{"png",   "Content-type: image/png\r\n\r\n"},
+	{"jpg",   "Content-type: image/jpeg\r\n\r\n"},
+	{"bmp",   "Content-type: image/bmp\r\n\r\n"},
+	{"ico",   "Content-type: image/x-icon\r\n\r\n"},
+	{"class", "Content-type: application/octet-stream\r\n\r\n"},
+	{"cls",   "Content-type: application/octet-stream\r\n\r\n"},
+	{"js",    "Content-type: application/x-javascript\r\n\r\n"},
+	{"ram",   "Content-type: application/x-javascript\r\n\r\n"},
+	{"css",   "Content-type: text/css\r\n\r\n"},
+	{"swf",   "Content-type: application/x-shockwave-flash\r\n\r\n"},
+	{"xml",   "Content-type: text/xml\r\n\r\n"},
+	{"xsl",   "Content-type: text/xml\r\n\r\n"},
+	{"json",  "Content-type: application/json\r\nCache-Control: no-cache\r\n\r\n"},
+	{"gz",    "Content-type: application/gzip\r\n\r\n"},
+};
+
+#define NUM_CONTENT_TYPES (sizeof(content_types) / sizeof(content_types[0]))
+#define DEFAULT_CONTENT_TYPE "Content-type: text/plain\r\n\r\n"
+
+/* Keep in sync with HTTP_HDR_GZIP in httpd_structs.h */
+#define GZIP_HDR "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+
+/* Keep in sync with fs_add_vary_header() in fs_headers.c */
+#define VARY_HDR "Vary: Accept-Encoding\r\n"
+
+/* Extensions of files httpd processes for SSI tags, never compressed */
+static const char *const ssi_extensions[] = {".shtml", ".shtm", ".ssi"};
+
+#define NUM_SSI_EXTENSIONS (sizeof(ssi_extensions) / sizeof(ssi_extensions[0]))
+
+/* One file of the image */
+struct rom_entry {
+	char uri[MAX_URI_LEN];
+	char path[MAX_URI_LEN * 2];
+	unsigned char *gzdata;		/* Compressed contents of path, or NULL */
+	long gzsize;
+	int vary;					/* Has a "<uri>.gz" variant */
+};
+
+static struct rom_entry *entries;
+static int num_entries, max_entries;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Adds the files below a directory to the entry list */
+static int scan_dir(const char *path, const char *uri)
+{
+	DIR *dir;
+	struct dirent *de;
+	struct stat st;
+	char fpath[MAX_URI_LEN * 2];
+	char furi[MAX_URI_LEN];
+
+	dir = opendir(path);
+	if (dir == NULL) {
+		fprintf(stderr, "makefsrom: cannot open directory %s\n", path);
+		return -1;
+	}
+
+	while ((de = readdir(dir)) != NULL) {
+		/* Skip ".", ".." and hidden files */
+		if (de->d_name[0] == '.') {
+			continue;
+		}
+		snprintf(fpath, sizeof(fpath), "%s/%s", path, de->d_name);
+		if ((size_t) snprintf(furi, sizeof(furi), "%s/%s", uri, de->d_name) >= sizeof(furi)) {
+			fprintf(stderr, "makefsrom: URI of %s too long\n", fpath);
+			closedir(dir);
+			return -1;
+		}
+		if (stat(fpath, &st) != 0) {
+			continue;
+		}
+		if (S_ISDIR(st.st_mode)) {
+			if (scan_dir(fpath, furi) != 0) {
+				closedir(dir);
+				return -1;
+			}
+			continue;
+		}
+		if (!S_ISREG(st.st_mode)) {
+			continue;
+		}
+
+		if (num_entries == max_entries) {
+			max_entries = max_entries ? (max_entries * 2) : 16;
+			entries = realloc(entries, max_entries * sizeof(*entries));
+			if (entries == NULL) {
+				fprintf(stderr, "makefsrom: out of memory\n");
+				closedir(dir);
+				return -1;
+			}
+		}
+		strcpy(entries[num_entries].uri, furi);
+		strcpy(entries[num_entries].path, fpath);
+		entries[num_entries].gzdata = NULL;
+		entries[num_entries].vary = 0;
+		num_entries++;
+	}
+
+	closedir(dir);
+	return 0;
+}
+
+/* Reads a whole file into a malloc()ed buffer */
+static unsigned char *load_file(const char *path, long *size)
+{
+	FILE *in;
+	unsigned char *data;
+
+	in = fopen(path, "rb");
+	if (in == NULL) {
+		fprintf(stderr, "makefsrom: cannot open %s\n", path);
+		return NULL;
+	}
+	fseek(in, 0, SEEK_END);
+	*size = ftell(in);
+	fseek(in, 0, SEEK_SET);
+	data = malloc(*size ? *size : 1);
+	if ((data == NULL) || (fread(data, 1, *size, in) != (size_t) *size)) {
+		fprintf(stderr, "makefsrom: cannot read %s\n", path);
+		free(data);
+		data = NULL;
+	}
+	fclose(in);
+	return data;
+}
+
+/* Checks if a string ends with a suffix */
+static int has_suffix(const char *str, const char *suffix)
+{
+	size_t slen = strlen(str), xlen = strlen(suffix);
+
+	return (slen >= xlen) && !strcmp(str + slen - xlen, suffix);
+}
+
+/* Checks if the last segment of a URI has an extension */
+static int has_extension(const char *uri, size_t len)
+{
+	while ((len > 0) && (uri[len - 1] != '/')) {
+		if (uri[--len] == '.') {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Compresses data in the gzip format, returns the compressed size or
+   -1 if it does not fit into out */
+static long gzip_data(const unsigned char *data, long size, unsigned char *out, long osize)
+{
+	z_stream zs;
+	long len = -1;
+
+	memset(&zs, 0, sizeof(zs));
+	/* windowBits 15 + 16 writes a gzip header instead of a zlib header */
+	if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return -1;
+	}
+	zs.next_in = (unsigned char *) data;
+	zs.avail_in = size;
+	zs.next_out = out;
+	zs.avail_out = osize;
+	if (deflate(&zs, Z_FINISH) == Z_STREAM_END) {
+		len = zs.total_out;
+	}
+	deflateEnd(&zs);
+	return len;
+}
+
+/* Adds a "<uri>.gz" entry for each file that compresses well, unless
+   the directory already has one */
+static int add_gzip_entries(void)
+{
+	int i, k, n = num_entries;
+	unsigned int j;
+	unsigned char *data, *gz;
+	long size, gzsize;
+	struct rom_entry *e;
+	char gzuri[MAX_URI_LEN];
+
+	for (i = 0; i < n; i++) {
+		if (has_suffix(entries[i].uri, ".gz") ||
+			!has_extension(entries[i].uri, strlen(entries[i].uri)) ||
+			((size_t) snprintf(gzuri, sizeof(gzuri), "%s.gz", entries[i].uri) >= sizeof(gzuri))) {
+			continue;
+		}
+		for (k = 0; k < n; k++) {
+			if (!strcmp(entries[k].uri, gzuri)) {
+				break;
+			}
+		}
+		if (k < n) {
+			entries[i].vary = 1;
+			continue;
+		}
+		for (j = 0; j < NUM_SSI_EXTENSIONS; j++) {
+			if (strstr(entries[i].uri, ssi_extensions[j])) {
+				break;
+			}
+		}
+		if (j < NUM_SSI_EXTENSIONS) {
+			continue;
+		}
+
+		data = load_file(entries[i].path, &size);
+		if (data == NULL) {
+			return -1;
+		}
+		/* Only worth it if 1/8 of the size is saved */
+		gz = malloc(size + 64);
+		gzsize = (gz != NULL) ? gzip_data(data, size, gz, size - (size / 8)) : -1;
+		free(data);
+		if (gzsize < 0) {
+			free(gz);
+			continue;
+		}
+
+		if (num_entries == max_entries) {
+			max_entries *= 2;
+			entries = realloc(entries, max_entries * sizeof(*entries));
+			if (entries == NULL) {
+				fprintf(stderr, "makefsrom: out of memory\n");
+				return -1;
+			}
+		}
+		entries[i].vary = 1;
+		e = &entries[num_entries++];
+		strcpy(e->uri, gzuri);
+		strcpy(e->path, entries[i].path);
+		e->gzdata = gz;
+		e->gzsize = gzsize;
+		e->vary = 0;
+		printf("makefsrom: %s %ld -> %ld bytes\n", e->uri, size, gzsize);
+	}
+	return 0;
+}
+
+/* Orders the entries by URI so the output does not depend on readdir() */
+static int cmp_entry(const void *a, const void *b)
+{
+	return strcmp(((const struct rom_entry *) a)->uri, ((const struct rom_entry *) b)->uri);
+}
+
+/* Builds the HTTP header of a file, same rules as fs_get_http_headers()
+   and fs_add_vary_header() */
+static int make_header(const char *uri, long size, int vary, char *buff, size_t bsize)
+{
+	const char *status, *type, *ext, *encoding;
+	char name[MAX_URI_LEN];
+	unsigned int i;
+	int len;
+
+	if (strstr(uri, "404")) {
+		status = "HTTP/1.0 404 File not found\r\n";
+	}
+	else if (strstr(uri, "400")) {
+		status = "HTTP/1.0 400 Bad Request\r\n";
+	}
+	else if (strstr(uri, "501")) {
+		status = "HTTP/1.0 501 Not Implemented\r\n";
+	}
+	else {
+		status = "HTTP/1.0 200 OK\r\n";
+	}
+
+	/* A "<file>.<ext>.gz" has the content type of the name without ".gz",
+	   any other ".gz" is served as it is */
+	encoding = "";
+	if (has_suffix(uri, ".gz") && has_extension(uri, strlen(uri) - 3)) {
+		snprintf(name, sizeof(name), "%.*s", (int) strlen(uri) - 3, uri);
+		uri = name;
+		encoding = GZIP_HDR;
+	}
+
+	type = DEFAULT_CONTENT_TYPE;
+	ext = strrchr(uri, '.');
+	if ((ext != NULL) && (strchr(ext, '/') == NULL)) {
+		ext++;
+		for (i = 0; i < NUM_CONTENT_TYPES; i++) {
+			if (!strcmp(content_types[i].extension, ext)) {
+				type = content_types[i].header;
+				break;
+			}
+		}
+	}
+
+	len = snprintf(buff, bsize, "%s" SERVER_HDR "Content-Length: %ld\r\n%s%s",
+				   status, size, encoding, type);
+
+	/* The Vary replaces the empty line ending the header */
+	if (vary && ((size_t) len + sizeof(VARY_HDR) < bsize)) {
+		len += snprintf(&buff[len - 2], bsize - len + 2, VARY_HDR "\r\n") - 2;
+	}
+	return len;
+}
+
+/* Writes bytes as the body of a C array initializer */
+static void write_bytes(FILE *out, const unsigned char *data, long len)
+{
+	long i;
+
+	for (i = 0; i < len; i++) {
+		fprintf(out, "%s0x%02x,", ((i % 16) == 0) ? "\t" : " ", data[i]);
+		if (((i % 16) == 15) || (i == (len - 1))) {
+			fputc('\n', out);
+		}
+	}
+}
+
+/* Writes a C identifier for a URI */
+static void write_symbol(FILE *out, const char *uri)
+{
+	fputs("data_", out);
+	for (; *uri; uri++) {
+		fputc((((*uri >= 'a') && (*uri <= 'z')) || ((*uri >= 'A') && (*uri <= 'Z')) ||
+			   ((*uri >= '0') && (*uri <= '9'))) ? *uri : '_', out);
+	}
+}
+
+/* Writes one file of the image */
+static int write_entry(FILE *out, const struct rom_entry *e)
+{
+	unsigned char *data;
+	char hdr[512];
+	long size;
+	int hlen;
+
+	if (e->gzdata != NULL) {
+		data = e->gzdata;
+		size = e->gzsize;
+	}
+	else {
+		data = load_file(e->path, &size);
+		if (data == NULL) {
+			return -1;
+		}
+	}
+
+	hlen = make_header(e->uri, size, e->vary, hdr, sizeof(hdr));
+
+	fprintf(out, "/* %s, %d header and %ld data bytes */\n", e->uri, hlen, size);
+	fputs("static const unsigned char ", out);
+	write_symbol(out, e->uri);
+	fputs("[] = {\n", out);
+	write_bytes(out, (const unsigned char *) hdr, hlen);
+	write_bytes(out, data, size);
+	fputs("};\n\n", out);
+
+	/* Also releases gzdata, each entry is written once */
+	free(data);
+	return hlen;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *outname;
+	FILE *out;
+	int i, *hlens, compress = 1;
+
+	if ((argc > 1) && !strcmp(argv[1], "-n")) {
+		compress = 0;
+		argc--;
+		argv++;
+	}
+	if ((argc < 2) || (argc > 3)) {
+		fprintf(stderr, "usage: makefsrom [-n] <directory> [output.c]\n");
+		return 1;
+	}
+	outname = (argc == 3) ? argv[2] : "fsdata_rom.c";
+
+	if (scan_dir(argv[1], "") != 0) {
+		return 1;
+	}
+	if (num_entries == 0) {
+		fprintf(stderr, "makefsrom: no files in %s\n", argv[1]);
+		return 1;
+	}
+	qsort(entries, num_entries, sizeof(*entries), cmp_entry);
+	if (compress && (add_gzip_entries() != 0)) {
+		return 1;
+	}
+	qsort(entries, num_entries, sizeof(*entries), cmp_entry);
+
+	out = fopen(outname, "w");
+	hlens = malloc(num_entries * sizeof(*hlens));
+	if ((out == NULL) || (hlens == NULL)) {
+		fprintf(stderr, "makefsrom: cannot create %s\n", outname);
+		return 1;
+	}
+
+	fprintf(out, "/*\n * @brief\tWebserver ROM file image\n *\n"
+			" * Generated by tools/makefsrom from the %s directory, do not edit.\n"
+			" */\n\n#include \"lwip_fs.h\"\n\n#if LWIP_FS_ROM_IMAGE\n\n", argv[1]);
+
+	for (i = 0; i < num_entries; i++) {
+		hlens[i] = write_entry(out, &entries[i]);
+		if (hlens[i] < 0) {
+			fclose(out);
+			remove(outname);
+			return 1;
+		}
+	}
+
+	fputs("/* Sorted by name */\nconst struct fsdata_file fsdata_rom_files[] = {\n", out);
+	for (i = 0; i < num_entries; i++) {
+		fprintf(out, "\t{\"%s\", ", entries[i].uri);
+		write_symbol(out, entries[i].uri);
+		fputs(", sizeof(", out);
+		write_symbol(out, entries[i].uri);
+		fprintf(out, "), %d},\n", hlens[i]);
+	}
+	fputs("};\n\nconst int fsdata_rom_numfiles = sizeof(fsdata_rom_files) / sizeof(fsdata_rom_files[0]);\n\n"
+		  "#endif /* LWIP_FS_ROM_IMAGE */\n", out);
+
+	fclose(out);
+	free(hlens);
+	free(entries);
+	printf("makefsrom: %d files written to %s\n", num_entries, outname);
+	return 0;
+}
@@ -0,0 +1,295 @@
+/*
+ * @brief Host tool that generates the HTTP header table of the webserver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+/* Builds and runs on the host (from the webserver example directory):
+ *
+ *   gcc -O2 -I. -Iconfigs -I../../../../../software/lwip/lwip/src/include \
+ *       -I../../../../../software/lwip/lwip/src/include/ipv4 \
+ *       -I../../../../../software/lwip/lpclwip -o makehdrtab tools/makehdrtab.c
+ *   ./makehdrtab fs_headers_tab.h
+ *
+ * The header strings and the extension list are taken from httpd_structs.h.
+ * The output holds the status line and Server header of each status, and
+ * for each content type the rest of the header, so fs_get_http_headers()
+ * builds a header from two copies and the Content-Length digits. File
+ * extensions are found with a perfect hash: the seed is chosen here so
+ * that no two extensions of the list share a slot.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "httpd_structs.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Slots of the extension table, 1 << HASH_BITS must exceed the extensions */
+#define HASH_BITS 5
+#define HASH_SLOTS (1 << HASH_BITS)
+
+/* Content-Length of a 32-bit long */
+#define MAX_LENGTH_DIGITS 10
+
+#define CRLF "\r\n"
+
+/* Status headers in the order of the FS_HDR_STATUS_ indexes */
+static const struct {
+	const char *name;
+	int index;
+} statuses[] = {
+	{"OK",  HTTP_HDR_OK},
+	{"404", HTTP_HDR_NOT_FOUND},
+	{"400", HTTP_HDR_BAD_REQUEST},
+	{"501", HTTP_HDR_NOT_IMPL},
+};
+
+#define NUM_STATUSES (sizeof(statuses) / sizeof(statuses[0]))
+
+/* Content type header indexes, the default type first */
+static int types[NUM_HTTP_HEADERS + 1];
+static int num_types;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Perfect hash, keep in sync with fs_hdr_hash() in fs_headers.c */
+static unsigned int hash(const char *ext, unsigned int len, uint32_t seed)
+{
+	uint32_t h = seed;
+
+	while (len--) {
+		h = (h ^ (uint8_t) *ext++) * 16777619UL;
+	}
+	return (unsigned int) (h >> (32 - HASH_BITS));
+}
+
+/* Finds a seed without collisions, 0 if there is none */
+static uint32_t find_seed(int *slots)
+{
+	uint32_t seed;
+	unsigned int i, s;
+
+	for (seed = 1; seed < 100000000UL; seed++) {
+		for (s = 0; s < HASH_SLOTS; s++) {
+			slots[s] = -1;
+		}
+		for (i = 0; i < NUM_HTTP_HEADERS; i++) {
+			s = hash(g_psHTTPHeaders[i].extension, strlen(g_psHTTPHeaders[i].extension), seed);
+			if (slots[s] >= 0) {
+				break;
+			}
+			slots[s] = i;
+		}
+		if (i == NUM_HTTP_HEADERS) {
+			return seed;
+		}
+	}
+	return 0;
+}
+
+/* Index of a content type header in types[], added if new */
+static int type_index(int hdr)
+{
+	int i;
+
+	for (i = 0; i < num_types; i++) {
+		if (!strcmp(g_psHTTPHeaderStrings[types[i]], g_psHTTPHeaderStrings[hdr])) {
+			return i;
+		}
+	}
+	types[num_types] = hdr;
+	return num_types++;
+}
+
+/* Writes a string as a C literal */
+static void write_string(FILE *out, const char *str)
+{
+	fputc('"', out);
+	for (; *str; str++) {
+		if (*str == '\r') {
+			fputs("\\r", out);
+		}
+		else if (*str == '\n') {
+			fputs("\\n", out);
+		}
+		else {
+			if ((*str == '"') || (*str == '\\')) {
+				fputc('\\', out);
+			}
+			fputc(*str, out);
+		}
+	}
+	fputc('"', out);
+}
+
+/* Writes a header part made of up to three strings, returns its length */
+static size_t write_blob(FILE *out, const char *name, const char *s1, const char *s2, const char *s3)
+{
+	fprintf(out, "static const char %s[] = ", name);
+	write_string(out, s1);
+	if (*s2) {
+		fputs("\n\t", out);
+		write_string(out, s2);
+	}
+	if (*s3) {
+		fputs("\n\t", out);
+		write_string(out, s3);
+	}
+	fputs(";\n", out);
+	return strlen(s1) + strlen(s2) + strlen(s3);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *outname;
+	FILE *out;
+	int slots[HASH_SLOTS], ext_type[NUM_HTTP_HEADERS];
+	uint32_t seed;
+	unsigned int i;
+	size_t len, max_status = 0, max_type = 0;
+	char name[64];
+
+	if (argc > 2) {
+		fprintf(stderr, "usage: makehdrtab [output.h]\n");
+		return 1;
+	}
+	outname = (argc == 2) ? argv[1] : "fs_headers_tab.h";
+
+	if (NUM_HTTP_HEADERS >= HASH_SLOTS) {
+		fprintf(stderr, "makehdrtab: more extensions than slots, raise HASH_BITS\n");
+		return 1;
+	}
+	seed = find_seed(slots);
+	if (seed == 0) {
+		fprintf(stderr, "makehdrtab: no perfect hash seed found, raise HASH_BITS\n");
+		return 1;
+	}
+
+	type_index(HTTP_HDR_DEFAULT_TYPE);
+	for (i = 0; i < NUM_HTTP_HEADERS; i++) {
+		ext_type[i] = type_index(g_psHTTPHeaders[i].headerIndex);
+	}
+
+	out = fopen(outname, "w");
+	if (out == NULL) {
+		fprintf(stderr, "makehdrtab: cannot create %s\n", outname);
+		return 1;
+	}
+
+	fputs("/*\n * @brief\tWebserver HTTP header table\n *\n"
+		  " * Generated by tools/makehdrtab from httpd_structs.h, do not edit.\n"
+		  " */\n\n#ifndef __FS_HEADERS_TAB_H_\n#define __FS_HEADERS_TAB_H_\n\n", out);
+	fprintf(out, "/* Perfect hash of the file extensions, see fs_hdr_hash() */\n"
+			"#define FS_HDR_HASH_BITS    %d\n#define FS_HDR_HASH_SEED    0x%08lxUL\n\n",
+			HASH_BITS, (unsigned long) seed);
+
+	/* Status line and Server header, ending with the Content-Length name */
+	fputs("/* Status line and Server header, followed by \"Content-Length: \" */\n", out);
+	for (i = 0; i < NUM_STATUSES; i++) {
+		snprintf(name, sizeof(name), "fs_hdr_status_%s", statuses[i].name);
+		len = write_blob(out, name, g_psHTTPHeaderStrings[statuses[i].index],
+						 g_psHTTPHeaderStrings[HTTP_HDR_SERVER],
+						 g_psHTTPHeaderStrings[HTTP_HDR_CONTENT_LENGTH]);
+		if (len > max_status) {
+			max_status = len;
+		}
+	}
+	fputs("\n#define FS_HDR_STATUS_OK    0\n#define FS_HDR_STATUS_404   1\n"
+		  "#define FS_HDR_STATUS_400   2\n#define FS_HDR_STATUS_501   3\n\n"
+		  "static const struct fs_hdr_blob fs_hdr_status[] = {\n", out);
+	for (i = 0; i < NUM_STATUSES; i++) {
+		fprintf(out, "\t{fs_hdr_status_%s, sizeof(fs_hdr_status_%s) - 1},\n",
+				statuses[i].name, statuses[i].name);
+	}
+	fputs("};\n\n", out);
+
+	/* The rest of the header for each content type, with and without
+	   Content-Encoding, and the default 404 response */
+	fputs("/* CRLF ending the Content-Length, the Content-Encoding of a \".gz\"\n"
+		  "   and the Content-type */\n", out);
+	for (i = 0; i < (unsigned int) num_types; i++) {
+		snprintf(name, sizeof(name), "fs_hdr_type_%u", i);
+		len = write_blob(out, name, CRLF, g_psHTTPHeaderStrings[types[i]], "");
+		if (len > max_type) {
+			max_type = len;
+		}
+		snprintf(name, sizeof(name), "fs_hdr_type_%u_gz", i);
+		len = write_blob(out, name, CRLF, g_psHTTPHeaderStrings[HTTP_HDR_GZIP],
+						 g_psHTTPHeaderStrings[types[i]]);
+		if (len > max_type) {
+			max_type = len;
+		}
+	}
+	len = write_blob(out, "fs_hdr_type_404", CRLF, g_psHTTPHeaderStrings[DEFAULT_404_HTML], "");
+	if (len > max_type) {
+		max_type = len;
+	}
+	fprintf(out, "\n#define FS_HDR_TYPE_DEFAULT %d\n#define FS_HDR_TYPE_404     %d\n\n"
+			"static const struct fs_hdr_blob fs_hdr_types[][2] = {\n", 0, num_types);
+	for (i = 0; i < (unsigned int) num_types; i++) {
+		fprintf(out, "\t{{fs_hdr_type_%u, sizeof(fs_hdr_type_%u) - 1}, "
+				"{fs_hdr_type_%u_gz, sizeof(fs_hdr_type_%u_gz) - 1}},\n", i, i, i, i);
+	}
+	fputs("\t{{fs_hdr_type_404, sizeof(fs_hdr_type_404) - 1}, "
+		  "{fs_hdr_type_404, sizeof(fs_hdr_type_404) - 1}},\n};\n\n", out);
+
+	/* Extension slots */
+	fputs("/* File extensions, indexed by fs_hdr_hash() */\n"
+		  "static const struct fs_hdr_ext fs_hdr_exts[1 << FS_HDR_HASH_BITS] = {\n", out);
+	for (i = 0; i < HASH_SLOTS; i++) {
+		if (slots[i] < 0) {
+			fprintf(out, "\t{\"\", 0, %d},\n", 0);
+		}
+		else {
+			fprintf(out, "\t{\"%s\", %u, %d},\n", g_psHTTPHeaders[slots[i]].extension,
+					(unsigned int) strlen(g_psHTTPHeaders[slots[i]].extension), ext_type[slots[i]]);
+		}
+	}
+	fputs("};\n\n", out);
+
+	/* Longest header with its terminating NUL */
+	fprintf(out, "/* Longest header, with a %d digit Content-Length and the NUL */\n"
+			"#define FS_HDR_MAX_LEN      %u\n\n#endif /* __FS_HEADERS_TAB_H_ */\n",
+			MAX_LENGTH_DIGITS, (unsigned int) (max_status + MAX_LENGTH_DIGITS + max_type + 1));
+
+	fclose(out);
+	printf("makehdrtab: %u extensions, seed 0x%08lx, written to %s\n",
+		   (unsigned int) NUM_HTTP_HEADERS, (unsigned long) seed, outname);
+	return 0;
+}
@@ -140,6 +140,12 @@ int main(void)
 		/* Handle packets as part of this loop, not in the IRQ handler */
 		lpc_enetif_input(&lpc_netif);
 
+#if LWIP_HTTPD_READAHEAD
+		/* Read the next blocks of the files being sent while the EMAC
+		   transmits the segments queued for them */
+		httpd_read_ahead();
+#endif
+
 		/* lpc_rx_queue will re-qeueu receive buffers. This normally occurs
 		   automatically, but in systems were memory is constrained, pbufs
 		   may not always be able to get allocated, so this function can be
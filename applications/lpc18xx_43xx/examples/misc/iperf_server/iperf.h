@@ -0,0 +1,308 @@
+/*
+ * @brief iperf2 compatible traffic generator and receiver
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __IPERF_H_
+#define __IPERF_H_
+
+#include "lwip/opt.h"
+#include "lwip/ip_addr.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @defgroup EXAMPLES_MISC_18XX43XX_IPERF iperf2 compatible server and client
+ * @ingroup EXAMPLES_MISC_18XX43XX_IPERF_SERVER
+ * Receives and sends TCP and UDP streams in the iperf 2.0 wire format, so
+ * a stock iperf2 on a PC can be used on the other side. Supports parallel
+ * streams (-P), the reverse modes (-r tradeoff, -d dual test), UDP jitter,
+ * loss and reordering statistics, and interval reports on the debug UART.
+ * Two engines implement the same interface: iperf_server.c on the lwIP raw
+ * API for standalone (NO_SYS) builds, and iperf_sock.c on the sockets API
+ * for FreeRTOS builds. iperf_report.c holds the code both share.
+ * @{
+ */
+
+/** TCP and UDP port of the server, and the default port of the client */
+#ifndef IPERF_PORT
+#define IPERF_PORT 5001
+#endif
+
+/** Streams that can run at the same time, both directions together */
+#ifndef IPERF_MAX_STREAMS
+#define IPERF_MAX_STREAMS 8
+#endif
+
+/** Tests (groups of parallel streams) that can run at the same time */
+#ifndef IPERF_MAX_TESTS
+#define IPERF_MAX_TESTS 4
+#endif
+
+/** Seconds between the interval reports of received streams, 0 to only
+    print the final report. Can be changed with "iperf -s -i n". */
+#ifndef IPERF_SERVER_INTERVAL
+#define IPERF_SERVER_INTERVAL 1
+#endif
+
+/** Size of the data buffers, the largest UDP datagram that can be sent */
+#ifndef IPERF_BUF_SZ
+#define IPERF_BUF_SZ 1470
+#endif
+
+/** Datagrams a UDP stream may send in one poll to catch up with its rate */
+#ifndef IPERF_UDP_BURST
+#define IPERF_UDP_BURST 16
+#endif
+
+/** Worker threads of the sockets engine, each runs one stream at a time.
+    There must be one for every stream: a stream waiting for a worker would
+    start late and spoil the sum of its test. */
+#ifndef IPERF_SOCK_WORKERS
+#define IPERF_SOCK_WORKERS IPERF_MAX_STREAMS
+#endif
+
+/** Stack size of the sockets engine threads */
+#ifndef IPERF_SOCK_STACKSIZE
+#define IPERF_SOCK_STACKSIZE DEFAULT_THREAD_STACKSIZE
+#endif
+
+/** Priority of the sockets engine threads */
+#ifndef IPERF_SOCK_PRIO
+#define IPERF_SOCK_PRIO DEFAULT_THREAD_PRIO
+#endif
+
+/* Client header flags */
+#define IPERF_HEADER_VERSION1 0x80000000	/**< Client asks for a reverse test */
+#define IPERF_RUN_NOW         0x00000001	/**< Reverse test runs at the same time (-d) */
+
+/** Header of every iperf UDP datagram, fields in network order */
+struct iperf_udp_hdr {
+	s32_t id;			/**< Datagram number, negative in the last one */
+	u32_t tv_sec;		/**< Send time of the datagram */
+	u32_t tv_usec;
+};
+
+/** Test description sent by the client at the start of a TCP stream and
+    after the header of every UDP datagram, fields in network order */
+struct iperf_client_hdr {
+	s32_t flags;		/**< IPERF_HEADER_VERSION1, IPERF_RUN_NOW */
+	s32_t num_threads;	/**< Parallel streams (-P) */
+	s32_t port;			/**< Port to connect back to for -r and -d */
+	s32_t buffer_len;	/**< Buffer or datagram length (-l), 0 for the default */
+	s32_t win_band;		/**< UDP rate in bits/s (-b) */
+	s32_t amount;		/**< Bytes to send (-n), or -(time in 1/100 s) (-t) */
+};
+
+/** UDP server report, sent back after the header of the last datagram,
+    fields in network order */
+struct iperf_server_hdr {
+	s32_t flags;
+	s32_t total_len1;	/**< Bytes received, upper 32 bits */
+	s32_t total_len2;	/**< Bytes received, lower 32 bits */
+	s32_t stop_sec;		/**< Duration of the test */
+	s32_t stop_usec;
+	s32_t error_cnt;	/**< Datagrams lost */
+	s32_t outorder_cnt;	/**< Datagrams received out of order */
+	s32_t datagrams;	/**< Datagrams sent */
+	s32_t jitter1;		/**< Jitter, seconds */
+	s32_t jitter2;		/**< Jitter, microseconds */
+};
+
+/** Length of a UDP server report datagram, and the smallest UDP length */
+#define IPERF_UDP_ACK_LEN (sizeof(struct iperf_udp_hdr) + sizeof(struct iperf_server_hdr))
+
+/** Reverse test modes */
+typedef enum {
+	IPERF_MODE_NORMAL,		/**< No reverse test */
+	IPERF_MODE_TRADEOFF,	/**< Reverse test after this one (-r) */
+	IPERF_MODE_DUALTEST		/**< Reverse test at the same time (-d) */
+} IPERF_MODE_T;
+
+/** Client test settings, the iperf options of the same letter */
+typedef struct {
+	ip_addr_t addr;			/**< Server (-c) */
+	u16_t port;				/**< Server port (-p) */
+	u16_t listen_port;		/**< Port the server connects back to (-L) */
+	u8_t udp;				/**< UDP instead of TCP (-u) */
+	u8_t mode;				/**< IPERF_MODE_T (-r, -d) */
+	u8_t parallel;			/**< Parallel streams (-P) */
+	u8_t len_set;			/**< len was given */
+	u32_t len;				/**< Buffer or datagram length (-l) */
+	u32_t rate;				/**< UDP rate in bits/s (-b) */
+	u32_t time_ms;			/**< Duration (-t), used when amount is 0 */
+	u32_t amount;			/**< Bytes to send (-n) */
+	u32_t interval_ms;		/**< Interval report period (-i), 0 for none */
+} IPERF_SETTINGS_T;
+
+/** Stream states */
+typedef enum {
+	IPERF_STREAM_FREE,		/**< Slot unused */
+	IPERF_STREAM_RUNNING,	/**< Owned by the engine, counters are updated */
+	IPERF_STREAM_DONE,		/**< Released by the engine, final report pending */
+	IPERF_STREAM_LINGER		/**< Reported UDP stream, kept to answer repeated last datagrams */
+} IPERF_STREAM_STATE_T;
+
+struct iperf_test;
+
+/** One TCP connection or UDP flow */
+typedef struct {
+	u8_t state;				/**< IPERF_STREAM_STATE_T */
+	u8_t id;				/**< Number in the reports */
+	u8_t udp;
+	u8_t sender;			/**< Sends data (client side of a test) */
+	u8_t connected;			/**< Sender is connected, start_us is valid */
+	u8_t shown;				/**< Connection line printed */
+	u8_t error;				/**< Connection failed or was reset */
+	u8_t hdr_len;			/**< Bytes of hdr received */
+	u8_t has_report;		/**< report holds the UDP server report */
+	u8_t closing;			/**< TCP close is pending, nothing more is sent */
+	struct iperf_test *test;	/**< Test the stream belongs to, NULL until known */
+	ip_addr_t addr;			/**< Remote address and port */
+	u16_t port;
+	u32_t start_us;			/**< Start and end time, iperf_time_us() */
+	u32_t end_us;
+	uint64_t bytes;			/**< Bytes sent or received */
+	uint64_t ibytes;		/**< bytes at the start of the interval */
+	struct iperf_client_hdr hdr;	/**< Client header, received or sent */
+
+	/* UDP receiver */
+	s32_t max_id;			/**< Highest datagram number */
+	u32_t lost;				/**< Datagrams missing in the sequence */
+	u32_t outorder;			/**< Datagrams older than max_id */
+	u32_t jitter16;			/**< RFC 3550 jitter in us, times 16 */
+	s32_t transit;			/**< Transit time of the last datagram */
+	s32_t imax_id;			/**< max_id, lost and outorder at the start */
+	u32_t ilost;			/**< of the interval */
+	u32_t ioutorder;
+
+	/* UDP sender */
+	s32_t next_id;			/**< Number of the next datagram */
+	u32_t next_us;			/**< Send time of the next datagram */
+	u32_t ipg_us;			/**< Time between datagrams */
+	u32_t fin_us;			/**< Send time of the last datagram */
+	u8_t fin_tries;			/**< Times the last datagram was sent */
+	struct iperf_server_hdr report;	/**< Server report, host order */
+
+	/* Engine */
+	void *conn;				/**< Raw API pcb */
+	int sock;				/**< Socket */
+} IPERF_STREAM_T;
+
+/** A group of parallel streams from or to one host */
+typedef struct iperf_test {
+	u8_t used;
+	u8_t udp;
+	u8_t sender;
+	u8_t started;			/**< start_us is valid */
+	u8_t shown;				/**< Column names printed */
+	u8_t expected;			/**< Streams announced (-P) */
+	u8_t joined;			/**< Streams that joined the test */
+	u8_t reported;			/**< Streams with a final report */
+	u8_t summed;			/**< Reported streams that transferred data */
+	u8_t reverse;			/**< IPERF_MODE_T of the reverse test to start */
+	ip_addr_t peer;
+	u32_t start_us;			/**< Start of the first stream */
+	u32_t done_ms;			/**< Time of the last final report, sys_now() */
+	u32_t interval_ms;		/**< Interval report period, 0 for none */
+	u32_t next_ms;			/**< End of the next interval from start_us */
+	u32_t sample_us;		/**< When the last interval was reported */
+	uint64_t sum_bytes;		/**< Totals of the reported streams */
+	u32_t sum_lost;
+	u32_t sum_total;
+	u32_t sum_us;			/**< Longest stream, from start_us */
+	IPERF_SETTINGS_T settings;	/**< Sender: the test, receiver: the reverse test */
+} IPERF_TEST_T;
+
+/** Stream table, shared by the engines and the reports */
+extern IPERF_STREAM_T iperf_streams[IPERF_MAX_STREAMS];
+
+/** Data sent by the engines, a repeating "0123456789" pattern */
+extern u8_t iperf_buf[IPERF_BUF_SZ];
+
+/**
+ * @brief	Starts the iperf server on IPERF_PORT (TCP and UDP)
+ * @return	Nothing
+ * @note	Call once after lwip_init() (standalone) or from a thread after
+ * tcpip_init() (FreeRTOS). The FreeRTOS engine starts its own threads.
+ */
+void iperf_server_init(void);
+
+/**
+ * @brief	Runs the iperf timers, UDP senders, reports and UART commands
+ * @return	Nothing
+ * @note	Standalone builds only, call from the main loop
+ */
+void iperf_poll(void);
+
+/**
+ * @brief	Starts a client test
+ * @param	settings	: Test settings
+ * @return	0 if the test started, -1 if there are not enough free streams
+ * @note	The reports are printed on the debug UART as the test runs
+ */
+int iperf_client_start(const IPERF_SETTINGS_T *settings);
+
+/**
+ * @brief	Parses an iperf command line
+ * @param	line		: Command, such as "iperf -c 10.1.10.1 -u -b 10M -P 2"
+ * @param	settings	: Filled with the client settings for "-c"
+ * @return	1 for a client command, 0 for a server or help command that
+ * has been handled, -1 for an error (already printed)
+ */
+int iperf_parse_cmd(char *line, IPERF_SETTINGS_T *settings);
+
+/**
+ * @}
+ */
+
+/* Shared by the engines, see iperf_report.c */
+void iperf_report_init(void);
+u32_t iperf_time_us(void);
+IPERF_STREAM_T *iperf_stream_new(u8_t udp, u8_t sender, const ip_addr_t *addr, u16_t port);
+void iperf_stream_header(IPERF_STREAM_T *s);
+void iperf_stream_add(IPERF_STREAM_T *s, u32_t len);
+void iperf_stream_done(IPERF_STREAM_T *s, u8_t error);
+int iperf_stream_expired(IPERF_STREAM_T *s, u32_t now);
+u32_t iperf_stream_chunk(IPERF_STREAM_T *s, u32_t len);
+IPERF_TEST_T *iperf_client_test(const IPERF_SETTINGS_T *settings);
+void iperf_client_begin(IPERF_STREAM_T *s);
+int iperf_udp_datagram(IPERF_STREAM_T *s, u8_t *buf, u32_t now, u8_t fin);
+int iperf_udp_input(const void *data, int len, const ip_addr_t *addr, u16_t port, u8_t *ack);
+void iperf_udp_report(IPERF_STREAM_T *s, const void *data, int len);
+void iperf_report_poll(void);
+void iperf_console_poll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IPERF_H_ */
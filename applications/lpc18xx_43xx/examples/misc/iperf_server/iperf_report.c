@@ -0,0 +1,1121 @@
+/*
+ * @brief iperf reports, statistics and commands shared by the engines
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/sys.h"
+#include "board.h"
+#include "iperf.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Defaults of the iperf client */
+#define IPERF_TCP_LEN     (8 * 1024)
+#define IPERF_UDP_LEN     1470
+#define IPERF_UDP_RATE    (1024 * 1024)
+#define IPERF_TIME_MS     10000
+
+/* Time a reported UDP stream answers repeated last datagrams. The client
+   sends the last datagram up to 10 times, 250 ms apart. */
+#define IPERF_LINGER_MS   3000
+
+/* Time a test with fewer streams than announced waits for the rest */
+#define IPERF_JOIN_MS     1000
+
+/* Time after which a UDP stream without datagrams is over */
+#define IPERF_UDP_TIMEOUT_MS 5000
+
+/* Report poll period */
+#define IPERF_TICK_MS     100
+
+static IPERF_TEST_T iperf_tests[IPERF_MAX_TESTS];
+
+/* Interval of the receiver reports, "iperf -s -i n" */
+static u32_t iperf_server_interval_ms = IPERF_SERVER_INTERVAL * 1000;
+
+/* Number of the next stream in the reports, iperf starts at 3 */
+static u8_t iperf_next_id = 3;
+
+/* Microsecond clock from the DWT cycle counter */
+static u32_t clk_last, clk_us, clk_frac;
+
+/* Console line */
+static char cmd_line[80];
+static int cmd_len;
+
+static u32_t tick_ms;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+IPERF_STREAM_T iperf_streams[IPERF_MAX_STREAMS];
+u8_t iperf_buf[IPERF_BUF_SZ];
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Prints a value scaled by 100 with 3 significant digits, like %4.3g */
+static void print_scaled(uint64_t v100, const char *unit)
+{
+	u32_t v = (u32_t) v100;
+
+	if (v100 < 1000) {
+		DEBUGOUT("%lu.%02lu %s", (unsigned long) (v / 100), (unsigned long) (v % 100), unit);
+	}
+	else if (v100 < 10000) {
+		DEBUGOUT("%lu.%lu %s", (unsigned long) (v / 100), (unsigned long) ((v / 10) % 10), unit);
+	}
+	else {
+		DEBUGOUT("%4lu %s", (unsigned long) (v100 / 100), unit);
+	}
+}
+
+/* Prints a byte count in 1024 based units */
+static void print_bytes(uint64_t bytes)
+{
+	static const char *const units[] = {"Bytes", "KBytes", "MBytes", "GBytes"};
+	int u = 0;
+
+	while ((u < 3) && (bytes >= ((uint64_t) 1024 << (10 * u)))) {
+		u++;
+	}
+	print_scaled((bytes * 100) >> (10 * u), units[u]);
+}
+
+/* Prints the rate of bytes in us in 1000 based bit units */
+static void print_rate(uint64_t bytes, u32_t us)
+{
+	static const char *const units[] = {"bits/sec", "Kbits/sec", "Mbits/sec", "Gbits/sec"};
+	uint64_t bps = us ? (bytes * 8 * 1000000) / us : 0;
+	uint64_t div = 1;
+	int u = 0;
+
+	while ((u < 3) && (bps >= div * 1000)) {
+		div *= 1000;
+		u++;
+	}
+	print_scaled((bps * 100) / div, units[u]);
+}
+
+/* Prints the start of a report line */
+static void print_interval(const char *id, u32_t from_ms, u32_t to_ms)
+{
+	DEBUGOUT("[%s] %2lu.%lu-%2lu.%lu sec  ", id,
+			 (unsigned long) (from_ms / 1000), (unsigned long) ((from_ms / 100) % 10),
+			 (unsigned long) (to_ms / 1000), (unsigned long) ((to_ms / 100) % 10));
+}
+
+/* Prints jitter and loss of a UDP receiver */
+static void print_udp(u32_t jitter_us, u32_t lost, u32_t total)
+{
+	u32_t pct = total ? (u32_t) (((uint64_t) lost * 10000) / total) : 0;
+
+	DEBUGOUT("  %lu.%03lu ms %4lu/%5lu (%lu.%02lu%%)", (unsigned long) (jitter_us / 1000),
+			 (unsigned long) (jitter_us % 1000), (unsigned long) lost, (unsigned long) total,
+			 (unsigned long) (pct / 100), (unsigned long) (pct % 100));
+}
+
+/* Datagrams lost, without the ones that arrived late */
+static u32_t udp_lost(u32_t lost, u32_t outorder)
+{
+	return (lost > outorder) ? (lost - outorder) : 0;
+}
+
+/* Sets up the test for a stream announced by a client header */
+static IPERF_TEST_T *test_join(IPERF_STREAM_T *s, u32_t expected)
+{
+	IPERF_TEST_T *t;
+	int i;
+
+	/* Join a test of the same host that waits for more streams */
+	for (i = 0; i < IPERF_MAX_TESTS; i++) {
+		t = &iperf_tests[i];
+		if (t->used && !t->sender && (t->udp == s->udp) && (t->joined < t->expected) &&
+			ip_addr_cmp(&t->peer, &s->addr)) {
+			t->joined++;
+			return t;
+		}
+	}
+
+	for (i = 0; i < IPERF_MAX_TESTS; i++) {
+		t = &iperf_tests[i];
+		if (!t->used) {
+			memset(t, 0, sizeof(*t));
+			t->used = 1;
+			t->started = 1;
+			t->udp = s->udp;
+			t->expected = (expected > 0) && (expected <= IPERF_MAX_STREAMS) ? expected : 1;
+			t->joined = 1;
+			ip_addr_copy(t->peer, s->addr);
+			t->start_us = s->start_us;
+			t->sample_us = s->start_us;
+			t->interval_ms = iperf_server_interval_ms;
+			t->next_ms = t->interval_ms;
+			return t;
+		}
+	}
+	return NULL;
+}
+
+/* Prints the connection line of a stream, and the column names for the
+   first stream of a test */
+static void show_stream(IPERF_STREAM_T *s)
+{
+	char addr[16];
+
+	if (!s->test->shown) {
+		DEBUGOUT("------------------------------------------------------------\r\n");
+		DEBUGOUT("%s %s port %u\r\n", s->sender ? "Client connecting to" : "Server receiving from",
+				 ipaddr_ntoa_r(&s->test->peer, addr, sizeof(addr)),
+				 s->sender ? s->test->settings.port : IPERF_PORT);
+		if (s->udp && s->sender) {
+			DEBUGOUT("Sending %lu byte datagrams at ", (unsigned long) s->test->settings.len);
+			print_rate(s->test->settings.rate / 8, 1000000);
+			DEBUGOUT("\r\n");
+		}
+		DEBUGOUT("------------------------------------------------------------\r\n");
+	}
+	DEBUGOUT("[%3u] %s %s port %u\r\n", s->id, s->sender ? "connected to" : "connected with",
+			 ipaddr_ntoa_r(&s->addr, addr, sizeof(addr)), s->port);
+	if (!s->test->shown) {
+		DEBUGOUT("[ ID] Interval       Transfer     Bandwidth%s\r\n",
+				 (s->udp && !s->sender) ? "        Jitter   Lost/Total Datagrams" : "");
+		s->test->shown = 1;
+	}
+	s->shown = 1;
+}
+
+/* Prints the interval report of a stream and starts the next interval.
+   The rate is taken over us, the time since the last report. A sender
+   that has sent everything and only waits for its end (the last UDP
+   datagram is resent, a TCP close is pending) is not shown once it has
+   nothing left to report, returns 0 then. */
+static int report_interval(IPERF_STREAM_T *s, u32_t from_ms, u32_t to_ms, u32_t us,
+						   uint64_t *sum, u32_t *sum_lost, u32_t *sum_total)
+{
+	char id[4];
+	uint64_t bytes;
+	s32_t max_id;
+	u32_t lost, outorder;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	bytes = s->bytes - s->ibytes;
+	if ((bytes == 0) && s->sender && (s->fin_tries || s->closing)) {
+		SYS_ARCH_UNPROTECT(lev);
+		return 0;
+	}
+	s->ibytes = s->bytes;
+	max_id = s->max_id;
+	lost = s->lost;
+	outorder = s->outorder;
+	SYS_ARCH_UNPROTECT(lev);
+
+	snprintf(id, sizeof(id), "%3u", (unsigned) s->id);
+	print_interval(id, from_ms, to_ms);
+	print_bytes(bytes);
+	DEBUGOUT("  ");
+	print_rate(bytes, us);
+	*sum += bytes;
+	if (s->udp && !s->sender) {
+		u32_t ilost = udp_lost(lost - s->ilost, outorder - s->ioutorder);
+		u32_t itotal = (max_id > s->imax_id) ? (u32_t) (max_id - s->imax_id) : 0;
+
+		print_udp(s->jitter16 >> 4, ilost, itotal);
+		*sum_lost += ilost;
+		*sum_total += itotal;
+		s->imax_id = max_id;
+		s->ilost = lost;
+		s->ioutorder = outorder;
+	}
+	DEBUGOUT("\r\n");
+	return 1;
+}
+
+/* Prints the final report of a stream */
+static void report_final(IPERF_STREAM_T *s)
+{
+	char id[4];
+	u32_t us = s->end_us - s->start_us;
+	u32_t datagrams = (s->max_id > 0) ? (u32_t) s->max_id : 0;
+
+	snprintf(id, sizeof(id), "%3u", (unsigned) s->id);
+	if (s->error && (s->bytes == 0)) {
+		DEBUGOUT("[%s] %s failed\r\n", id, s->sender ? "connect" : "receive");
+		return;
+	}
+	print_interval(id, 0, us / 1000);
+	print_bytes(s->bytes);
+	DEBUGOUT("  ");
+	print_rate(s->bytes, us);
+	if (s->udp && !s->sender) {
+		print_udp(s->jitter16 >> 4, udp_lost(s->lost, s->outorder), datagrams);
+	}
+	DEBUGOUT("\r\n");
+	if (s->udp && !s->sender && s->outorder) {
+		DEBUGOUT("[%s] %2u.%u-%2lu.%lu sec  %lu datagrams received out-of-order\r\n", id, 0, 0,
+				 (unsigned long) (us / 1000000), (unsigned long) ((us / 100000) % 10),
+				 (unsigned long) s->outorder);
+	}
+	if (s->udp && s->sender) {
+		DEBUGOUT("[%s] Sent %ld datagrams\r\n", id, (long) s->next_id);
+		if (s->has_report) {
+			const struct iperf_server_hdr *r = &s->report;
+			uint64_t total = ((uint64_t) (u32_t) r->total_len1 << 32) | (u32_t) r->total_len2;
+			u32_t rus = (u32_t) r->stop_sec * 1000000 + (u32_t) r->stop_usec;
+
+			DEBUGOUT("[%s] Server Report:\r\n", id);
+			print_interval(id, 0, rus / 1000);
+			print_bytes(total);
+			DEBUGOUT("  ");
+			print_rate(total, rus);
+			print_udp((u32_t) r->jitter1 * 1000000 + (u32_t) r->jitter2, (u32_t) r->error_cnt,
+					  (u32_t) r->datagrams);
+			DEBUGOUT("\r\n");
+			if (r->outorder_cnt) {
+				DEBUGOUT("[%s] %lu datagrams received out-of-order\r\n", id,
+						 (unsigned long) r->outorder_cnt);
+			}
+		}
+		else {
+			DEBUGOUT("[%s] WARNING: did not receive ack of last datagram after %u tries.\r\n",
+					 id, s->fin_tries);
+		}
+	}
+}
+
+/* Prints the reports of one test, returns 1 when the test is over */
+static int report_test(IPERF_TEST_T *t, u32_t now)
+{
+	IPERF_STREAM_T *s;
+	uint64_t sum = 0;
+	u32_t sum_lost = 0, sum_total = 0, from_ms, to_ms, us;
+	int i, n = 0;
+
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		s = &iperf_streams[i];
+		/* A client stream is shown once it is connected */
+		if ((s->state != IPERF_STREAM_FREE) && (s->test == t) && !s->shown &&
+			(!s->sender || s->connected)) {
+			show_stream(s);
+		}
+	}
+
+	/* Interval reports of the running streams */
+	if (t->started && t->interval_ms && ((now - t->start_us) / 1000 >= t->next_ms)) {
+		/* The reports run on a coarse tick, so the rates are taken over
+		   the time that really passed since the last interval. Intervals
+		   missed while the reports were stalled are shown as one. */
+		from_ms = t->next_ms - t->interval_ms;
+		to_ms = ((now - t->start_us) / 1000 / t->interval_ms) * t->interval_ms;
+		us = now - t->sample_us;
+		t->sample_us = now;
+		for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+			s = &iperf_streams[i];
+			if ((s->state == IPERF_STREAM_RUNNING) && (s->test == t) && s->shown) {
+				n += report_interval(s, from_ms, to_ms, us, &sum, &sum_lost, &sum_total);
+			}
+		}
+		if (n > 1) {
+			print_interval("SUM", from_ms, to_ms);
+			print_bytes(sum);
+			DEBUGOUT("  ");
+			print_rate(sum, us);
+			DEBUGOUT("\r\n");
+		}
+		t->next_ms = to_ms + t->interval_ms;
+	}
+
+	/* Final reports */
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		s = &iperf_streams[i];
+		if ((s->state == IPERF_STREAM_DONE) && (s->test == t)) {
+			report_final(s);
+			if (!s->error || s->bytes) {
+				t->sum_bytes += s->bytes;
+				if ((s->end_us - t->start_us) > t->sum_us) {
+					t->sum_us = s->end_us - t->start_us;
+				}
+				if (s->udp && !s->sender) {
+					t->sum_lost += udp_lost(s->lost, s->outorder);
+					t->sum_total += (s->max_id > 0) ? (u32_t) s->max_id : 0;
+				}
+				t->summed++;
+			}
+			t->reported++;
+			t->done_ms = sys_now();
+			s->state = (s->udp && !s->sender) ? IPERF_STREAM_LINGER : IPERF_STREAM_FREE;
+			s->conn = NULL;
+		}
+	}
+
+	if ((t->reported < t->joined) ||
+		((t->joined < t->expected) && ((sys_now() - t->done_ms) < IPERF_JOIN_MS))) {
+		return 0;
+	}
+
+	/* All streams are done, print the sum of the test */
+	if (t->summed > 1) {
+		print_interval("SUM", 0, t->sum_us / 1000);
+		print_bytes(t->sum_bytes);
+		DEBUGOUT("  ");
+		print_rate(t->sum_bytes, t->sum_us);
+		if (t->udp && !t->sender) {
+			DEBUGOUT("           %4lu/%5lu", (unsigned long) t->sum_lost, (unsigned long) t->sum_total);
+		}
+		DEBUGOUT("\r\n");
+	}
+	return 1;
+}
+
+/* Parses a number with an optional K, M or G suffix, 1024 based in
+   upper case and 1000 based in lower case as in iperf */
+static int parse_num(const char *arg, u32_t *val)
+{
+	char *end;
+	unsigned long v = strtoul(arg, &end, 10);
+
+	if (end == arg) {
+		return -1;
+	}
+	switch (*end) {
+	case 'G': v *= 1024 * 1024 * 1024; break;
+	case 'M': v *= 1024 * 1024; break;
+	case 'K': v *= 1024; break;
+	case 'g': v *= 1000000000; break;
+	case 'm': v *= 1000000; break;
+	case 'k': v *= 1000; break;
+	case '\0': break;
+	default: return -1;
+	}
+	*val = v;
+	return 0;
+}
+
+/* Parses a number of seconds with an optional fraction into ms */
+static int parse_ms(const char *arg, u32_t *ms)
+{
+	char *end;
+	unsigned long sec = strtoul(arg, &end, 10), frac = 0, div = 1;
+
+	if (*end == '.') {
+		for (end++; (*end >= '0') && (*end <= '9') && (div < 1000); end++) {
+			frac = frac * 10 + (*end - '0');
+			div *= 10;
+		}
+	}
+	if ((end == arg) || (*end != '\0')) {
+		return -1;
+	}
+	*ms = sec * 1000 + (frac * 1000) / div;
+	return 0;
+}
+
+static void print_help(void)
+{
+	DEBUGOUT("Usage: iperf -c host [options]   start a client test\r\n"
+			 "       iperf -s [-i n]            set the server report interval\r\n"
+			 "  -u      UDP instead of TCP        -b n[KM] UDP rate in bits/s (1M)\r\n"
+			 "  -t n    seconds to send (10)      -n n[KM] bytes to send instead\r\n"
+			 "  -l n[K] buffer or datagram length -i n     seconds between reports\r\n"
+			 "  -P n    parallel streams          -p n     server port (%u)\r\n"
+			 "  -r      reverse test afterwards   -d       reverse test at the same time\r\n"
+			 "  -L n    port for the reverse test (%u)\r\n", IPERF_PORT, IPERF_PORT);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Initializes the tables and the clock */
+void iperf_report_init(void)
+{
+	int i;
+
+	for (i = 0; i < IPERF_BUF_SZ; i++) {
+		iperf_buf[i] = '0' + (i % 10);
+	}
+
+	/* The DWT cycle counter may already run for the PERF probes */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	clk_last = DWT->CYCCNT;
+	tick_ms = sys_now();
+}
+
+/* Microseconds since an arbitrary start, wraps after 71 minutes. Must be
+   called at least once per counter wrap (21 s at 204 MHz), which the
+   report poll does. */
+u32_t iperf_time_us(void)
+{
+	u32_t cyc, delta, per_us = SystemCoreClock / 1000000;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	cyc = DWT->CYCCNT;
+	delta = cyc - clk_last;
+	clk_last = cyc;
+	clk_us += delta / per_us;
+	clk_frac += delta % per_us;
+	if (clk_frac >= per_us) {
+		clk_frac -= per_us;
+		clk_us++;
+	}
+	cyc = clk_us;
+	SYS_ARCH_UNPROTECT(lev);
+
+	return cyc;
+}
+
+/* Allocates a stream, NULL if there is no free slot. A lingering UDP
+   stream is reused when needed. */
+IPERF_STREAM_T *iperf_stream_new(u8_t udp, u8_t sender, const ip_addr_t *addr, u16_t port)
+{
+	IPERF_STREAM_T *s = NULL, *linger = NULL;
+	int i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	for (i = 0; (i < IPERF_MAX_STREAMS) && (s == NULL); i++) {
+		if (iperf_streams[i].state == IPERF_STREAM_FREE) {
+			s = &iperf_streams[i];
+		}
+		else if ((iperf_streams[i].state == IPERF_STREAM_LINGER) && (linger == NULL)) {
+			linger = &iperf_streams[i];
+		}
+	}
+	if (s == NULL) {
+		s = linger;
+	}
+	if (s != NULL) {
+		memset(s, 0, sizeof(*s));
+		s->state = IPERF_STREAM_RUNNING;
+		s->id = iperf_next_id;
+		iperf_next_id = (iperf_next_id >= 99) ? 3 : (iperf_next_id + 1);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (s != NULL) {
+		s->udp = udp;
+		s->sender = sender;
+		ip_addr_set(&s->addr, addr);
+		s->port = port;
+		s->max_id = -1;
+		s->imax_id = -1;
+		s->sock = -1;
+		s->start_us = iperf_time_us();
+		s->end_us = s->start_us;
+	}
+	return s;
+}
+
+/* Handles the client header of a received stream, once hdr is complete */
+void iperf_stream_header(IPERF_STREAM_T *s)
+{
+	u32_t flags = ntohl(s->hdr.flags);
+	s32_t amount = (s32_t) ntohl(s->hdr.amount);
+	IPERF_SETTINGS_T *r;
+	IPERF_TEST_T *t;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	t = test_join(s, ntohl(s->hdr.num_threads));
+	if ((t != NULL) && (t->joined == 1) && (flags & IPERF_HEADER_VERSION1)) {
+		/* The first stream of the test asks for the reverse test */
+		r = &t->settings;
+		memset(r, 0, sizeof(*r));
+		ip_addr_set(&r->addr, &s->addr);
+		r->port = (u16_t) ntohl(s->hdr.port);
+		if (r->port == 0) {
+			r->port = IPERF_PORT;
+		}
+		r->listen_port = IPERF_PORT;
+		r->udp = s->udp;
+		r->mode = IPERF_MODE_NORMAL;
+		r->parallel = t->expected;
+		r->len = ntohl(s->hdr.buffer_len);
+		r->len_set = (r->len != 0);
+		r->rate = ntohl(s->hdr.win_band);
+		if (amount < 0) {
+			r->time_ms = (u32_t) -amount * 10;
+		}
+		else {
+			r->amount = (u32_t) amount;
+		}
+		r->interval_ms = iperf_server_interval_ms;
+		t->reverse = (flags & IPERF_RUN_NOW) ? IPERF_MODE_DUALTEST : IPERF_MODE_TRADEOFF;
+	}
+	s->test = t;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/* Adds transferred bytes to a stream */
+void iperf_stream_add(IPERF_STREAM_T *s, u32_t len)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	s->bytes += len;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/* Hands a stream to the reports, the engine must not use it afterwards */
+void iperf_stream_done(IPERF_STREAM_T *s, u8_t error)
+{
+	/* UDP streams end with their last datagram, TCP streams that had to
+	   wait for their close when they stopped sending */
+	if (!s->udp && !s->closing) {
+		s->end_us = iperf_time_us();
+	}
+	s->error = error;
+	if (s->test == NULL) {
+		/* A received stream without a complete header */
+		SYS_ARCH_DECL_PROTECT(lev);
+
+		SYS_ARCH_PROTECT(lev);
+		s->test = test_join(s, 1);
+		SYS_ARCH_UNPROTECT(lev);
+		if (s->test == NULL) {
+			s->state = IPERF_STREAM_FREE;
+			return;
+		}
+	}
+	s->state = IPERF_STREAM_DONE;
+}
+
+/* Returns 1 when a sender has sent its time or amount */
+int iperf_stream_expired(IPERF_STREAM_T *s, u32_t now)
+{
+	const IPERF_SETTINGS_T *set = &s->test->settings;
+
+	if (set->amount) {
+		return s->bytes >= set->amount;
+	}
+	return (now - s->start_us) >= set->time_ms * 1000;
+}
+
+/* Limits a send to the bytes left of the amount */
+u32_t iperf_stream_chunk(IPERF_STREAM_T *s, u32_t len)
+{
+	const IPERF_SETTINGS_T *set = &s->test->settings;
+
+	if (set->amount && ((s->bytes + len) > set->amount)) {
+		len = (u32_t) (set->amount - s->bytes);
+	}
+	return len;
+}
+
+/* Allocates a client test and its streams, NULL if there are not enough
+   free streams */
+IPERF_TEST_T *iperf_client_test(const IPERF_SETTINGS_T *settings)
+{
+	IPERF_TEST_T *t = NULL;
+	IPERF_STREAM_T *s;
+	u32_t flags = 0;
+	int i, n = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	for (i = 0; i < IPERF_MAX_TESTS; i++) {
+		if (!iperf_tests[i].used) {
+			t = &iperf_tests[i];
+			memset(t, 0, sizeof(*t));
+			t->used = 1;
+			break;
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+	if (t == NULL) {
+		DEBUGSTR("iperf: too many tests\r\n");
+		return NULL;
+	}
+
+	t->settings = *settings;
+	t->sender = 1;
+	t->udp = settings->udp;
+	t->expected = settings->parallel ? settings->parallel : 1;
+	t->interval_ms = settings->interval_ms;
+	t->next_ms = t->interval_ms;
+	ip_addr_set(&t->peer, &settings->addr);
+	if (!t->settings.len_set) {
+		t->settings.len = t->udp ? IPERF_UDP_LEN : IPERF_TCP_LEN;
+	}
+	if (t->udp) {
+		if (t->settings.len > IPERF_BUF_SZ) {
+			t->settings.len = IPERF_BUF_SZ;
+		}
+		if (t->settings.len < IPERF_UDP_ACK_LEN) {
+			t->settings.len = IPERF_UDP_ACK_LEN;
+		}
+		if (t->settings.rate == 0) {
+			t->settings.rate = IPERF_UDP_RATE;
+		}
+	}
+	if ((t->settings.amount == 0) && (t->settings.time_ms == 0)) {
+		t->settings.time_ms = IPERF_TIME_MS;
+	}
+
+	if (settings->mode != IPERF_MODE_NORMAL) {
+		flags = IPERF_HEADER_VERSION1;
+		if (settings->mode == IPERF_MODE_DUALTEST) {
+			flags |= IPERF_RUN_NOW;
+		}
+	}
+
+	for (n = 0; n < t->expected; n++) {
+		s = iperf_stream_new(t->udp, 1, &settings->addr, t->settings.port);
+		if (s == NULL) {
+			break;
+		}
+		s->test = t;
+		s->hdr.flags = htonl(flags);
+		s->hdr.num_threads = htonl(t->expected);
+		s->hdr.port = htonl(t->settings.listen_port);
+		s->hdr.buffer_len = htonl(t->settings.len_set ? t->settings.len : 0);
+		s->hdr.win_band = htonl(t->udp ? t->settings.rate : 0);
+		s->hdr.amount = htonl(t->settings.amount ? t->settings.amount :
+							  (u32_t) -(s32_t) (t->settings.time_ms / 10));
+		if (t->udp) {
+			s->ipg_us = (u32_t) (((uint64_t) t->settings.len * 8 * 1000000) / t->settings.rate);
+		}
+	}
+
+	if (n < t->expected) {
+		DEBUGSTR("iperf: too many streams\r\n");
+		SYS_ARCH_PROTECT(lev);
+		for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+			if (iperf_streams[i].test == t) {
+				iperf_streams[i].state = IPERF_STREAM_FREE;
+				iperf_streams[i].test = NULL;
+			}
+		}
+		t->used = 0;
+		SYS_ARCH_UNPROTECT(lev);
+		return NULL;
+	}
+	t->joined = t->expected;
+	return t;
+}
+
+/* Restarts the clocks of a client stream once it is connected */
+void iperf_client_begin(IPERF_STREAM_T *s)
+{
+	IPERF_TEST_T *t = s->test;
+	u32_t now = iperf_time_us();
+
+	s->start_us = now;
+	s->next_us = now;
+	s->connected = 1;
+	if (!t->started) {
+		t->start_us = now;
+		t->sample_us = now;
+		t->started = 1;
+	}
+}
+
+/* Fills the headers of a UDP datagram in buf, returns its length */
+int iperf_udp_datagram(IPERF_STREAM_T *s, u8_t *buf, u32_t now, u8_t fin)
+{
+	struct iperf_udp_hdr hdr;
+
+	hdr.id = htonl(fin ? -s->next_id : s->next_id);
+	hdr.tv_sec = htonl(now / 1000000);
+	hdr.tv_usec = htonl(now % 1000000);
+	memcpy(buf, &hdr, sizeof(hdr));
+	memcpy(&buf[sizeof(hdr)], &s->hdr, sizeof(s->hdr));
+	if (!fin) {
+		s->next_id++;
+	}
+	return s->test->settings.len;
+}
+
+/* Handles a datagram received on the UDP server port. Returns the length
+   of the server report to send back in ack (IPERF_UDP_ACK_LEN bytes),
+   0 for none. */
+int iperf_udp_input(const void *data, int len, const ip_addr_t *addr, u16_t port, u8_t *ack)
+{
+	struct iperf_udp_hdr hdr;
+	struct iperf_server_hdr *r;
+	IPERF_STREAM_T *s = NULL, *linger = NULL;
+	u32_t now = iperf_time_us(), sent;
+	s32_t id, transit, d;
+	int i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (len < (int) sizeof(hdr)) {
+		return 0;
+	}
+	memcpy(&hdr, data, sizeof(hdr));
+	id = (s32_t) ntohl(hdr.id);
+
+	/* The workers change the state of their streams */
+	SYS_ARCH_PROTECT(lev);
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		IPERF_STREAM_T *f = &iperf_streams[i];
+
+		if (f->udp && !f->sender && (f->port == port) && ip_addr_cmp(&f->addr, addr)) {
+			if (f->state == IPERF_STREAM_RUNNING) {
+				s = f;
+			}
+			else if ((f->state == IPERF_STREAM_DONE) || (f->state == IPERF_STREAM_LINGER)) {
+				linger = f;
+			}
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (s == NULL) {
+		if ((id < 0) && (linger != NULL)) {
+			/* The client did not get the report, send it again */
+			s = linger;
+			goto send_ack;
+		}
+		if ((id < 0) || ((linger != NULL) && (id != 0) && (id <= linger->max_id))) {
+			/* End or late datagram of a test that is over */
+			return 0;
+		}
+		s = iperf_stream_new(1, 0, addr, port);
+		if (s == NULL) {
+			return 0;
+		}
+		s->start_us = now;
+		if (len >= (int) (sizeof(hdr) + sizeof(s->hdr))) {
+			memcpy(&s->hdr, (const u8_t *) data + sizeof(hdr), sizeof(s->hdr));
+			s->hdr_len = sizeof(s->hdr);
+			iperf_stream_header(s);
+		}
+	}
+
+	iperf_stream_add(s, len);
+	s->end_us = now;
+
+	/* RFC 3550 jitter, from the transit time differences */
+	sent = ntohl(hdr.tv_sec) * 1000000 + ntohl(hdr.tv_usec);
+	transit = (s32_t) (now - sent);
+	if (s->max_id >= 0) {
+		d = transit - s->transit;
+		if (d < 0) {
+			d = -d;
+		}
+		s->jitter16 += (u32_t) d - ((s->jitter16 + 8) >> 4);
+	}
+	s->transit = transit;
+
+	/* The last datagram has the negated next number */
+	if (id < 0) {
+		id = -id;
+	}
+	if (id != s->max_id + 1) {
+		if (id < s->max_id + 1) {
+			s->outorder++;
+		}
+		else {
+			s->lost += id - s->max_id - 1;
+		}
+	}
+	if (id > s->max_id) {
+		s->max_id = id;
+	}
+
+	if ((s32_t) ntohl(hdr.id) >= 0) {
+		return 0;
+	}
+	iperf_stream_done(s, 0);
+	if (s->state == IPERF_STREAM_FREE) {
+		return 0;
+	}
+
+send_ack:
+	memcpy(ack, &hdr, sizeof(hdr));
+	r = (struct iperf_server_hdr *) &ack[sizeof(hdr)];
+	r->flags = htonl(IPERF_HEADER_VERSION1);
+	r->total_len1 = htonl((u32_t) (s->bytes >> 32));
+	r->total_len2 = htonl((u32_t) s->bytes);
+	r->stop_sec = htonl((s->end_us - s->start_us) / 1000000);
+	r->stop_usec = htonl((s->end_us - s->start_us) % 1000000);
+	r->error_cnt = htonl(udp_lost(s->lost, s->outorder));
+	r->outorder_cnt = htonl(s->outorder);
+	r->datagrams = htonl(s->max_id);
+	r->jitter1 = htonl((s->jitter16 >> 4) / 1000000);
+	r->jitter2 = htonl((s->jitter16 >> 4) % 1000000);
+	return IPERF_UDP_ACK_LEN;
+}
+
+/* Stores the server report received by a UDP sender */
+void iperf_udp_report(IPERF_STREAM_T *s, const void *data, int len)
+{
+	struct iperf_server_hdr r;
+	s32_t *f = (s32_t *) &r;
+	int i;
+
+	if (len < (int) IPERF_UDP_ACK_LEN) {
+		return;
+	}
+	memcpy(&r, (const u8_t *) data + sizeof(struct iperf_udp_hdr), sizeof(r));
+	for (i = 0; i < (int) (sizeof(r) / sizeof(*f)); i++) {
+		f[i] = (s32_t) ntohl(f[i]);
+	}
+	s->report = r;
+	s->has_report = 1;
+}
+
+/* Prints due reports, frees finished tests and starts reverse tests. Call
+   often, returns quickly between ticks. */
+void iperf_report_poll(void)
+{
+	IPERF_SETTINGS_T reverse;
+	IPERF_TEST_T *t;
+	IPERF_STREAM_T *s;
+	u32_t now;
+	int i, j;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if ((sys_now() - tick_ms) < IPERF_TICK_MS) {
+		return;
+	}
+	tick_ms = sys_now();
+	now = iperf_time_us();
+
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		s = &iperf_streams[i];
+
+		/* A UDP client that stopped without its last datagram, or a
+		   reported UDP stream that has lingered long enough */
+		if (s->udp && !s->sender && ((now - s->end_us) / 1000 >= IPERF_UDP_TIMEOUT_MS)) {
+			if (s->state == IPERF_STREAM_RUNNING) {
+				iperf_stream_done(s, 1);
+			}
+		}
+		if ((s->state == IPERF_STREAM_LINGER) && ((now - s->end_us) / 1000 >= IPERF_LINGER_MS)) {
+			s->state = IPERF_STREAM_FREE;
+		}
+	}
+
+	for (i = 0; i < IPERF_MAX_TESTS; i++) {
+		t = &iperf_tests[i];
+		if (!t->used || (t->joined == 0)) {
+			continue;
+		}
+
+		if (t->reverse == IPERF_MODE_DUALTEST) {
+			t->reverse = IPERF_MODE_NORMAL;
+			iperf_client_start(&t->settings);
+		}
+
+		if (!report_test(t, now)) {
+			continue;
+		}
+
+		reverse = t->settings;
+		if (t->reverse == IPERF_MODE_TRADEOFF) {
+			t->reverse = IPERF_MODE_NORMAL;
+		}
+		else {
+			reverse.parallel = 0;
+		}
+
+		SYS_ARCH_PROTECT(lev);
+		for (j = 0; j < IPERF_MAX_STREAMS; j++) {
+			if (iperf_streams[j].test == t) {
+				iperf_streams[j].test = NULL;
+			}
+		}
+		t->used = 0;
+		SYS_ARCH_UNPROTECT(lev);
+
+		if (reverse.parallel) {
+			iperf_client_start(&reverse);
+		}
+	}
+}
+
+/* Parses an iperf command line */
+int iperf_parse_cmd(char *line, IPERF_SETTINGS_T *settings)
+{
+	char *argv[24], *arg;
+	int argc = 0, i, client = 0, server = 0;
+	u32_t v;
+
+	for (arg = strtok(line, " \t"); (arg != NULL) && (argc < 24); arg = strtok(NULL, " \t")) {
+		argv[argc++] = arg;
+	}
+	i = ((argc > 0) && (strcmp(argv[0], "iperf") == 0)) ? 1 : 0;
+	if (i >= argc) {
+		return (argc == 0) ? 0 : (print_help(), 0);
+	}
+
+	memset(settings, 0, sizeof(*settings));
+	settings->port = IPERF_PORT;
+	settings->listen_port = IPERF_PORT;
+	settings->parallel = 1;
+
+	for (; i < argc; i++) {
+		const char *opt = argv[i];
+		const char *val = NULL;
+
+		if ((opt[0] != '-') || (opt[1] == '\0') || (opt[2] != '\0')) {
+			goto bad;
+		}
+		if (strchr("cbtnliPpL", opt[1]) != NULL) {
+			/* Options with a value */
+			if (++i >= argc) {
+				goto bad;
+			}
+			val = argv[i];
+		}
+		switch (opt[1]) {
+		case 'c':
+			if (!ipaddr_aton(val, &settings->addr)) {
+				goto bad;
+			}
+			client = 1;
+			break;
+
+		case 's':
+			server = 1;
+			break;
+
+		case 'u':
+			settings->udp = 1;
+			break;
+
+		case 'r':
+			settings->mode = IPERF_MODE_TRADEOFF;
+			break;
+
+		case 'd':
+			settings->mode = IPERF_MODE_DUALTEST;
+			break;
+
+		case 'b':
+			if (parse_num(val, &settings->rate) || (settings->rate == 0)) {
+				goto bad;
+			}
+			settings->udp = 1;
+			break;
+
+		case 't':
+			if (parse_ms(val, &settings->time_ms)) {
+				goto bad;
+			}
+			break;
+
+		case 'n':
+			if (parse_num(val, &settings->amount)) {
+				goto bad;
+			}
+			break;
+
+		case 'l':
+			if (parse_num(val, &settings->len) || (settings->len == 0)) {
+				goto bad;
+			}
+			settings->len_set = 1;
+			break;
+
+		case 'i':
+			if (parse_ms(val, &settings->interval_ms)) {
+				goto bad;
+			}
+			break;
+
+		case 'P':
+			if (parse_num(val, &v) || (v == 0) || (v > IPERF_MAX_STREAMS)) {
+				goto bad;
+			}
+			settings->parallel = (u8_t) v;
+			break;
+
+		case 'p':
+		case 'L':
+			if (parse_num(val, &v) || (v == 0) || (v > 0xffff)) {
+				goto bad;
+			}
+			if (opt[1] == 'p') {
+				settings->port = (u16_t) v;
+			}
+			else {
+				settings->listen_port = (u16_t) v;
+			}
+			break;
+
+		default:
+			goto bad;
+		}
+	}
+
+	if (client == server) {
+		goto bad;
+	}
+	if (server) {
+		iperf_server_interval_ms = settings->interval_ms;
+		DEBUGOUT("Server reports every %lu ms\r\n", (unsigned long) iperf_server_interval_ms);
+		return 0;
+	}
+	return 1;
+
+bad:
+	print_help();
+	return -1;
+}
+
+/* Reads commands from the debug UART, without blocking */
+void iperf_console_poll(void)
+{
+	IPERF_SETTINGS_T settings;
+	int c;
+
+	while ((c = DEBUGIN()) != EOF) {
+		if ((c == '\r') || (c == '\n')) {
+			DEBUGSTR("\r\n");
+			cmd_line[cmd_len] = '\0';
+			cmd_len = 0;
+			if ((iperf_parse_cmd(cmd_line, &settings) == 1) && (iperf_client_start(&settings) < 0)) {
+				DEBUGSTR("iperf: test not started\r\n");
+			}
+		}
+		else if (((c == '\b') || (c == 0x7f)) && (cmd_len > 0)) {
+			cmd_len--;
+			DEBUGSTR("\b \b");
+		}
+		else if ((c >= ' ') && (cmd_len < (int) sizeof(cmd_line) - 1)) {
+			cmd_line[cmd_len++] = (char) c;
+			DEBUGOUT("%c", c);
+		}
+	}
+}
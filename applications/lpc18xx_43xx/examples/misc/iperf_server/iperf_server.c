@@ -1,264 +1,445 @@
+/*
+ * @brief iperf server and client on the lwIP raw API (standalone)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "lwip/opt.h"
 #include "lwip/debug.h"
 #include "lwip/stats.h"
 #include "lwip/tcp.h"
+#include "lwip/udp.h"
+#include "iperf.h"
+
+#if NO_SYS
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Times a UDP sender sends its last datagram, and the time between */
+#define IPERF_FIN_TRIES   10
+#define IPERF_FIN_US      250000
+
+static struct tcp_pcb *iperf_listen_pcb;
+static struct udp_pcb *iperf_udp_pcb;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static err_t iperf_tcp_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err);
+static err_t iperf_tcp_sent(void *arg, struct tcp_pcb *pcb, u16_t len);
+static err_t iperf_tcp_poll(void *arg, struct tcp_pcb *pcb);
+static void iperf_tcp_error(void *arg, err_t err);
+
+/* Closes the pcb of a TCP stream and hands the stream to the reports. If
+   the close fails for lack of memory the stream keeps its pcb, sends no
+   more and the close is tried again from the sent and poll callbacks. */
+static err_t iperf_tcp_end(IPERF_STREAM_T *s, struct tcp_pcb *pcb, u8_t error)
+{
+	if (pcb != NULL) {
+		if (!s->closing) {
+			s->closing = 1;
+			s->end_us = iperf_time_us();
+		}
+		s->error |= error;
+		tcp_arg(pcb, NULL);
+		tcp_recv(pcb, NULL);
+		tcp_sent(pcb, NULL);
+		tcp_poll(pcb, NULL, 0);
+		tcp_err(pcb, NULL);
+		if (tcp_close(pcb) != ERR_OK) {
+			tcp_arg(pcb, s);
+			tcp_recv(pcb, iperf_tcp_recv);
+			tcp_sent(pcb, iperf_tcp_sent);
+			tcp_poll(pcb, iperf_tcp_poll, 2);
+			tcp_err(pcb, iperf_tcp_error);
+			return ERR_OK;
+		}
+		error = s->error;
+	}
+	s->conn = NULL;
+	iperf_stream_done(s, error);
+	return ERR_OK;
+}
+
+/* Connection reset or aborted, the pcb is already freed */
+static void iperf_tcp_error(void *arg, err_t err)
+{
+	IPERF_STREAM_T *s = (IPERF_STREAM_T *) arg;
 
-/*---------------------------------------------------------------------------*/
-/* local defines                                                                                                                 */
-/*---------------------------------------------------------------------------*/
-#define IPERF_SERVER_PORT 5001
+	LWIP_UNUSED_ARG(err);
 
-/*---------------------------------------------------------------------------*/
-/* local data                                                                                                                    */
-/*---------------------------------------------------------------------------*/
-#if LWIP_TCP
+	if (s != NULL) {
+		iperf_tcp_end(s, NULL, 1);
+	}
+}
+
+/* Counts and drops the received data */
+static err_t iperf_tcp_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+	IPERF_STREAM_T *s = (IPERF_STREAM_T *) arg;
 
-static struct tcp_pcb *iperf_pcb;
+	if ((p != NULL) && s->closing) {
+		tcp_recved(pcb, p->tot_len);
+		pbuf_free(p);
+		return ERR_OK;
+	}
+	if ((p == NULL) || (err != ERR_OK) || s->closing) {
+		if (p != NULL) {
+			pbuf_free(p);
+		}
+		/* The client has sent everything */
+		return iperf_tcp_end(s, pcb, 0);
+	}
 
-enum iperfserver_states
+	if (s->hdr_len < sizeof(s->hdr)) {
+		s->hdr_len += pbuf_copy_partial(p, (u8_t *) &s->hdr + s->hdr_len,
+										sizeof(s->hdr) - s->hdr_len, 0);
+		if (s->hdr_len == sizeof(s->hdr)) {
+			iperf_stream_header(s);
+		}
+	}
+	iperf_stream_add(s, p->tot_len);
+	tcp_recved(pcb, p->tot_len);
+	pbuf_free(p);
+	return ERR_OK;
+}
+
+static err_t iperf_tcp_accept(void *arg, struct tcp_pcb *pcb, err_t err)
 {
-  ES_NONE = 0,
-  ES_ACCEPTED,
-  ES_RECEIVED,
-  ES_CLOSING
-};
+	IPERF_STREAM_T *s;
+
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(err);
 
-struct iperfserver_state
+	s = iperf_stream_new(0, 0, &pcb->remote_ip, pcb->remote_port);
+	if (s == NULL) {
+		return ERR_MEM;
+	}
+	s->conn = pcb;
+	tcp_arg(pcb, s);
+	tcp_recv(pcb, iperf_tcp_recv);
+	tcp_err(pcb, iperf_tcp_error);
+	return ERR_OK;
+}
+
+/* Queues pattern data by reference until the send buffer is full, and
+   closes the stream when it has sent its time or amount */
+static err_t iperf_tcp_send(IPERF_STREAM_T *s, struct tcp_pcb *pcb)
+{
+	u32_t len;
+
+	while (!iperf_stream_expired(s, iperf_time_us())) {
+		len = LWIP_MIN(tcp_sndbuf(pcb), IPERF_BUF_SZ);
+		len = iperf_stream_chunk(s, LWIP_MIN(len, s->test->settings.len));
+		if ((len == 0) || (tcp_write(pcb, iperf_buf, (u16_t) len, 0) != ERR_OK)) {
+			tcp_output(pcb);
+			return ERR_OK;
+		}
+		iperf_stream_add(s, len);
+	}
+	return iperf_tcp_end(s, pcb, 0);
+}
+
+static err_t iperf_tcp_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
 {
-  u8_t state;
-  u8_t retries;
-  struct tcp_pcb *pcb;
-  /* pbuf (chain) to recycle */
-  struct pbuf *p;
-};
-
-/*---------------------------------------------------------------------------*/
-/* local functions                                                                                                              */
-/*---------------------------------------------------------------------------*/
-static err_t iperfserver_accept(void *arg, struct tcp_pcb *newpcb, err_t err);
-static err_t iperfserver_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
-static void iperfserver_error(void *arg, err_t err);
-static err_t iperfserver_sent(void *arg, struct tcp_pcb *tpcb, u16_t len);
-static void iperfserver_send(struct tcp_pcb *tpcb, struct iperfserver_state *es);
-static void iperfserver_close(struct tcp_pcb *tpcb, struct iperfserver_state *es);
-
-void
-iperf_server_init(void)
+	IPERF_STREAM_T *s = (IPERF_STREAM_T *) arg;
+
+	LWIP_UNUSED_ARG(len);
+
+	if (s->closing) {
+		return iperf_tcp_end(s, pcb, 0);
+	}
+	return iperf_tcp_send(s, pcb);
+}
+
+static err_t iperf_tcp_connected(void *arg, struct tcp_pcb *pcb, err_t err)
 {
-  iperf_pcb = tcp_new();
-  if (iperf_pcb != NULL)
-  {
-    err_t err;
-
-    err = tcp_bind(iperf_pcb, IP_ADDR_ANY, IPERF_SERVER_PORT);
-    if (err == ERR_OK)
-    {
-      iperf_pcb = tcp_listen(iperf_pcb);
-      tcp_accept(iperf_pcb, iperfserver_accept);
-    }
-    else 
-    {
-      /* abort? output diagnostic? */
-    }
-  }
-  else
-  {
-    /* abort? output diagnostic? */
-  }
+	IPERF_STREAM_T *s = (IPERF_STREAM_T *) arg;
+
+	LWIP_UNUSED_ARG(err);
+
+	iperf_client_begin(s);
+	tcp_sent(pcb, iperf_tcp_sent);
+
+	/* The client header goes first, so the server can start the reverse test */
+	if (tcp_write(pcb, &s->hdr, sizeof(s->hdr), TCP_WRITE_FLAG_COPY) != ERR_OK) {
+		return iperf_tcp_end(s, pcb, 1);
+	}
+	iperf_stream_add(s, sizeof(s->hdr));
+	return iperf_tcp_send(s, pcb);
 }
 
+/* Sends the data that could not be queued from the callbacks */
+static err_t iperf_tcp_poll(void *arg, struct tcp_pcb *pcb)
+{
+	IPERF_STREAM_T *s = (IPERF_STREAM_T *) arg;
 
-err_t
-iperfserver_accept(void *arg, struct tcp_pcb *newpcb, err_t err)
+	if (s == NULL) {
+		return ERR_OK;
+	}
+	if (s->closing) {
+		return iperf_tcp_end(s, pcb, 0);
+	}
+	if (!s->connected) {
+		return ERR_OK;
+	}
+	return iperf_tcp_send(s, pcb);
+}
+
+/* Datagrams received on the server port */
+static void iperf_udp_server_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+								  ip_addr_t *addr, u16_t port)
 {
-  err_t ret_err;
-  struct iperfserver_state *es;
-
-  LWIP_UNUSED_ARG(arg);
-  LWIP_UNUSED_ARG(err);
-
-  /* commonly observed practive to call tcp_setprio(), why? */
-  tcp_setprio(newpcb, TCP_PRIO_MIN);
-
-  es = (struct iperfserver_state *)mem_malloc(sizeof(struct iperfserver_state));
-  if (es != NULL)
-  {
-    es->state = ES_ACCEPTED;
-    es->pcb = newpcb;
-    es->retries = 0;
-    es->p = NULL;
-    /* pass newly allocated es to our callbacks */
-    tcp_arg(newpcb, es);
-    tcp_recv(newpcb, iperfserver_recv);
-    tcp_err(newpcb, iperfserver_error);
-  
-    ret_err = ERR_OK;
-  }
-  else
-  {
-    ret_err = ERR_MEM;
-  }
-  return ret_err;  
+	u8_t data[sizeof(struct iperf_udp_hdr) + sizeof(struct iperf_client_hdr)];
+	struct pbuf *q;
+	int len;
+
+	LWIP_UNUSED_ARG(arg);
+
+	len = pbuf_copy_partial(p, data, sizeof(data), 0);
+	if (len == sizeof(data)) {
+		len = p->tot_len;
+	}
+	pbuf_free(p);
+
+	q = pbuf_alloc(PBUF_TRANSPORT, IPERF_UDP_ACK_LEN, PBUF_RAM);
+	if (q == NULL) {
+		return;
+	}
+	if (iperf_udp_input(data, len, addr, port, (u8_t *) q->payload) > 0) {
+		udp_sendto(pcb, q, addr, port);
+	}
+	pbuf_free(q);
 }
 
-err_t
-iperfserver_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+/* Server report received by a UDP sender */
+static void iperf_udp_client_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+								  ip_addr_t *addr, u16_t port)
 {
-  struct iperfserver_state *es;
-  err_t ret_err;
-  u16_t plen;
-
-  LWIP_ASSERT("arg != NULL",arg != NULL);
-  es = (struct iperfserver_state *)arg;
-  if (p == NULL)
-  {
-    /* remote host closed connection */
-    es->state = ES_CLOSING;
-    iperfserver_close(tpcb, es);    
-    ret_err = ERR_OK;   
-  }
-  else if(err != ERR_OK)
-  {
-    /* cleanup, for unkown reason */
-    if (p != NULL)
-    {
-      es->p = NULL;
-      pbuf_free(p);
-    }
-    ret_err = err;
-  }
-  else if(es->state == ES_ACCEPTED)
-  {
-    es->p = p;
-    plen = es->p->len;
-    pbuf_free(es->p);   //receive the package and discard it silently for testing reception bandwidth
-    tcp_recved(tpcb, plen); 
-   
-    ret_err = ERR_OK;
-  }
-  else if(es->state == ES_CLOSING)
-  {
-    /* odd case, remote side closing twice, trash data */
-    tcp_recved(tpcb, p->tot_len);
-    es->p = NULL;
-    pbuf_free(p);
-    ret_err = ERR_OK;
-  }
-  else
-  {
-    /* unkown es->state, trash data  */
-    tcp_recved(tpcb, p->tot_len);
-    es->p = NULL;
-    pbuf_free(p);
-    ret_err = ERR_OK;
-  }
-  return ret_err;
+	IPERF_STREAM_T *s = (IPERF_STREAM_T *) arg;
+	u8_t data[IPERF_UDP_ACK_LEN];
+	int len;
+
+	LWIP_UNUSED_ARG(addr);
+	LWIP_UNUSED_ARG(port);
+
+	len = pbuf_copy_partial(p, data, sizeof(data), 0);
+	pbuf_free(p);
+	if ((s->fin_tries > 0) && (len == sizeof(data))) {
+		iperf_udp_report(s, data, len);
+		udp_remove(pcb);
+		s->conn = NULL;
+		iperf_stream_done(s, 0);
+	}
 }
 
-void
-iperfserver_error(void *arg, err_t err)
+/* Sends one datagram of a UDP sender, the headers from RAM and the rest
+   by reference to the pattern */
+static err_t iperf_udp_send_one(IPERF_STREAM_T *s, u32_t now, u8_t fin)
 {
-  struct iperfserver_state *es;
+	u32_t hlen = sizeof(struct iperf_udp_hdr) + sizeof(struct iperf_client_hdr);
+	struct pbuf *p, *q;
+	s32_t id = s->next_id;
+	err_t err;
+	int len;
 
-  LWIP_UNUSED_ARG(err);
+	p = pbuf_alloc(PBUF_TRANSPORT, hlen, PBUF_RAM);
+	if (p == NULL) {
+		return ERR_MEM;
+	}
+	len = iperf_udp_datagram(s, (u8_t *) p->payload, now, fin);
+	q = pbuf_alloc(PBUF_RAW, len - hlen, PBUF_ROM);
+	if (q == NULL) {
+		pbuf_free(p);
+		s->next_id = id;
+		return ERR_MEM;
+	}
+	q->payload = iperf_buf;
+	pbuf_cat(p, q);
 
-  es = (struct iperfserver_state *)arg;
-  if (es != NULL)
-  {
-    mem_free(es);
-  }
+	err = udp_send((struct udp_pcb *) s->conn, p);
+	pbuf_free(p);
+	if (err != ERR_OK) {
+		s->next_id = id;
+		return err;
+	}
+	if (!fin) {
+		iperf_stream_add(s, len);
+	}
+	return ERR_OK;
 }
 
-err_t
-iperfserver_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+/* Paces a UDP sender to its rate, then sends the last datagram until the
+   server report arrives */
+static void iperf_udp_client_poll(IPERF_STREAM_T *s, u32_t now)
 {
-  struct iperfserver_state *es;
-
-  LWIP_UNUSED_ARG(len);
-
-  es = (struct iperfserver_state *)arg;
-  es->retries = 0;
-  
-  if(es->p != NULL)
-  {
-    /* still got pbufs to send */
-    tcp_sent(tpcb, iperfserver_sent);
-    iperfserver_send(tpcb, es);
-  }
-  else
-  {
-    /* no more pbufs to send */
-    if(es->state == ES_CLOSING)
-    {
-      iperfserver_close(tpcb, es);
-    }
-  }
-  return ERR_OK;
+	int burst;
+
+	if (s->fin_tries == 0) {
+		for (burst = 0; (burst < IPERF_UDP_BURST) && !iperf_stream_expired(s, now); burst++) {
+			if (((s32_t) (now - s->next_us) < 0) || (iperf_udp_send_one(s, now, 0) != ERR_OK)) {
+				return;
+			}
+			s->next_us += s->ipg_us;
+		}
+		if (!iperf_stream_expired(s, now)) {
+			return;
+		}
+		s->end_us = now;
+	}
+	else if ((now - s->fin_us) < IPERF_FIN_US) {
+		return;
+	}
+	else if (s->fin_tries >= IPERF_FIN_TRIES) {
+		udp_remove((struct udp_pcb *) s->conn);
+		s->conn = NULL;
+		iperf_stream_done(s, 0);
+		return;
+	}
+
+	if (iperf_udp_send_one(s, now, 1) == ERR_OK) {
+		s->fin_us = now;
+		s->fin_tries++;
+	}
 }
 
-void
-iperfserver_send(struct tcp_pcb *tpcb, struct iperfserver_state *es)
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Starts the iperf server */
+void iperf_server_init(void)
 {
-  struct pbuf *ptr;
-  err_t wr_err = ERR_OK;
- 
-  while ((wr_err == ERR_OK) &&
-         (es->p != NULL) && 
-         (es->p->len <= tcp_sndbuf(tpcb)))
-  {
-  ptr = es->p;
-
-  /* enqueue data for transmission */
-  wr_err = tcp_write(tpcb, ptr->payload, ptr->len, TCP_WRITE_FLAG_COPY);
-  if (wr_err == ERR_OK)
-  {
-     u16_t plen;
-      u8_t freed;
-
-     plen = ptr->len;
-     /* continue with next pbuf in chain (if any) */
-     es->p = ptr->next;
-     if(es->p != NULL)
-     {
-       /* new reference! */
-       pbuf_ref(es->p);
-     }
-     /* chop first pbuf from chain */
-      do
-      {
-        /* try hard to free pbuf */
-        freed = pbuf_free(ptr);
-      }
-      while(freed == 0);
-     /* we can read more data now */
-     tcp_recved(tpcb, plen);
-   }
-   else if(wr_err == ERR_MEM)
-   {
-      /* we are low on memory, try later / harder, defer to poll */
-     es->p = ptr;
-   }
-   else
-   {
-     /* other problem ?? */
-   }
-  }
+	iperf_report_init();
+
+	iperf_listen_pcb = tcp_new();
+	if ((iperf_listen_pcb == NULL) || (tcp_bind(iperf_listen_pcb, IP_ADDR_ANY, IPERF_PORT) != ERR_OK)) {
+		LWIP_DEBUGF(LWIP_DBG_ON, ("iperf: TCP port %u not available\n", IPERF_PORT));
+	}
+	else {
+		iperf_listen_pcb = tcp_listen(iperf_listen_pcb);
+		tcp_accept(iperf_listen_pcb, iperf_tcp_accept);
+	}
+
+	iperf_udp_pcb = udp_new();
+	if ((iperf_udp_pcb == NULL) || (udp_bind(iperf_udp_pcb, IP_ADDR_ANY, IPERF_PORT) != ERR_OK)) {
+		LWIP_DEBUGF(LWIP_DBG_ON, ("iperf: UDP port %u not available\n", IPERF_PORT));
+	}
+	else {
+		udp_recv(iperf_udp_pcb, iperf_udp_server_recv, NULL);
+	}
 }
 
-void
-iperfserver_close(struct tcp_pcb *tpcb, struct iperfserver_state *es)
+/* Runs the UDP senders, the TCP sender timers, the reports and the
+   commands */
+void iperf_poll(void)
 {
-  tcp_arg(tpcb, NULL);
-  tcp_sent(tpcb, NULL);
-  tcp_recv(tpcb, NULL);
-  tcp_err(tpcb, NULL);
- 
-  
-  if (es != NULL)
-  {
-    mem_free(es);
-  }  
-  tcp_close(tpcb);
+	IPERF_STREAM_T *s;
+	u32_t now = iperf_time_us();
+	int i;
+
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		s = &iperf_streams[i];
+		if ((s->state != IPERF_STREAM_RUNNING) || !s->sender || !s->connected ||
+			s->closing) {
+			continue;
+		}
+		if (s->udp) {
+			iperf_udp_client_poll(s, now);
+		}
+		else if (iperf_stream_expired(s, now)) {
+			/* A sender waiting for window space stops on time */
+			iperf_tcp_end(s, (struct tcp_pcb *) s->conn, 0);
+		}
+	}
+
+	iperf_report_poll();
+	iperf_console_poll();
 }
 
-#endif /* LWIP_TCP */
+/* Starts a client test */
+int iperf_client_start(const IPERF_SETTINGS_T *settings)
+{
+	IPERF_TEST_T *t = iperf_client_test(settings);
+	IPERF_STREAM_T *s;
+	struct tcp_pcb *tpcb;
+	struct udp_pcb *upcb;
+	int i;
+
+	if (t == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		s = &iperf_streams[i];
+		if ((s->state != IPERF_STREAM_RUNNING) || (s->test != t)) {
+			continue;
+		}
+
+		if (s->udp) {
+			upcb = udp_new();
+			if ((upcb == NULL) || (udp_connect(upcb, &s->addr, s->port) != ERR_OK)) {
+				if (upcb != NULL) {
+					udp_remove(upcb);
+				}
+				iperf_stream_done(s, 1);
+				continue;
+			}
+			udp_recv(upcb, iperf_udp_client_recv, s);
+			s->conn = upcb;
+			iperf_client_begin(s);
+		}
+		else {
+			tpcb = tcp_new();
+			if (tpcb == NULL) {
+				iperf_stream_done(s, 1);
+				continue;
+			}
+			s->conn = tpcb;
+			tcp_arg(tpcb, s);
+			tcp_err(tpcb, iperf_tcp_error);
+			tcp_poll(tpcb, iperf_tcp_poll, 2);
+			if (tcp_connect(tpcb, &s->addr, s->port, iperf_tcp_connected) != ERR_OK) {
+				tcp_arg(tpcb, NULL);
+				tcp_abort(tpcb);
+				iperf_tcp_end(s, NULL, 1);
+			}
+		}
+	}
+	return 0;
+}
 
+#endif /* NO_SYS */
@@ -0,0 +1,391 @@
+/*
+ * @brief iperf server and client on the lwIP sockets API (FreeRTOS)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "lwip/opt.h"
+#include "lwip/debug.h"
+#include "lwip/sys.h"
+#include "lwip/api.h"
+#include "lwip/sockets.h"
+#include "iperf.h"
+
+#if !NO_SYS
+
+#if !LWIP_SOCKET || !LWIP_SO_RCVTIMEO
+#error "The iperf sockets engine needs LWIP_SOCKET and LWIP_SO_RCVTIMEO"
+#endif
+
+#if IPERF_SOCK_WORKERS < IPERF_MAX_STREAMS
+#error "IPERF_SOCK_WORKERS must not be below IPERF_MAX_STREAMS"
+#endif
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Times a UDP sender sends its last datagram, and the time between */
+#define IPERF_FIN_TRIES   10
+#define IPERF_FIN_MS      250
+
+/* Receive timeout of the UDP server port, the longest time between two
+   polls of the reports and the UART */
+#define IPERF_POLL_MS     10
+
+/* A received TCP stream idle this long is over, so a client that
+   vanished does not keep its worker */
+#define IPERF_IDLE_MS     10000
+
+/* Per-worker state; each worker owns its data buffer */
+typedef struct {
+	u8_t buf[IPERF_BUF_SZ];
+} IPERF_WORKER_T;
+
+static IPERF_WORKER_T iperf_workers[IPERF_SOCK_WORKERS];
+
+/* Streams waiting for a worker */
+static sys_mbox_t iperf_queue;
+
+static int iperf_listen_sock = -1;
+static struct netconn *iperf_udp_conn;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void iperf_sock_addr(struct sockaddr_in *sa, const ip_addr_t *addr, u16_t port)
+{
+	memset(sa, 0, sizeof(*sa));
+	sa->sin_len = sizeof(*sa);
+	sa->sin_family = AF_INET;
+	sa->sin_port = htons(port);
+	inet_addr_from_ipaddr(&sa->sin_addr, addr);
+}
+
+/* Counts and drops the data of an accepted connection */
+static void iperf_sock_tcp_recv(IPERF_STREAM_T *s, u8_t *buf)
+{
+	int len, n, idle = IPERF_IDLE_MS;
+
+	lwip_setsockopt(s->sock, SOL_SOCKET, SO_RCVTIMEO, &idle, sizeof(idle));
+	while ((len = lwip_recv(s->sock, buf, IPERF_BUF_SZ, 0)) > 0) {
+		if (s->hdr_len < sizeof(s->hdr)) {
+			n = LWIP_MIN(len, (int) (sizeof(s->hdr) - s->hdr_len));
+			memcpy((u8_t *) &s->hdr + s->hdr_len, buf, n);
+			s->hdr_len += n;
+			if (s->hdr_len == sizeof(s->hdr)) {
+				iperf_stream_header(s);
+			}
+		}
+		iperf_stream_add(s, len);
+	}
+
+	/* 0 when the client has sent everything */
+	lwip_close(s->sock);
+	s->sock = -1;
+	iperf_stream_done(s, len < 0);
+}
+
+/* Connects a TCP sender and sends the pattern until it has sent its time
+   or amount */
+static void iperf_sock_tcp_send(IPERF_STREAM_T *s)
+{
+	struct sockaddr_in to;
+	int len, error = 1;
+
+	s->sock = lwip_socket(AF_INET, SOCK_STREAM, 0);
+	iperf_sock_addr(&to, &s->addr, s->port);
+	if ((s->sock >= 0) && (lwip_connect(s->sock, (struct sockaddr *) &to, sizeof(to)) == 0)) {
+		iperf_client_begin(s);
+
+		/* The client header goes first, so the server can start the reverse test */
+		if (lwip_send(s->sock, &s->hdr, sizeof(s->hdr), MSG_MORE) == sizeof(s->hdr)) {
+			iperf_stream_add(s, sizeof(s->hdr));
+			error = 0;
+		}
+		while (!error && !iperf_stream_expired(s, iperf_time_us())) {
+			len = iperf_stream_chunk(s, LWIP_MIN(s->test->settings.len, IPERF_BUF_SZ));
+			if (lwip_send(s->sock, iperf_buf, len, 0) != len) {
+				error = 1;
+			}
+			else {
+				iperf_stream_add(s, len);
+			}
+		}
+	}
+
+	if (s->sock >= 0) {
+		lwip_close(s->sock);
+		s->sock = -1;
+	}
+	iperf_stream_done(s, error);
+}
+
+/* Paces a UDP sender to its rate, then sends the last datagram until the
+   server report arrives */
+static void iperf_sock_udp_send(IPERF_STREAM_T *s, u8_t *buf)
+{
+	u8_t ack[IPERF_UDP_ACK_LEN];
+	struct sockaddr_in to;
+	int len, timeout = IPERF_FIN_MS;
+	s32_t id;
+	u32_t now;
+
+	s->sock = lwip_socket(AF_INET, SOCK_DGRAM, 0);
+	iperf_sock_addr(&to, &s->addr, s->port);
+	if ((s->sock < 0) || (lwip_connect(s->sock, (struct sockaddr *) &to, sizeof(to)) != 0)) {
+		if (s->sock >= 0) {
+			lwip_close(s->sock);
+			s->sock = -1;
+		}
+		iperf_stream_done(s, 1);
+		return;
+	}
+
+	/* The headers are written over the start of the pattern */
+	memcpy(buf, iperf_buf, IPERF_BUF_SZ);
+	iperf_client_begin(s);
+
+	for (now = s->start_us; !iperf_stream_expired(s, now); now = iperf_time_us()) {
+		/* Sleep when more than a tick ahead, the rest is sent in bursts */
+		if ((s32_t) (s->next_us - now) >= 1000) {
+			sys_msleep((s->next_us - now) / 1000);
+			continue;
+		}
+		id = s->next_id;
+		len = iperf_udp_datagram(s, buf, now, 0);
+		if (lwip_send(s->sock, buf, len, 0) != len) {
+			/* Out of buffers, let the EMAC catch up */
+			s->next_id = id;
+			sys_msleep(1);
+			continue;
+		}
+		iperf_stream_add(s, len);
+		s->next_us += s->ipg_us;
+	}
+	s->end_us = now;
+
+	lwip_setsockopt(s->sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	while (!s->has_report && (s->fin_tries < IPERF_FIN_TRIES)) {
+		len = iperf_udp_datagram(s, buf, iperf_time_us(), 1);
+		lwip_send(s->sock, buf, len, 0);
+		s->fin_tries++;
+		len = lwip_recv(s->sock, ack, sizeof(ack), 0);
+		if (len == sizeof(ack)) {
+			iperf_udp_report(s, ack, len);
+		}
+	}
+
+	lwip_close(s->sock);
+	s->sock = -1;
+	iperf_stream_done(s, 0);
+}
+
+/* Worker thread: runs the streams taken from the queue, never returns */
+static void iperf_sock_worker(void *arg)
+{
+	IPERF_WORKER_T *worker = (IPERF_WORKER_T *) arg;
+	IPERF_STREAM_T *s;
+
+	while (1) {
+		sys_arch_mbox_fetch(&iperf_queue, (void **) &s, 0);
+
+		if (!s->sender) {
+			iperf_sock_tcp_recv(s, worker->buf);
+		}
+		else if (s->udp) {
+			iperf_sock_udp_send(s, worker->buf);
+		}
+		else {
+			iperf_sock_tcp_send(s);
+		}
+	}
+}
+
+/* Accepts TCP connections and queues them for the workers, never returns */
+static void iperf_sock_listen_thread(void *arg)
+{
+	struct sockaddr_in from;
+	socklen_t fromlen;
+	IPERF_STREAM_T *s;
+	ip_addr_t addr;
+	int sock;
+
+	LWIP_UNUSED_ARG(arg);
+
+	while (1) {
+		fromlen = sizeof(from);
+		sock = lwip_accept(iperf_listen_sock, (struct sockaddr *) &from, &fromlen);
+		if (sock < 0) {
+			continue;
+		}
+
+		inet_addr_to_ipaddr(&addr, &from.sin_addr);
+		s = iperf_stream_new(0, 0, &addr, ntohs(from.sin_port));
+		if (s == NULL) {
+			lwip_close(sock);
+			continue;
+		}
+		s->sock = sock;
+		if (sys_mbox_trypost(&iperf_queue, s) != ERR_OK) {
+			/* All workers busy and the queue full */
+			lwip_close(sock);
+			s->sock = -1;
+			iperf_stream_done(s, 1);
+		}
+	}
+}
+
+/* Handles a datagram received on the UDP server port */
+static void iperf_sock_udp_input(struct netbuf *inbuf)
+{
+	u8_t data[sizeof(struct iperf_udp_hdr) + sizeof(struct iperf_client_hdr)];
+	struct netbuf *ack;
+	int len;
+
+	len = netbuf_copy(inbuf, data, sizeof(data));
+	if (len == sizeof(data)) {
+		len = netbuf_len(inbuf);
+	}
+
+	ack = netbuf_new();
+	if (ack == NULL) {
+		return;
+	}
+	if ((netbuf_alloc(ack, IPERF_UDP_ACK_LEN) != NULL) &&
+		(iperf_udp_input(data, len, netbuf_fromaddr(inbuf), netbuf_fromport(inbuf),
+						 (u8_t *) ack->p->payload) > 0)) {
+		netconn_sendto(iperf_udp_conn, ack, netbuf_fromaddr(inbuf), netbuf_fromport(inbuf));
+	}
+	netbuf_delete(ack);
+}
+
+/* Receives the UDP streams, prints the reports and runs the UART
+   commands, never returns */
+static void iperf_sock_thread(void *arg)
+{
+	struct netbuf *inbuf;
+
+	LWIP_UNUSED_ARG(arg);
+
+	while (1) {
+		if (iperf_udp_conn == NULL) {
+			sys_msleep(IPERF_POLL_MS);
+		}
+		else if (netconn_recv(iperf_udp_conn, &inbuf) == ERR_OK) {
+			iperf_sock_udp_input(inbuf);
+			netbuf_delete(inbuf);
+		}
+
+		iperf_report_poll();
+		iperf_console_poll();
+	}
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Starts the iperf server threads */
+void iperf_server_init(void)
+{
+	struct sockaddr_in sa;
+	int i;
+
+	iperf_report_init();
+
+	if (sys_mbox_new(&iperf_queue, IPERF_MAX_STREAMS) != ERR_OK) {
+		LWIP_DEBUGF(LWIP_DBG_ON, ("iperf: Unable to create the stream queue\n"));
+		return;
+	}
+	for (i = 0; i < IPERF_SOCK_WORKERS; i++) {
+		sys_thread_new("iperf_worker", iperf_sock_worker, &iperf_workers[i],
+					   IPERF_SOCK_STACKSIZE, IPERF_SOCK_PRIO);
+	}
+
+	iperf_listen_sock = lwip_socket(AF_INET, SOCK_STREAM, 0);
+	iperf_sock_addr(&sa, IP_ADDR_ANY, IPERF_PORT);
+	if ((iperf_listen_sock < 0) || (lwip_bind(iperf_listen_sock, (struct sockaddr *) &sa, sizeof(sa)) != 0) ||
+		(lwip_listen(iperf_listen_sock, IPERF_MAX_STREAMS) != 0)) {
+		LWIP_DEBUGF(LWIP_DBG_ON, ("iperf: TCP port %u not available\n", IPERF_PORT));
+	}
+	else {
+		sys_thread_new("iperf_listen", iperf_sock_listen_thread, NULL,
+					   IPERF_SOCK_STACKSIZE, IPERF_SOCK_PRIO);
+	}
+
+	/* The UDP server port uses the netconn API, which hands over each
+	   datagram without copying it and with its full length. Sockets
+	   truncate a datagram to the receive buffer. */
+	iperf_udp_conn = netconn_new(NETCONN_UDP);
+	if ((iperf_udp_conn == NULL) || (netconn_bind(iperf_udp_conn, IP_ADDR_ANY, IPERF_PORT) != ERR_OK)) {
+		LWIP_DEBUGF(LWIP_DBG_ON, ("iperf: UDP port %u not available\n", IPERF_PORT));
+		if (iperf_udp_conn != NULL) {
+			netconn_delete(iperf_udp_conn);
+			iperf_udp_conn = NULL;
+		}
+	}
+	else {
+		netconn_set_recvtimeout(iperf_udp_conn, IPERF_POLL_MS);
+	}
+
+	/* The reports and the UART run in the UDP server thread, so it is
+	   started even without the UDP port */
+	sys_thread_new("iperf", iperf_sock_thread, NULL, IPERF_SOCK_STACKSIZE + 256, IPERF_SOCK_PRIO);
+}
+
+/* Starts a client test */
+int iperf_client_start(const IPERF_SETTINGS_T *settings)
+{
+	IPERF_TEST_T *t = iperf_client_test(settings);
+	IPERF_STREAM_T *s;
+	int i;
+
+	if (t == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < IPERF_MAX_STREAMS; i++) {
+		s = &iperf_streams[i];
+		if ((s->state != IPERF_STREAM_RUNNING) || (s->test != t)) {
+			continue;
+		}
+		if (sys_mbox_trypost(&iperf_queue, s) != ERR_OK) {
+			iperf_stream_done(s, 1);
+		}
+	}
+	return 0;
+}
+
+#endif /* !NO_SYS */
@@ -32,14 +32,20 @@
 #ifndef __LWIPOPTS_H_
 #define __LWIPOPTS_H_
 
-/* Standalone build */
+/* Select NO_SYS based on OS or Non OS configuration. The standalone build
+   uses the raw API engine (iperf_server.c), the FreeRTOS build the sockets
+   engine (iperf_sock.c). */
+#ifdef OS_FREE_RTOS
+#define NO_SYS                          0
+#else
 #define NO_SYS                          1
+#endif
 
 /* Use LWIP timers */
 #define NO_SYS_NO_TIMERS                0
 
 /* Need for memory protection */
-#define SYS_LIGHTWEIGHT_PROT            0
+#define SYS_LIGHTWEIGHT_PROT            (NO_SYS == 0)
 
 /* 32-bit alignment */
 #define MEM_ALIGNMENT                   4
@@ -55,8 +61,24 @@
 #define IP_SOF_BROADCAST                1
 #define IP_SOF_BROADCAST_RECV           1
 
+/* Checksum profile. With LPC_CHECKSUM_OFFLOAD set to 1, the EMAC inserts
+   and verifies the IP, UDP, TCP, and ICMP checksums and lwIP skips them.
+   Set it to 0 to compute all checksums in software. Note that UDP datagrams
+   fragmented by lwIP are sent without a UDP checksum when offloaded. */
+#define LPC_CHECKSUM_OFFLOAD            1
+
+#if LPC_CHECKSUM_OFFLOAD
+#define CHECKSUM_GEN_IP                 0
+#define CHECKSUM_GEN_UDP                0
+#define CHECKSUM_GEN_TCP                0
+#define CHECKSUM_GEN_ICMP               0
+#define CHECKSUM_CHECK_IP               0
+#define CHECKSUM_CHECK_UDP              0
+#define CHECKSUM_CHECK_TCP              0
+#define LWIP_CHECKSUM_ON_COPY           0
+#else
 /* The ethernet FCS is performed in hardware. The IP, TCP, and UDP
-   CRCs still need to be done in hardware. */
+   CRCs still need to be done in software. */
 #define CHECKSUM_GEN_IP                 1
 #define CHECKSUM_GEN_UDP                1
 #define CHECKSUM_GEN_TCP                1
@@ -64,6 +86,7 @@
 #define CHECKSUM_CHECK_UDP              1
 #define CHECKSUM_CHECK_TCP              1
 #define LWIP_CHECKSUM_ON_COPY           1
+#endif
 
 /* Use LWIP version of htonx() to allow generic functionality across
    all platforms. If you are using the Cortex Mx devices, you might
@@ -85,18 +108,30 @@
 
 #define LWIP_BROADCAST_PING             1
 
-/* MSS should match the hardware packet size */
+/* Queue every packet sent while the ARP request is out, not only the
+   last one, so the SYNs of parallel iperf streams (-P) to a new host are
+   not lost to a 3 second retransmission */
+#define ARP_QUEUEING                    1
+
+/* MSS should match the hardware packet size. The send buffer holds
+   enough segments to keep an iperf client stream (-c) going. */
 #define TCP_MSS                         1460
-#define TCP_SND_BUF                     (2 * TCP_MSS)
+#define TCP_SND_BUF                     (4 * TCP_MSS)
 
-#define LWIP_SOCKET                     0
-#define LWIP_NETCONN                    0
+#define LWIP_SOCKET                     (NO_SYS == 0)
+#define LWIP_NETCONN                    (NO_SYS == 0)
+#define LWIP_SO_RCVTIMEO                (NO_SYS == 0)
 #define MEMP_NUM_SYS_TIMEOUT            300
 
 #define LWIP_STATS                      0
 #define LINK_STATS                      0
 #define LWIP_STATS_DISPLAY              0
 
+/* Set to 1 to collect DWT cycle counts for the lwIP PERF_START/PERF_STOP
+   probes (ip_input, tcp_input, udp_input, pbuf_free) and the EMAC driver.
+   Call lpc_perf_dump() to print them on the debug UART. */
+#define LWIP_PERF                       0
+
 /* There are more *_DEBUG options that can be selected.
    See opts.h. Make sure that LWIP_DEBUG is defined when
    building the code to use debug. */
@@ -115,6 +150,33 @@
 #define MEM_LIBC_MALLOC                 1
 #define MEMP_MEM_MALLOC                 1
 
+#if !NO_SYS
+/* Sockets for the iperf listener, the UDP server port and every stream
+   (IPERF_MAX_STREAMS), plus a spare */
+#define MEMP_NUM_NETCONN                12
+
+#define DEFAULT_THREAD_PRIO             (tskIDLE_PRIORITY + 1)
+#define DEFAULT_THREAD_STACKSIZE        (512)
+#define DEFAULT_ACCEPTMBOX_SIZE         6
+#define DEFAULT_TCP_RECVMBOX_SIZE       6
+
+/* Room for a burst of datagrams on the iperf UDP server port */
+#define DEFAULT_UDP_RECVMBOX_SIZE       16
+
+/* TCPIP thread must run at higher priority than MAC threads! */
+#define TCPIP_THREAD_PRIO               (DEFAULT_THREAD_PRIO + configMAX_PRIORITIES - 1)
+#define TCPIP_THREAD_STACKSIZE          (512)
+/* Received frames and the socket calls of every stream queue here, a
+   frame that does not fit is dropped. With 6 entries, parallel streams
+   lost ACKs and stalled for a retransmission timeout. */
+#define TCPIP_MBOX_SIZE                 24
+
+/* BASEPRI based SYS_ARCH_PROTECT, see arch/sys_arch.h. SYS_ARCH_FAST_MBOX
+   must stay off, its mailboxes take a single receiving task and the iperf
+   workers share one. */
+#define SYS_ARCH_BASEPRI_PROTECT        1
+#endif
+
 /* Required for malloc/free */
 #include <stdlib.h>
 
@@ -47,7 +47,13 @@
 #include "lpc_phy.h"
 #include "arch/lpc18xx_43xx_emac.h"
 #include "arch/lpc_arch.h"
+#include "iperf.h"
+
+#ifdef OS_FREE_RTOS
+#include "arch/sys_arch.h"
+#else
 #include "echo.h"
+#endif
 
 /*****************************************************************************
  * Private types/enumerations/variables
@@ -74,14 +80,168 @@ static void prvSetupHardware(void)
 	/* Initial LED state is off to show an unconnected cable state */
 	Board_LED_Set(0, false);
 
+#ifndef OS_FREE_RTOS
 	/* Setup a 1mS sysTick for the primary time base */
 	SysTick_Enable(1);
+#endif
+}
+
+#ifdef OS_FREE_RTOS
+/* Callback for TCPIP thread to indicate TCPIP init is done */
+static void tcpip_init_done_signal(void *arg)
+{
+	/* Tell main thread TCP/IP init is done */
+	*(s32_t *) arg = 1;
+}
+
+/* LWIP kickoff and PHY link monitor thread */
+static void vSetupIFTask(void *pvParameters) {
+	ip_addr_t ipaddr, netmask, gw;
+	volatile s32_t tcpipdone = 0;
+	uint32_t physts;
+	static int prt_ip = 0;
+
+	/* Wait until the TCP/IP thread is finished before
+	   continuing or wierd things may happen */
+	LWIP_DEBUGF(LWIP_DBG_ON, ("Waiting for TCPIP thread to initialize...\n"));
+	tcpip_init(tcpip_init_done_signal, (void *) &tcpipdone);
+	while (!tcpipdone) {
+		msDelay(1);
+	}
+
+	LWIP_DEBUGF(LWIP_DBG_ON, ("Starting LWIP iperf server...\n"));
+
+	/* Static IP assignment */
+#if LWIP_DHCP
+	IP4_ADDR(&gw, 0, 0, 0, 0);
+	IP4_ADDR(&ipaddr, 0, 0, 0, 0);
+	IP4_ADDR(&netmask, 0, 0, 0, 0);
+#else
+	IP4_ADDR(&gw, 10, 1, 10, 1);
+	IP4_ADDR(&ipaddr, 10, 1, 10, 234);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+#endif
+
+	/* Add netif interface for lpc18xx_43xx */
+	if (!netif_add(&lpc_netif, &ipaddr, &netmask, &gw, NULL, lpc_enetif_init,
+				   tcpip_input)) {
+		LWIP_ASSERT("Net interface failed to initialize\r\n", 0);
+	}
+	netif_set_default(&lpc_netif);
+	netif_set_up(&lpc_netif);
+
+	/* Enable MAC interrupts only after LWIP is ready */
+	NVIC_SetPriority(ETHERNET_IRQn, config_ETHERNET_INTERRUPT_PRIORITY);
+	NVIC_EnableIRQ(ETHERNET_IRQn);
+
+#if LWIP_DHCP
+	dhcp_start(&lpc_netif);
+#endif
+
+	/* Initialize and start application, the iperf threads also read
+	   the commands on the debug UART */
+	iperf_server_init();
+
+	/* This loop monitors the PHY link and will handle cable events
+	   via the PHY driver. */
+	while (1) {
+		/* Call the PHY status update state machine once in a while
+		   to keep the link status up-to-date */
+		physts = lpcPHYStsPoll();
+
+		/* Only check for connection state when the PHY status has changed */
+		if (physts & PHY_LINK_CHANGED) {
+			if (physts & PHY_LINK_CONNECTED) {
+				Board_LED_Set(0, true);
+				prt_ip = 0;
+
+				/* Set interface speed and duplex */
+				if (physts & PHY_LINK_SPEED100) {
+					Chip_ENET_SetSpeed(LPC_ETHERNET, 1);
+					NETIF_INIT_SNMP(&lpc_netif, snmp_ifType_ethernet_csmacd, 100000000);
+				}
+				else {
+					Chip_ENET_SetSpeed(LPC_ETHERNET, 0);
+					NETIF_INIT_SNMP(&lpc_netif, snmp_ifType_ethernet_csmacd, 10000000);
+				}
+				if (physts & PHY_LINK_FULLDUPLX) {
+					Chip_ENET_SetDuplex(LPC_ETHERNET, true);
+				}
+				else {
+					Chip_ENET_SetDuplex(LPC_ETHERNET, false);
+				}
+
+				tcpip_callback_with_block((tcpip_callback_fn) netif_set_link_up,
+										  (void *) &lpc_netif, 1);
+			}
+			else {
+				Board_LED_Set(0, false);
+				tcpip_callback_with_block((tcpip_callback_fn) netif_set_link_down,
+										  (void *) &lpc_netif, 1);
+			}
+
+			DEBUGOUT("Link connect status: %d\r\n", ((physts & PHY_LINK_CONNECTED) != 0));
+
+			/* Delay for link detection (250mS) */
+			vTaskDelay(configTICK_RATE_HZ / 4);
+		}
+
+		/* Print IP address info */
+		if (!prt_ip) {
+			if (lpc_netif.ip_addr.addr) {
+				static char tmp_buff[16];
+				DEBUGOUT("IP_ADDR    : %s\r\n", ipaddr_ntoa_r((const ip_addr_t *) &lpc_netif.ip_addr, tmp_buff, 16));
+				DEBUGOUT("NET_MASK   : %s\r\n", ipaddr_ntoa_r((const ip_addr_t *) &lpc_netif.netmask, tmp_buff, 16));
+				DEBUGOUT("GATEWAY_IP : %s\r\n", ipaddr_ntoa_r((const ip_addr_t *) &lpc_netif.gw, tmp_buff, 16));
+				prt_ip = 1;
+			}
+		}
+
+		/* The iperf threads run at the same priority, leave them the CPU */
+		msDelay(10);
+	}
 }
 
+#endif /* OS_FREE_RTOS */
+
 /*****************************************************************************
  * Public functions
  ****************************************************************************/
 
+#ifdef OS_FREE_RTOS
+/**
+ * @brief	MilliSecond delay function based on FreeRTOS
+ * @param	ms	: Number of milliSeconds to delay
+ * @return	Nothing
+ * Needed for some functions, do not use prior to FreeRTOS running
+ */
+void msDelay(uint32_t ms)
+{
+	vTaskDelay((configTICK_RATE_HZ * ms) / 1000);
+}
+
+/**
+ * @brief	main routine for the iperf server with FreeRTOS
+ * @return	Function should not exit
+ */
+int main(void)
+{
+	prvSetupHardware();
+
+	/* Add another thread for initializing physical interface. This
+	   is delayed from the main LWIP initialization. */
+	xTaskCreate(vSetupIFTask, (signed char *) "SetupIFx",
+				configMINIMAL_STACK_SIZE, NULL, (tskIDLE_PRIORITY + 1UL),
+				(xTaskHandle *) NULL);
+
+	/* Start the scheduler */
+	vTaskStartScheduler();
+
+	/* Should never arrive here */
+	return 1;
+}
+
+#else
 /**
  * @brief	main routine for example_lwip_tcpecho_sa_18xx43xx
  * @return	Function should not exit.
@@ -146,6 +306,9 @@ int main(void)
 		/* LWIP timers - ARP, DHCP, TCP, etc. */
 		sys_check_timeouts();
 
+		/* iperf senders, reports and commands on the debug UART */
+		iperf_poll();
+
 		/* Call the PHY status update state machine once in a while
 		   to keep the link status up-to-date */
 		physts = lpcPHYStsPoll();
@@ -188,3 +351,5 @@ int main(void)
 	/* Never returns, for warning only */
 	return 0;
 }
+
+#endif /* OS_FREE_RTOS */
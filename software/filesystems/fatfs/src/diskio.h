@@ -66,6 +66,7 @@ DRESULT disk_ioctl (BYTE, BYTE, void*);
 #define MMC_GET_CID			12	/* Get CID */
 #define MMC_GET_OCR			13	/* Get OCR */
 #define MMC_GET_SDSTAT		14	/* Get SD status */
+#define MMC_GET_BOUNCE		15	/* Get bounce buffer statistics (DWORD[3]: bounced transfers, bounced sectors, direct transfers) */
 
 /* ATA/CF specific ioctl command */
 #define ATA_GET_REV			20	/* Get F/W revision */
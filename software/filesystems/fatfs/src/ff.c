@@ -136,6 +136,23 @@
 #define	ABORT(fs, res)		{ fp->flag |= FA__ERROR; LEAVE_FF(fs, res); }
 
 
+/* Contiguous preallocation feature */
+#if _USE_PREALLOC
+#if _FS_READONLY
+#error _USE_PREALLOC must be 0 in read-only cfg.
+#endif
+#define	IN_PREALLOC(fp, cl)	((fp)->cl_last && (cl) >= (fp)->sclust && (cl) <= (fp)->cl_last)
+#endif
+
+
+/* Directory lookup cache feature */
+#if _FS_DIRCACHE
+#define	DC_FLUSH(fs)	mem_set((fs)->dcache, 0, sizeof (fs)->dcache)
+#else
+#define	DC_FLUSH(fs)
+#endif
+
+
 /* File access control feature */
 #if _FS_LOCK
 #if _FS_READONLY
@@ -1586,6 +1603,7 @@ FRESULT dir_register (	/* FR_OK:Successful, FR_DENIED:No free entry or too many
 	}
 #endif
 
+	DC_FLUSH(dj->fs);		/* Cached locations may be stale after the directory is changed */
 	if (res == FR_OK) {		/* Initialize the SFN entry */
 		res = move_window(dj->fs, dj->sect);
 		if (res == FR_OK) {
@@ -1643,6 +1661,7 @@ FRESULT dir_remove (	/* FR_OK: Successful, FR_DISK_ERR: A disk error */
 		}
 	}
 #endif
+	DC_FLUSH(dj->fs);		/* Cached locations may be stale after the directory is changed */
 
 	return res;
 }
@@ -2009,6 +2028,112 @@ FRESULT follow_path (	/* FR_OK(0): successful, !=0: error code */
 
 
 
+#if _FS_DIRCACHE
+/*-----------------------------------------------------------------------*/
+/* Follow a file path with the directory lookup cache                    */
+/*-----------------------------------------------------------------------*/
+
+static
+FRESULT follow_path_cached (	/* FR_OK(0): successful, !=0: error code */
+	DIR *dj,			/* Directory object to return last directory and found object */
+	const TCHAR *path	/* Full-path string to find a file or directory */
+)
+{
+	FRESULT res;
+	DCENT *dc;
+	DWORD h;
+	const TCHAR *p, *seg;
+	int match;
+#if _USE_LFN
+	BYTE c, ord, sum;
+#endif
+
+
+	/* Hash the path name (FNV-1a) with the start directory */
+	h = 2166136261UL;
+	p = path;
+	if (*p == '/' || *p == '\\') {
+		p++;
+#if _FS_RPATH
+	} else {
+		h = (h ^ dj->fs->cdir) * 16777619UL;
+#endif
+	}
+	if ((UINT)*p < ' ') return follow_path(dj, path);	/* Start directory itself is not cached */
+	seg = p;
+	while ((UINT)*p >= ' ') {
+		if (*p == '/' || *p == '\\') seg = p + 1;	/* Top of the last segment */
+		h = (h ^ (DWORD)*p++) * 16777619UL;
+	}
+	if (!h) h = 1;
+
+	dc = &dj->fs->dcache[h % _FS_DIRCACHE];
+	if (dc->hash == h) {				/* Cache hit, verify the object name and load the directory entry */
+		/* The hash can collide, the last segment is compared with the
+		   cached entry the way dir_find() does */
+		p = seg;
+		res = create_name(dj, &p);
+		match = 0;
+		if (res == FR_OK && !(dj->fn[NS] & NS_DOT)) {
+			dj->sclust = dc->sclust;
+#if _USE_LFN
+			if (dj->lfn && dc->lfn_idx != 0xFFFF) {	/* Compare the LFN entries */
+				sum = sum_sfn(dc->fn);
+				ord = 0xFF;
+				res = dir_sdi(dj, dc->lfn_idx);
+				while (res == FR_OK && dj->index < dc->index) {
+					res = move_window(dj->fs, dj->sect);
+					if (res != FR_OK) return res;
+					c = dj->dir[DIR_Name];
+					if ((dj->dir[DIR_Attr] & AM_MASK) != AM_LFN || dj->dir[LDIR_Chksum] != sum) break;
+					if (c & LLE) { c &= ~LLE; ord = c; }	/* LFN start order */
+					ord = (c == ord && cmp_lfn(dj->lfn, dj->dir)) ? ord - 1 : 0xFF;
+					res = dir_next(dj, 0);
+				}
+				if (res == FR_OK && dj->index == dc->index && !ord) match = 1;
+			}
+			if (!(dj->fn[NS] & NS_LOSS) && !mem_cmp(dj->fn, dc->fn, 11)) match = 1;	/* Compare the SFN */
+			dj->lfn_idx = dc->lfn_idx;
+#else
+			if (!mem_cmp(dj->fn, dc->fn, 11)) match = 1;
+#endif
+		}
+		if (match) {
+			dj->clust = dc->clust;
+			dj->sect = dc->sect;
+			dj->index = dc->index;
+			res = move_window(dj->fs, dj->sect);
+			if (res != FR_OK) return res;
+			dj->dir = dj->fs->win + (dj->index % (SS(dj->fs) / SZ_DIR)) * SZ_DIR;
+			if (dj->dir[DIR_Name] != DDE && !mem_cmp(dj->dir, dc->fn, 11)) {
+				dj->fs->dc_hit++;
+				return FR_OK;
+			}
+		}
+		dc->hash = 0;					/* Stale entry or other path of the same hash */
+	}
+
+	dj->fs->dc_miss++;
+	res = follow_path(dj, path);		/* Cache miss, follow the path */
+	if (res == FR_OK && dj->dir) {		/* Register the location of the object */
+		dc->hash = h;
+		dc->sclust = dj->sclust;
+		dc->clust = dj->clust;
+		dc->sect = dj->sect;
+		dc->index = dj->index;
+#if _USE_LFN
+		dc->lfn_idx = dj->lfn_idx;
+#endif
+		mem_cpy(dc->fn, dj->dir, 11);
+	}
+
+	return res;
+}
+#endif /* _FS_DIRCACHE */
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Load a sector and check if it is an FAT Volume Boot Record            */
 /*-----------------------------------------------------------------------*/
@@ -2187,6 +2312,7 @@ FRESULT chk_mounted (	/* FR_OK(0): successful, !=0: any error occurred */
 #endif
 	fs->fs_type = fmt;		/* FAT sub-type */
 	fs->id = ++Fsid;		/* File system mount ID */
+	DC_FLUSH(fs);			/* Invalidate directory lookup cache */
 	fs->winsect = 0;		/* Invalidate sector cache */
 	fs->wflag = 0;
 #if _FS_RPATH
@@ -2305,7 +2431,11 @@ FRESULT f_open (
 #endif
 	if (res == FR_OK) {
 		INIT_BUF(dj);
+#if _FS_DIRCACHE
+		res = follow_path_cached(&dj, path);	/* Follow the file path with the lookup cache */
+#else
 		res = follow_path(&dj, path);	/* Follow the file path */
+#endif
 		dir = dj.dir;
 #if !_FS_READONLY	/* R/W configuration */
 		if (res == FR_OK) {
@@ -2398,6 +2528,9 @@ FRESULT f_open (
 			fp->dsect = 0;
 #if _USE_FASTSEEK
 			fp->cltbl = 0;						/* Normal seek mode */
+#endif
+#if _USE_PREALLOC
+			fp->cl_last = 0;					/* No preallocated area */
 #endif
 			fp->fs = dj.fs; fp->id = dj.fs->id;	/* Validate file object */
 		}
@@ -2548,6 +2681,11 @@ FRESULT f_write (
 					if (clst == 0)			/* When no cluster is allocated, */
 						fp->sclust = clst = create_chain(fp->fs, 0);	/* Create a new cluster chain */
 				} else {					/* Middle or end of the file */
+#if _USE_PREALLOC
+					if (IN_PREALLOC(fp, fp->clust) && fp->clust < fp->cl_last)
+						clst = fp->clust + 1;	/* Next cluster in the preallocated area (no FAT access) */
+					else
+#endif
 #if _USE_FASTSEEK
 					if (fp->cltbl)
 						clst = clmt_clust(fp, fp->fptr);	/* Get cluster# from the CLMT */
@@ -2575,10 +2713,21 @@ FRESULT f_write (
 			sect += csect;
 			cc = btw / SS(fp->fs);			/* When remaining bytes >= sector size, */
 			if (cc) {						/* Write maximum contiguous sectors directly */
+#if _USE_PREALLOC
+				if (IN_PREALLOC(fp, fp->clust)) {	/* In the preallocated area? */
+					DWORD ns = (fp->cl_last - fp->clust + 1) * fp->fs->csize - csect;
+					if (cc > ns) cc = (UINT)ns;	/* Clip at end of the area */
+					if (cc > 0xFF)					/* Clip at a cluster boundary within the transfer limit */
+						cc = 0xFF / fp->fs->csize * fp->fs->csize - csect;
+				} else
+#endif
 				if (csect + cc > fp->fs->csize)	/* Clip at cluster boundary */
 					cc = fp->fs->csize - csect;
 				if (disk_write(fp->fs->drv, wbuff, sect, (BYTE)cc) != RES_OK)
 					ABORT(fp->fs, FR_DISK_ERR);
+#if _USE_PREALLOC
+				fp->clust += (csect + cc - 1) / fp->fs->csize;	/* Cluster of the last written sector */
+#endif
 #if _FS_TINY
 				if (fp->fs->winsect - sect < cc) {	/* Refill sector cache if it gets invalidated by the direct write */
 					mem_cpy(fp->fs->win, wbuff + ((fp->fs->winsect - sect) * SS(fp->fs)), SS(fp->fs));
@@ -2677,6 +2826,45 @@ FRESULT f_sync (
 
 
 
+#if _USE_PREALLOC
+/*-----------------------------------------------------------------------*/
+/* Release Unused Clusters of the Preallocated Area                      */
+/*-----------------------------------------------------------------------*/
+
+static
+FRESULT release_prealloc (
+	FIL *fp		/* Pointer to the file object */
+)
+{
+	FRESULT res;
+	DWORD csz, lcl;
+
+
+	res = validate(fp);					/* Check validity of the object */
+	if (res == FR_OK && fp->cl_last) {
+		if (fp->fsize == 0) {			/* Nothing written, remove entire area */
+			res = remove_chain(fp->fs, fp->sclust);
+			fp->sclust = 0;
+		} else {
+			csz = (DWORD)fp->fs->csize * SS(fp->fs);
+			lcl = fp->sclust + (fp->fsize - 1) / csz;	/* Last cluster holding the file data */
+			if (lcl < fp->cl_last) {	/* Remove the clusters following it */
+				res = put_fat(fp->fs, lcl, 0x0FFFFFFF);
+				if (res == FR_OK) res = remove_chain(fp->fs, lcl + 1);
+			}
+		}
+		fp->cl_last = 0;
+		fp->flag |= FA__WRITTEN;
+		if (res != FR_OK) fp->flag |= FA__ERROR;
+	}
+
+	LEAVE_FF(fp->fs, res);
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Close File                                                            */
 /*-----------------------------------------------------------------------*/
@@ -2698,6 +2886,10 @@ FRESULT f_close (
 		LEAVE_FF(fs, res);
 	}
 #else
+#if _USE_PREALLOC
+	res = release_prealloc(fp);	/* Release unused clusters of the preallocated area */
+	if (res == FR_OK)
+#endif
 	res = f_sync(fp);		/* Flush cached data */
 #if _FS_LOCK
 	if (res == FR_OK) {		/* Decrement open counter */
@@ -3220,6 +3412,9 @@ FRESULT f_truncate (
 		if (fp->fsize > fp->fptr) {
 			fp->fsize = fp->fptr;	/* Set file size to current R/W point */
 			fp->flag |= FA__WRITTEN;
+#if _USE_PREALLOC
+			fp->cl_last = 0;		/* Preallocated area is no longer guaranteed */
+#endif
 			if (fp->fptr == 0) {	/* When set file size to zero, remove entire cluster chain */
 				res = remove_chain(fp->fs, fp->sclust);
 				fp->sclust = 0;
@@ -3545,6 +3740,77 @@ FRESULT f_rename (
 
 
 
+
+#if _USE_PREALLOC
+/*-----------------------------------------------------------------------*/
+/* Allocate a Contiguous Data Area to the File                           */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_prealloc (
+	FIL *fp,		/* Pointer to the file object (opened in write mode, empty) */
+	DWORD fsz		/* Size of the data area to be allocated in unit of byte */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	DWORD csz, ncl, scl, clst, n, nxt;
+
+
+	if (!fp) return FR_INVALID_OBJECT;
+
+	res = validate(fp);						/* Check validity of the object */
+	if (res != FR_OK) LEAVE_FF(fp->fs, res);
+	if (fp->flag & FA__ERROR)				/* Aborted file? */
+		LEAVE_FF(fp->fs, FR_INT_ERR);
+	if (!(fp->flag & FA_WRITE) || fp->sclust || !fsz)	/* Only an empty file in write mode can be preallocated */
+		LEAVE_FF(fp->fs, FR_DENIED);
+
+	fs = fp->fs;
+	csz = (DWORD)fs->csize * SS(fs);
+	ncl = fsz / csz + ((fsz % csz) ? 1 : 0);	/* Number of clusters required */
+	if (ncl > fs->n_fatent - 2) LEAVE_FF(fs, FR_DENIED);
+
+	/* Find a contiguous free area, from the last allocated cluster first, then from top of the volume */
+	scl = fs->last_clust + 1;
+	if (scl < 2 || scl >= fs->n_fatent) scl = 2;
+	for (;;) {
+		n = 0;
+		for (clst = scl; clst < fs->n_fatent && n < ncl; clst++) {
+			nxt = get_fat(fs, clst);
+			if (nxt == 0xFFFFFFFF) LEAVE_FF(fs, FR_DISK_ERR);
+			if (nxt == 1) LEAVE_FF(fs, FR_INT_ERR);
+			n = nxt ? 0 : n + 1;			/* Count free clusters in a row */
+		}
+		if (n == ncl) break;				/* Found */
+		if (scl == 2) LEAVE_FF(fs, FR_DENIED);	/* No contiguous free area on the volume */
+		scl = 2;
+	}
+	scl = clst - ncl;						/* Top of the area */
+
+	/* Create the cluster chain and flush the FAT, writes into the area do not touch it until the file is closed */
+	for (clst = scl; res == FR_OK && clst < scl + ncl - 1; clst++)
+		res = put_fat(fs, clst, clst + 1);
+	if (res == FR_OK) res = put_fat(fs, clst, 0x0FFFFFFF);
+	if (res == FR_OK) res = move_window(fs, 0);
+	if (res == FR_OK) {
+		fs->last_clust = clst;				/* Update FSINFO */
+		if (fs->free_clust != 0xFFFFFFFF) {
+			fs->free_clust -= ncl;
+			fs->fsi_flag = 1;
+		}
+		fp->sclust = scl;
+		fp->cl_last = clst;
+		fp->flag |= FA__WRITTEN;
+	} else {
+		fp->flag |= FA__ERROR;
+	}
+
+	LEAVE_FF(fs, res);
+}
+#endif /* _USE_PREALLOC */
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Forward data to the stream directly (available on only tiny cfg)      */
 /*-----------------------------------------------------------------------*/
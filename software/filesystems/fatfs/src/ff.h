@@ -72,6 +72,24 @@ typedef char TCHAR;
 
 
 
+/* Directory lookup cache entry structure (DCENT) */
+
+#if _FS_DIRCACHE
+typedef struct {
+	DWORD	hash;			/* Hash of the path name (0:Empty entry) */
+	DWORD	sclust;			/* Start cluster of the directory containing the object */
+	DWORD	clust;			/* Cluster containing the directory entry */
+	DWORD	sect;			/* Sector containing the directory entry */
+	WORD	index;			/* Index of the directory entry */
+#if _USE_LFN
+	WORD	lfn_idx;		/* Index of the top of the LFN entries (0xFFFF:No LFN) */
+#endif
+	BYTE	fn[11];			/* SFN of the directory entry */
+} DCENT;
+#endif
+
+
+
 /* File system object structure (FATFS) */
 
 typedef struct {
@@ -96,6 +114,11 @@ typedef struct {
 #endif
 #if _FS_RPATH
 	DWORD	cdir;			/* Current directory start cluster (0:root) */
+#endif
+#if _FS_DIRCACHE
+	DCENT	dcache[_FS_DIRCACHE];	/* Directory lookup cache */
+	DWORD	dc_hit;			/* Number of lookups found in the cache */
+	DWORD	dc_miss;		/* Number of lookups that followed the path */
 #endif
 	DWORD	n_fatent;		/* Number of FAT entries (= number of clusters + 2) */
 	DWORD	fsize;			/* Sectors per FAT */
@@ -127,6 +150,9 @@ typedef struct {
 #if _USE_FASTSEEK
 	DWORD*	cltbl;			/* Pointer to the cluster link map table (null on file open) */
 #endif
+#if _USE_PREALLOC
+	DWORD	cl_last;		/* Last cluster of the contiguous preallocated area (0:not preallocated) */
+#endif
 #if _FS_LOCK
 	UINT	lockid;			/* File lock ID (index of file semaphore table Files[]) */
 #endif
@@ -213,6 +239,7 @@ FRESULT f_stat (const TCHAR*, FILINFO*);			/* Get file status */
 FRESULT f_write (FIL*, const void*, UINT, UINT*);	/* Write data to a file */
 FRESULT f_getfree (const TCHAR*, DWORD*, FATFS**);	/* Get number of free clusters on the drive */
 FRESULT f_truncate (FIL*);							/* Truncate file */
+FRESULT f_prealloc (FIL*, DWORD);					/* Allocate a contiguous data area to the file */
 FRESULT f_sync (FIL*);								/* Flush cached data of a writing file */
 FRESULT f_unlink (const TCHAR*);					/* Delete an existing file or directory */
 FRESULT	f_mkdir (const TCHAR*);						/* Create a new directory */
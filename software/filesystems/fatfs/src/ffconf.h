@@ -52,6 +52,12 @@
 /* To enable fast seek feature, set _USE_FASTSEEK to 1. */
 
 
+#define	_USE_PREALLOC	0	/* 0:Disable or 1:Enable */
+/* To enable f_prealloc function, set _USE_PREALLOC to 1 and set _FS_READONLY to 0.
+/  Writes into a preallocated contiguous area follow the clusters without FAT access
+/  and are issued as multiple sector writes across cluster boundaries. */
+
+
 
 /*---------------------------------------------------------------------------/
 / Locale and Namespace Configurations
@@ -187,4 +193,11 @@
    The value defines how many files can be opened simultaneously. */
 
 
+#define	_FS_DIRCACHE	0	/* 0:Disable or >=1:Enable */
+/* To enable directory lookup cache of f_open, set _FS_DIRCACHE to 1 or greater.
+   The value defines number of entries in the cache on each volume. An entry maps
+   hashed path name to the location of its directory entry, so that repeated opens
+   of the same file do not scan the directory. Each entry takes 32 bytes of RAM. */
+
+
 #endif /* _FFCONFIG */
@@ -37,6 +37,25 @@
  * Private types/enumerations/variables
  ****************************************************************************/
 
+/* Number of sectors in the bounce buffer, transfers from/to buffers the DMA
+   cannot use directly are split into multiple sector transfers of this size */
+#ifndef FSMCI_BOUNCE_SECTORS
+#define FSMCI_BOUNCE_SECTORS    8
+#endif
+
+/* Check if the SDIF DMA can transfer directly from/to a buffer. The IDMAC
+   needs word aligned buffers, boards with memory the DMA cannot reach can
+   add a region check by defining this in fsmci_cfg.h */
+#ifndef FSMCI_BufDmaSafe
+#define FSMCI_BufDmaSafe(buf, sz)   ((((uint32_t) (buf)) & 3) == 0)
+#endif
+
+/* Word aligned bounce buffer in DMA reachable RAM */
+static uint32_t bounceBuf[FSMCI_BOUNCE_SECTORS * 512 / sizeof(uint32_t)];
+
+/* Bounce statistics: bounced transfers, bounced sectors, direct transfers */
+static DWORD bounceStats[3];
+
 /* Disk Status */
 static volatile DSTATUS Stat = STA_NOINIT;
 
@@ -53,6 +72,48 @@ static CARD_HANDLE_T *hCard;
  * Private functions
  ****************************************************************************/
 
+/* Read sectors into a buffer the DMA cannot use through the bounce buffer */
+static int bounceRead(BYTE *buff, DWORD sector, BYTE count)
+{
+	BYTE n;
+
+	bounceStats[0]++;
+	bounceStats[1] += count;
+	while (count) {
+		n = (count > FSMCI_BOUNCE_SECTORS) ? FSMCI_BOUNCE_SECTORS : count;
+		if (!FSMCI_CardReadSectors(hCard, bounceBuf, sector, n)) {
+			return 0;
+		}
+		memcpy(buff, bounceBuf, n * 512);
+		buff += n * 512;
+		sector += n;
+		count -= n;
+	}
+
+	return 1;
+}
+
+/* Write sectors from a buffer the DMA cannot use through the bounce buffer */
+static int bounceWrite(const BYTE *buff, DWORD sector, BYTE count)
+{
+	BYTE n;
+
+	bounceStats[0]++;
+	bounceStats[1] += count;
+	while (count) {
+		n = (count > FSMCI_BOUNCE_SECTORS) ? FSMCI_BOUNCE_SECTORS : count;
+		memcpy(bounceBuf, buff, n * 512);
+		if (!FSMCI_CardWriteSectors(hCard, bounceBuf, sector, n)) {
+			return 0;
+		}
+		buff += n * 512;
+		sector += n;
+		count -= n;
+	}
+
+	return 1;
+}
+
 /*****************************************************************************
  * Public functions
  ****************************************************************************/
@@ -157,6 +218,11 @@ DRESULT disk_ioctl(BYTE drv, BYTE ctrl, void *buff)
 		}
 	break;
 
+	case MMC_GET_BOUNCE:/* Get bounce buffer statistics (DWORD[3]) */
+		memcpy(buff, bounceStats, sizeof(bounceStats));
+		res = RES_OK;
+		break;
+
 	default:
 		res = RES_PARERR;
 		break;
@@ -175,6 +241,11 @@ DRESULT disk_read(BYTE drv, BYTE *buff, DWORD sector, BYTE count)
 		return RES_NOTRDY;
 	}
 
+	if (!FSMCI_BufDmaSafe(buff, count * 512)) {
+		return bounceRead(buff, sector, count) ? RES_OK : RES_ERROR;
+	}
+
+	bounceStats[2]++;
 	if (FSMCI_CardReadSectors(hCard, buff, sector, count)) {
 		return RES_OK;
 	}
@@ -203,6 +274,11 @@ DRESULT disk_write(BYTE drv, const BYTE *buff, DWORD sector, BYTE count)
 		return RES_NOTRDY;
 	}
 
+	if (!FSMCI_BufDmaSafe(buff, count * 512)) {
+		return bounceWrite(buff, sector, count) ? RES_OK : RES_ERROR;
+	}
+
+	bounceStats[2]++;
 	if ( FSMCI_CardWriteSectors(hCard, (void *) buff, sector, count)) {
 		return RES_OK;
 	}
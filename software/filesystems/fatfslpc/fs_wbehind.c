@@ -0,0 +1,260 @@
+/*
+ * @brief Write-behind flush task for Chan FATFS
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <string.h>
+#include "fs_wbehind.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Requests handled by the flush task */
+typedef enum {
+	FSWB_MSG_DATA,		/* Write a full buffer */
+	FSWB_MSG_SYNC,		/* Sync the file and complete a barrier */
+	FSWB_MSG_CLOSE		/* Close the file and complete a barrier */
+} FSWB_MSG_TYPE_T;
+
+typedef struct {
+	FSWB_MSG_TYPE_T type;
+	FSWB_STREAM_T *st;
+	FSWB_BUF_T *buf;
+	uint32_t seq;
+} FSWB_MSG_T;
+
+/* Depth of the request queue, every buffer plus a few barriers */
+#define FSWB_WORKQ_LEN      (FSWB_NUM_BUFS + 4)
+
+static FSWB_BUF_T wbBufs[FSWB_NUM_BUFS];
+static QueueHandle_t xFreeQ;	/* Buffers available to producers */
+static QueueHandle_t xWorkQ;	/* Requests to the flush task */
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Flush task, the only task calling FatFs for the streams */
+static void vFSWBTask(void *pvParameters)
+{
+	FSWB_MSG_T msg;
+	FRESULT res;
+	UINT bw;
+
+	for (;; ) {
+		xQueueReceive(xWorkQ, &msg, portMAX_DELAY);
+
+		switch (msg.type) {
+		case FSWB_MSG_DATA:
+			if (msg.st->err == FR_OK) {
+				res = f_write(msg.st->fp, msg.buf->data, msg.buf->len, &bw);
+				if ((res == FR_OK) && (bw != msg.buf->len)) {
+					res = FR_DENIED;	/* Volume is full */
+				}
+				if (res != FR_OK) {
+					msg.st->err = res;
+				}
+			}
+			msg.buf->len = 0;
+			xQueueSendToBack(xFreeQ, &msg.buf, 0);
+			break;
+
+		case FSWB_MSG_SYNC:
+		case FSWB_MSG_CLOSE:
+			res = (msg.type == FSWB_MSG_SYNC) ? f_sync(msg.st->fp) : f_close(msg.st->fp);
+			if ((res != FR_OK) && (msg.st->err == FR_OK)) {
+				msg.st->err = res;
+			}
+			msg.st->seq_done = msg.seq;
+			xSemaphoreGive(msg.st->done);
+			break;
+		}
+	}
+}
+
+/* Hand the current buffer of the stream to the flush task */
+static FRESULT FSWB_PostBuffer(FSWB_STREAM_T *st, TickType_t tout)
+{
+	FSWB_MSG_T msg;
+
+	msg.type = FSWB_MSG_DATA;
+	msg.st = st;
+	msg.buf = st->cur;
+	msg.seq = 0;
+	if (xQueueSendToBack(xWorkQ, &msg, tout) != pdTRUE) {
+		return FR_TIMEOUT;
+	}
+	st->cur = NULL;
+
+	return FR_OK;
+}
+
+/* Queue a sync or close request and wait for the flush task to complete it */
+static FRESULT FSWB_Request(FSWB_STREAM_T *st, FSWB_MSG_TYPE_T type, TickType_t tout)
+{
+	FSWB_MSG_T msg;
+	TickType_t xStart, xElapsed;
+
+	xStart = xTaskGetTickCount();
+	if (st->cur && st->cur->len && (FSWB_PostBuffer(st, tout) != FR_OK)) {
+		return FR_TIMEOUT;
+	}
+
+	msg.type = type;
+	msg.st = st;
+	msg.buf = NULL;
+	msg.seq = ++st->seq_req;
+	if (xQueueSendToBack(xWorkQ, &msg, tout) != pdTRUE) {
+		return FR_TIMEOUT;
+	}
+
+	/* A late completion of an earlier timed out barrier may also signal the semaphore */
+	while ((int32_t) (st->seq_done - msg.seq) < 0) {
+		xElapsed = xTaskGetTickCount() - xStart;
+		if (xElapsed >= tout) {
+			return FR_TIMEOUT;
+		}
+		xSemaphoreTake(st->done, tout - xElapsed);
+	}
+
+	return st->err;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Create the write-behind buffer pool, queues and flush task */
+int FSWB_Init(void)
+{
+	FSWB_BUF_T *buf;
+	int i;
+
+	xFreeQ = xQueueCreate(FSWB_NUM_BUFS, sizeof(FSWB_BUF_T *));
+	xWorkQ = xQueueCreate(FSWB_WORKQ_LEN, sizeof(FSWB_MSG_T));
+	if (!xFreeQ || !xWorkQ) {
+		return 0;
+	}
+
+	for (i = 0; i < FSWB_NUM_BUFS; i++) {
+		buf = &wbBufs[i];
+		buf->len = 0;
+		xQueueSendToBack(xFreeQ, &buf, 0);
+	}
+
+	return xTaskCreate(vFSWBTask, "FSWB", FSWB_TASK_STACK, NULL,
+					   FSWB_TASK_PRIO, NULL) == pdPASS;
+}
+
+/* Attach a write-behind stream to an open file */
+FRESULT FSWB_Open(FSWB_STREAM_T *st, FIL *fp)
+{
+	memset(st, 0, sizeof(*st));
+	st->fp = fp;
+	st->err = FR_OK;
+	st->done = xSemaphoreCreateBinary();
+	if (!st->done) {
+		return FR_NOT_ENOUGH_CORE;
+	}
+
+	return FR_OK;
+}
+
+/* Queue data to be written to the stream */
+FRESULT FSWB_Write(FSWB_STREAM_T *st, const void *buff, UINT btw, UINT *bw, TickType_t tout)
+{
+	const uint8_t *src = buff;
+	UINT n;
+
+	*bw = 0;
+	while (btw) {
+		if (st->err != FR_OK) {
+			return st->err;
+		}
+
+		/* Get a buffer from the pool, back-pressure when all are in flight */
+		if (!st->cur) {
+			if (xQueueReceive(xFreeQ, &st->cur, 0) != pdTRUE) {
+				st->stalls++;
+				if (xQueueReceive(xFreeQ, &st->cur, tout) != pdTRUE) {
+					st->cur = NULL;
+					return FR_TIMEOUT;
+				}
+			}
+		}
+
+		/* Coalesce into the current buffer */
+		n = FSWB_BUF_SZ - st->cur->len;
+		if (n > btw) {
+			n = btw;
+		}
+		memcpy((uint8_t *) st->cur->data + st->cur->len, src, n);
+		st->cur->len += n;
+		src += n;
+		btw -= n;
+		*bw += n;
+
+		if ((st->cur->len == FSWB_BUF_SZ) && (FSWB_PostBuffer(st, tout) != FR_OK)) {
+			return FR_TIMEOUT;
+		}
+	}
+
+	return FR_OK;
+}
+
+/* Wait until all data queued on the stream is written and synced */
+FRESULT FSWB_Barrier(FSWB_STREAM_T *st, TickType_t tout)
+{
+	return FSWB_Request(st, FSWB_MSG_SYNC, tout);
+}
+
+/* Flush the stream and close its file */
+FRESULT FSWB_Close(FSWB_STREAM_T *st, TickType_t tout)
+{
+	FRESULT res;
+
+	res = FSWB_Request(st, FSWB_MSG_CLOSE, tout);
+	if (res != FR_TIMEOUT) {
+		/* Flush task is done with the stream */
+		if (st->cur) {
+			st->cur->len = 0;
+			xQueueSendToBack(xFreeQ, &st->cur, 0);
+			st->cur = NULL;
+		}
+		vSemaphoreDelete(st->done);
+		st->done = NULL;
+	}
+
+	return res;
+}
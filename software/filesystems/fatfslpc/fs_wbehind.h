@@ -0,0 +1,146 @@
+/*
+ * @brief Write-behind flush task for Chan FATFS
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __FS_WBEHIND_H_
+#define __FS_WBEHIND_H_
+
+#include "ff.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup LPCOPEN_FSLIBS_CHANFATFS_FSWB Write-behind flush task for FatFs
+ * @ingroup LPCOPEN_FSLIBS_CHANFATFS
+ * Producers copy data into a bounded pool of buffers and return, a companion
+ * task writes full buffers to the file and performs the syncs. Data written
+ * to a stream is only durable once FSWB_Barrier() has returned FR_OK.
+ * @note	FatFs is not reentrant in this configuration (_FS_REENTRANT = 0), so
+ * while the flush task is running no other task may call FatFs functions on
+ * the same volume.
+ * @{
+ */
+
+/** Size of one write-behind buffer, use the cluster size of the volume */
+#ifndef FSWB_BUF_SZ
+#define FSWB_BUF_SZ         4096
+#endif
+
+/** Number of write-behind buffers, this bounds the memory held by pending writes */
+#ifndef FSWB_NUM_BUFS
+#define FSWB_NUM_BUFS       4
+#endif
+
+/** Priority of the flush task */
+#ifndef FSWB_TASK_PRIO
+#define FSWB_TASK_PRIO      (tskIDLE_PRIORITY + 1UL)
+#endif
+
+/** Stack size of the flush task in words */
+#ifndef FSWB_TASK_STACK
+#define FSWB_TASK_STACK     (configMINIMAL_STACK_SIZE * 2)
+#endif
+
+/** Write-behind buffer */
+typedef struct {
+	UINT len;								/*!< Number of bytes held in the buffer */
+	uint32_t data[FSWB_BUF_SZ / 4];			/*!< Word aligned data for the DMA */
+} FSWB_BUF_T;
+
+/** Write-behind stream, one per open file */
+typedef struct {
+	FIL *fp;								/*!< File written by the flush task */
+	FSWB_BUF_T *cur;						/*!< Buffer being filled by the producer */
+	SemaphoreHandle_t done;					/*!< Signalled by the flush task on a barrier */
+	uint32_t seq_req;						/*!< Last barrier requested by the producer */
+	volatile uint32_t seq_done;				/*!< Last barrier completed by the flush task */
+	volatile FRESULT err;					/*!< First error reported by the flush task */
+	uint32_t stalls;						/*!< Number of times the producer waited for a free buffer */
+} FSWB_STREAM_T;
+
+/**
+ * @brief	Create the write-behind buffer pool, queues and flush task
+ * @return	1 on success, 0 if the RTOS objects could not be created
+ * @note	Must be called once before any other FSWB function.
+ */
+int FSWB_Init(void);
+
+/**
+ * @brief	Attach a write-behind stream to an open file
+ * @param	st	: Pointer to the stream to initialize
+ * @param	fp	: File opened with FA_WRITE, owned by the flush task from now on
+ * @return	FR_OK on success, FR_NOT_ENOUGH_CORE if the stream semaphore could not be created
+ */
+FRESULT FSWB_Open(FSWB_STREAM_T *st, FIL *fp);
+
+/**
+ * @brief	Queue data to be written to the stream
+ * @param	st		: Pointer to the stream
+ * @param	buff	: Data to be written
+ * @param	btw		: Number of bytes to write
+ * @param	bw		: Pointer to the number of bytes queued
+ * @param	tout	: Ticks to wait for a free buffer when the pool is exhausted
+ * @return	FR_OK when all data is queued, FR_TIMEOUT when the pool stayed exhausted,
+ * or the error reported by the flush task for an earlier write
+ * @note	Small writes are coalesced into full buffers, a buffer is handed to the
+ * flush task only when it is full or on a barrier.
+ */
+FRESULT FSWB_Write(FSWB_STREAM_T *st, const void *buff, UINT btw, UINT *bw, TickType_t tout);
+
+/**
+ * @brief	Wait until all data queued on the stream is written and synced
+ * @param	st		: Pointer to the stream
+ * @param	tout	: Ticks to wait for the flush task
+ * @return	FR_OK when the data is durable, FR_TIMEOUT or the flush task error otherwise
+ */
+FRESULT FSWB_Barrier(FSWB_STREAM_T *st, TickType_t tout);
+
+/**
+ * @brief	Flush the stream and close its file
+ * @param	st		: Pointer to the stream
+ * @param	tout	: Ticks to wait for the flush task
+ * @return	FR_OK on success, FR_TIMEOUT or the flush task error otherwise
+ */
+FRESULT FSWB_Close(FSWB_STREAM_T *st, TickType_t tout);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef __FS_WBEHIND_H_ */
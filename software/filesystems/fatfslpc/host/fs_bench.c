@@ -0,0 +1,434 @@
+/*
+ * @brief Chan FATFS throughput benchmark on a disk image (host build)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ff.h"
+#include "fs_image.h"
+#include "fs_wbehind.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Measurement of one benchmark phase */
+typedef struct {
+	const char *name;
+	struct timespec t0;
+	FSIMG_STATS_T s0;
+	unsigned long calls;		/* FatFs API calls made in the phase */
+	unsigned long bytes;		/* File data bytes moved in the phase */
+	unsigned long rd_sects;		/* Sectors read in the phase, set by phase_end() */
+} PHASE_T;
+
+static FATFS fatFS;
+static FIL fileObj;
+static BYTE *xferBuf;
+
+/* Benchmark parameters, see usage() */
+static unsigned long fileSize = 4UL * 1024 * 1024;
+static unsigned int chunkSize = 32 * 1024;
+static unsigned int randCount = 1000;
+static unsigned int randSize = 512;
+static unsigned int nFiles = 100;
+static unsigned int nHot = 8;
+static int usePrealloc;
+
+#define BENCH_FILE  "BENCH.BIN"
+#define BENCH_DIR   "BENCHDIR"
+#define WB_FILE     "WBEHIND.BIN"
+
+/* Ticks to wait for the write-behind task, long enough for any latency */
+#define WB_TIMEOUT  60000
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+			"usage: %s [options] image\n"
+			"  -s kbytes  size of the sequential test file (default %lu)\n"
+			"  -b bytes   chunk size of sequential f_read/f_write (default %u)\n"
+			"  -r count   number of random accesses (default %u)\n"
+			"  -R bytes   size of a random access (default %u)\n"
+			"  -n files   number of files for the directory test (default %u)\n"
+			"  -H files   number of files reopened by the reopen test (default %u)\n"
+			"  -c usec    latency injected per disk command\n"
+			"  -l usec    latency injected per sector\n"
+			"  -t file    write a sector access trace to file\n"
+			"  -p         preallocate the sequential test file with f_prealloc\n"
+			"The image must hold a FAT volume without partition table, e.g.\n"
+			"  mkfs.vfat -C image.img 65536\n",
+			prog, fileSize / 1024, chunkSize, randCount, randSize, nFiles, nHot);
+	exit(2);
+}
+
+static void check(FRESULT res, const char *what)
+{
+	if (res != FR_OK) {
+		fprintf(stderr, "%s failed, FRESULT %d\n", what, res);
+		exit(1);
+	}
+}
+
+static void phase_begin(PHASE_T *p, const char *name)
+{
+	memset(p, 0, sizeof(*p));
+	p->name = name;
+	FSIMG_GetStats(&p->s0);
+	clock_gettime(CLOCK_MONOTONIC, &p->t0);
+}
+
+static void phase_end(PHASE_T *p)
+{
+	struct timespec t1;
+	FSIMG_STATS_T s1;
+	double secs;
+	unsigned long rs, ws;
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	FSIMG_GetStats(&s1);
+	secs = (t1.tv_sec - p->t0.tv_sec) + (t1.tv_nsec - p->t0.tv_nsec) / 1e9;
+	rs = s1.rd_sects - p->s0.rd_sects;
+	ws = s1.wr_sects - p->s0.wr_sects;
+	p->rd_sects = rs;
+
+	printf("%-10s %8.3f %8lu %10.1f %10.1f %6lu/%-7lu %6lu/%-7lu %6.2f %6.2f\n",
+		   p->name, secs, p->calls,
+		   secs > 0 ? p->calls / secs : 0.0,
+		   secs > 0 ? p->bytes / secs / 1024 : 0.0,
+		   s1.rd_cmds - p->s0.rd_cmds, rs,
+		   s1.wr_cmds - p->s0.wr_cmds, ws,
+		   p->calls ? (double) (rs + ws) / p->calls : 0.0,
+		   p->bytes ? (double) (rs + ws) * SECTOR_SZ / p->bytes : 0.0);
+}
+
+static void bench_seq_write(void)
+{
+	PHASE_T ph;
+	unsigned long left;
+	UINT n, bw;
+
+	phase_begin(&ph, "seq-write");
+	check(f_open(&fileObj, BENCH_FILE, FA_WRITE | FA_CREATE_ALWAYS), "f_open");
+	ph.calls++;
+	if (usePrealloc) {
+#if _USE_PREALLOC
+		check(f_prealloc(&fileObj, fileSize), "f_prealloc");
+		ph.calls++;
+#else
+		fprintf(stderr, "f_prealloc needs _USE_PREALLOC in ffconf.h\n");
+		exit(1);
+#endif
+	}
+	for (left = fileSize; left; left -= n) {
+		n = left < chunkSize ? (UINT) left : chunkSize;
+		check(f_write(&fileObj, xferBuf, n, &bw), "f_write");
+		if (bw != n) {
+			check(FR_DENIED, "f_write (volume full)");
+		}
+		ph.calls++;
+		ph.bytes += n;
+	}
+	check(f_close(&fileObj), "f_close");
+	ph.calls++;
+	phase_end(&ph);
+}
+
+static void bench_seq_read(void)
+{
+	PHASE_T ph;
+	UINT br;
+
+	phase_begin(&ph, "seq-read");
+	check(f_open(&fileObj, BENCH_FILE, FA_READ), "f_open");
+	ph.calls++;
+	do {
+		check(f_read(&fileObj, xferBuf, chunkSize, &br), "f_read");
+		ph.calls++;
+		ph.bytes += br;
+	} while (br == chunkSize);
+	check(f_close(&fileObj), "f_close");
+	ph.calls++;
+	phase_end(&ph);
+}
+
+/* Seconds since a time */
+static double elapsed(const struct timespec *t0)
+{
+	struct timespec t1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	return (t1.tv_sec - t0->tv_sec) + (t1.tv_nsec - t0->tv_nsec) / 1e9;
+}
+
+/* Fills a chunk with a pattern that depends on the file offset */
+static void fill_pattern(BYTE *buf, unsigned long off, UINT n)
+{
+	UINT i;
+
+	for (i = 0; i < n; i++) {
+		buf[i] = (BYTE) ((off + i) * 7 + ((off + i) >> 9));
+	}
+}
+
+/* Sequential write through the write-behind task of fs_wbehind.c: the
+   time the producer spent in FSWB_Write is what a task queueing the data
+   is held up, the rest of the phase overlaps with the disk. The file is
+   read back and compared. */
+static void bench_wbehind(void)
+{
+	PHASE_T ph;
+	FSWB_STREAM_T st;
+	struct timespec t0;
+	double wr_secs = 0;
+	unsigned long left, off;
+	UINT n, bw, br;
+	BYTE *vbuf;
+
+	phase_begin(&ph, "wb-write");
+	check(f_open(&fileObj, WB_FILE, FA_WRITE | FA_CREATE_ALWAYS), "f_open");
+	ph.calls++;
+	check(FSWB_Open(&st, &fileObj), "FSWB_Open");
+	for (off = 0, left = fileSize; left; left -= n, off += n) {
+		n = left < chunkSize ? (UINT) left : chunkSize;
+		fill_pattern(xferBuf, off, n);
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		check(FSWB_Write(&st, xferBuf, n, &bw, WB_TIMEOUT), "FSWB_Write");
+		wr_secs += elapsed(&t0);
+		ph.calls++;
+		ph.bytes += n;
+	}
+	check(FSWB_Close(&st, WB_TIMEOUT), "FSWB_Close");
+	ph.calls++;
+	phase_end(&ph);
+	printf("  producer %.3f s in FSWB_Write, %lu waits for a free buffer\n",
+		   wr_secs, (unsigned long) st.stalls);
+
+	vbuf = malloc(chunkSize);
+	if (!vbuf) {
+		exit(1);
+	}
+	check(f_open(&fileObj, WB_FILE, FA_READ), "f_open");
+	for (off = 0; off < fileSize; off += br) {
+		check(f_read(&fileObj, vbuf, chunkSize, &br), "f_read");
+		fill_pattern(xferBuf, off, br);
+		if ((br == 0) || memcmp(vbuf, xferBuf, br)) {
+			fprintf(stderr, "wb-write: data differs in the chunk at %lu\n", off);
+			exit(1);
+		}
+	}
+	check(f_close(&fileObj), "f_close");
+	check(f_unlink(WB_FILE), "f_unlink");
+	free(vbuf);
+	printf("  %lu bytes read back and verified\n", off);
+}
+
+static void bench_random(int write)
+{
+	PHASE_T ph;
+	unsigned int i;
+	unsigned long span = fileSize / randSize;
+	UINT n;
+
+	srand(1);
+	phase_begin(&ph, write ? "rand-write" : "rand-read");
+	check(f_open(&fileObj, BENCH_FILE, write ? FA_WRITE : FA_READ), "f_open");
+	ph.calls++;
+	for (i = 0; i < randCount && span; i++) {
+		check(f_lseek(&fileObj, (DWORD) (rand() % span) * randSize), "f_lseek");
+		if (write) {
+			check(f_write(&fileObj, xferBuf, randSize, &n), "f_write");
+		}
+		else {
+			check(f_read(&fileObj, xferBuf, randSize, &n), "f_read");
+		}
+		ph.calls += 2;
+		ph.bytes += n;
+	}
+	check(f_close(&fileObj), "f_close");
+	ph.calls++;
+	phase_end(&ph);
+}
+
+static void bench_dir(void)
+{
+	PHASE_T ph;
+	FILINFO fno;
+	char name[32];
+	unsigned int i;
+	unsigned long open_sects;
+#if _FS_DIRCACHE
+	DWORD hit, miss;
+#endif
+	UINT bw;
+
+	phase_begin(&ph, "create");
+	f_mkdir(BENCH_DIR);
+	ph.calls++;
+	for (i = 0; i < nFiles; i++) {
+		sprintf(name, BENCH_DIR "/F%05u.TXT", i);
+		check(f_open(&fileObj, name, FA_WRITE | FA_CREATE_ALWAYS), "f_open");
+		check(f_write(&fileObj, name, strlen(name), &bw), "f_write");
+		check(f_close(&fileObj), "f_close");
+		ph.calls += 3;
+	}
+	phase_end(&ph);
+
+	phase_begin(&ph, "open");
+	for (i = 0; i < nFiles; i++) {
+		sprintf(name, BENCH_DIR "/F%05u.TXT", (i * 7919) % nFiles);
+		check(f_open(&fileObj, name, FA_READ), "f_open");
+		check(f_close(&fileObj), "f_close");
+		ph.calls += 2;
+	}
+	phase_end(&ph);
+	open_sects = ph.rd_sects;
+
+	/* The same number of opens on a few hot files, as a web server opens
+	   its pages, to show the effect of the directory lookup cache */
+#if _FS_DIRCACHE
+	hit = fatFS.dc_hit;
+	miss = fatFS.dc_miss;
+#endif
+	phase_begin(&ph, "reopen");
+	for (i = 0; i < nFiles; i++) {
+		sprintf(name, BENCH_DIR "/F%05u.TXT", ((i % nHot) * 7919) % nFiles);
+		check(f_open(&fileObj, name, FA_READ), "f_open");
+		check(f_close(&fileObj), "f_close");
+		ph.calls += 2;
+	}
+	phase_end(&ph);
+#if _FS_DIRCACHE
+	printf("  %u opens of %u files: %lu directory cache hits, %lu misses\n", nFiles, nHot,
+		   (unsigned long) (fatFS.dc_hit - hit), (unsigned long) (fatFS.dc_miss - miss));
+#else
+	printf("  %u opens of %u files: no directory cache (_FS_DIRCACHE 0)\n", nFiles, nHot);
+#endif
+	printf("  %lu sectors read, %ld fewer than opening %u different files\n",
+		   ph.rd_sects, (long) open_sects - (long) ph.rd_sects, nFiles);
+
+	phase_begin(&ph, "stat");
+	for (i = 0; i < nFiles; i++) {
+		sprintf(name, BENCH_DIR "/F%05u.TXT", i);
+		check(f_stat(name, &fno), "f_stat");
+		ph.calls++;
+	}
+	phase_end(&ph);
+
+	phase_begin(&ph, "unlink");
+	for (i = 0; i < nFiles; i++) {
+		sprintf(name, BENCH_DIR "/F%05u.TXT", i);
+		check(f_unlink(name), "f_unlink");
+		ph.calls++;
+	}
+	check(f_unlink(BENCH_DIR), "f_unlink");
+	ph.calls++;
+	phase_end(&ph);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	FILE *trace = NULL;
+	unsigned long cmd_us = 0, sect_us = 0;
+	int c;
+
+	while ((c = getopt(argc, argv, "s:b:r:R:n:H:c:l:t:p")) != -1) {
+		switch (c) {
+		case 's': fileSize = strtoul(optarg, NULL, 0) * 1024; break;
+		case 'b': chunkSize = strtoul(optarg, NULL, 0); break;
+		case 'r': randCount = strtoul(optarg, NULL, 0); break;
+		case 'R': randSize = strtoul(optarg, NULL, 0); break;
+		case 'n': nFiles = strtoul(optarg, NULL, 0); break;
+		case 'H': nHot = strtoul(optarg, NULL, 0); break;
+		case 'c': cmd_us = strtoul(optarg, NULL, 0); break;
+		case 'l': sect_us = strtoul(optarg, NULL, 0); break;
+		case 't':
+			trace = fopen(optarg, "w");
+			if (!trace) {
+				perror(optarg);
+				return 1;
+			}
+			break;
+		case 'p': usePrealloc = 1; break;
+		default: usage(argv[0]);
+		}
+	}
+	if ((optind != argc - 1) || !chunkSize || !randSize || !nFiles || !nHot || (nHot > nFiles)) {
+		usage(argv[0]);
+	}
+
+	xferBuf = malloc(chunkSize > randSize ? chunkSize : randSize);
+	if (!xferBuf) {
+		return 1;
+	}
+	memset(xferBuf, 0xA5, chunkSize > randSize ? chunkSize : randSize);
+
+	if (FSIMG_Open(argv[optind])) {
+		perror(argv[optind]);
+		return 1;
+	}
+	FSIMG_SetLatency(cmd_us, sect_us);
+	FSIMG_SetTrace(trace);
+	check(f_mount(0, &fatFS), "f_mount");
+	if (!FSWB_Init()) {
+		fprintf(stderr, "FSWB_Init failed\n");
+		return 1;
+	}
+
+	printf("%-10s %8s %8s %10s %10s %14s %14s %6s %6s\n", "phase", "secs", "calls",
+		   "calls/s", "KB/s", "rd cmd/sect", "wr cmd/sect", "sect/c", "ampl");
+	bench_seq_write();
+	bench_wbehind();
+	bench_seq_read();
+	bench_random(0);
+	bench_random(1);
+	bench_dir();
+	check(f_unlink(BENCH_FILE), "f_unlink");
+
+	f_mount(0, NULL);
+	FSIMG_Close();
+	if (trace) {
+		fclose(trace);
+	}
+	free(xferBuf);
+
+	return 0;
+}
@@ -0,0 +1,240 @@
+/*
+ * @brief Chan FATFS disk image abstraction layer (for host builds)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "fs_image.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Disk Status */
+static volatile DSTATUS Stat = STA_NOINIT;
+static FILE *img;
+static DWORD sect_cnt;
+static unsigned long lat_cmd, lat_sect;
+static FILE *trace;
+static FSIMG_STATS_T stats;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Simulate the medium access time of a command */
+static void inject_latency(BYTE count)
+{
+	struct timespec ts;
+	unsigned long us = lat_cmd + (lat_sect * count);
+
+	if (us) {
+		ts.tv_sec = us / 1000000;
+		ts.tv_nsec = (us % 1000000) * 1000;
+		nanosleep(&ts, NULL);
+	}
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Attach the disk layer to an image file */
+int FSIMG_Open(const char *path)
+{
+	long sz;
+
+	img = fopen(path, "r+b");
+	if (!img) {
+		return -1;
+	}
+	fseek(img, 0, SEEK_END);
+	sz = ftell(img);
+	sect_cnt = (DWORD) (sz / SECTOR_SZ);
+	memset(&stats, 0, sizeof(stats));
+	Stat = STA_NOINIT;
+
+	return 0;
+}
+
+/* Detach the disk layer from the image file */
+void FSIMG_Close(void)
+{
+	if (img) {
+		fclose(img);
+		img = NULL;
+	}
+	Stat = STA_NOINIT;
+}
+
+/* Set latency injected on every disk access */
+void FSIMG_SetLatency(unsigned long cmd_us, unsigned long sect_us)
+{
+	lat_cmd = cmd_us;
+	lat_sect = sect_us;
+}
+
+/* Trace every sector access to a stream */
+void FSIMG_SetTrace(FILE *fp)
+{
+	trace = fp;
+}
+
+/* Get the disk access counters */
+void FSIMG_GetStats(FSIMG_STATS_T *s)
+{
+	*s = stats;
+}
+
+/* Initialize Disk Drive */
+DSTATUS disk_initialize(BYTE drv)
+{
+	if (drv) {
+		return STA_NOINIT;				/* Supports only single drive */
+	}
+
+	if (Stat != STA_NOINIT) {
+		return Stat;					/* Image is already attached */
+	}
+
+	if (img && sect_cnt) {
+		Stat &= ~STA_NOINIT;
+	}
+	return Stat;
+}
+
+/* Get Disk Status */
+DSTATUS disk_status(BYTE drv)
+{
+	if (drv) {
+		return STA_NOINIT;	/* Supports only single drive */
+	}
+	return Stat;
+}
+
+/* Read Sector(s) */
+DRESULT disk_read(BYTE drv, BYTE *buff, DWORD sector, BYTE count)
+{
+	if (drv || !count) {
+		return RES_PARERR;
+	}
+	if (Stat & STA_NOINIT) {
+		return RES_NOTRDY;
+	}
+	if (sector + count > sect_cnt) {
+		return RES_PARERR;
+	}
+
+	stats.rd_cmds++;
+	stats.rd_sects += count;
+	if (trace) {
+		fprintf(trace, "R %lu %u\n", (unsigned long) sector, count);
+	}
+	inject_latency(count);
+
+	if (fseek(img, (long) sector * SECTOR_SZ, SEEK_SET) ||
+		(fread(buff, SECTOR_SZ, count, img) != count)) {
+		return RES_ERROR;
+	}
+
+	return RES_OK;
+}
+
+/* Write Sector(s) */
+DRESULT disk_write(BYTE drv, const BYTE *buff, DWORD sector, BYTE count)
+{
+	if (drv || !count) {
+		return RES_PARERR;
+	}
+	if (Stat & STA_NOINIT) {
+		return RES_NOTRDY;
+	}
+	if (sector + count > sect_cnt) {
+		return RES_PARERR;
+	}
+
+	stats.wr_cmds++;
+	stats.wr_sects += count;
+	if (trace) {
+		fprintf(trace, "W %lu %u\n", (unsigned long) sector, count);
+	}
+	inject_latency(count);
+
+	if (fseek(img, (long) sector * SECTOR_SZ, SEEK_SET) ||
+		(fwrite(buff, SECTOR_SZ, count, img) != count)) {
+		return RES_ERROR;
+	}
+
+	return RES_OK;
+}
+
+/* Disk Drive miscellaneous Functions */
+DRESULT disk_ioctl(BYTE drv, BYTE ctrl, void *buff)
+{
+	if (drv) {
+		return RES_PARERR;
+	}
+	if (Stat & STA_NOINIT) {
+		return RES_NOTRDY;
+	}
+
+	switch (ctrl) {
+	case CTRL_SYNC:	/* Make sure that no pending write process */
+		stats.syncs++;
+		return fflush(img) ? RES_ERROR : RES_OK;
+
+	case GET_SECTOR_COUNT:	/* Get number of sectors on the disk (DWORD) */
+		*(DWORD *) buff = sect_cnt;
+		return RES_OK;
+
+	case GET_SECTOR_SIZE:	/* Get R/W sector size (WORD) */
+		*(WORD *) buff = SECTOR_SZ;
+		return RES_OK;
+
+	case GET_BLOCK_SIZE:/* Get erase block size in unit of sector (DWORD) */
+		*(DWORD *) buff = 1;
+		return RES_OK;
+
+	default:
+		return RES_PARERR;
+	}
+}
+
+/* Time stamp for the directory entries */
+DWORD get_fattime(void)
+{
+	time_t t = time(NULL);
+	struct tm *tm = localtime(&t);
+
+	return ((DWORD) (tm->tm_year - 80) << 25) | ((DWORD) (tm->tm_mon + 1) << 21) |
+		   ((DWORD) tm->tm_mday << 16) | ((DWORD) tm->tm_hour << 11) |
+		   ((DWORD) tm->tm_min << 5) | ((DWORD) tm->tm_sec >> 1);
+}
@@ -0,0 +1,103 @@
+/*
+ * @brief Chan FATFS disk image abstraction layer (for host builds)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __FS_IMAGE_H_
+#define __FS_IMAGE_H_
+
+#include <stdio.h>
+#include "diskio.h"
+
+#define SECTOR_SZ            512 /* Size of a single sector */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup LPCOPEN_FSLIBS_CHANFATFS_FSIMAGE Disk image based file system support
+ * @ingroup LPCOPEN_FSLIBS_CHANFATFS
+ * Host (Linux) disk layer over a raw FAT image file, with injectable
+ * latency and sector access tracing for measuring FatFs apart from the medium.
+ * @{
+ */
+
+/** Disk access counters, cumulative since FSIMG_Open() */
+typedef struct {
+	unsigned long rd_cmds;		/*!< Number of disk_read calls */
+	unsigned long rd_sects;		/*!< Number of sectors read */
+	unsigned long wr_cmds;		/*!< Number of disk_write calls */
+	unsigned long wr_sects;		/*!< Number of sectors written */
+	unsigned long syncs;		/*!< Number of CTRL_SYNC requests */
+} FSIMG_STATS_T;
+
+/**
+ * @brief	Attach the disk layer to an image file
+ * @param	path	: Path of the raw FAT image (no partition table or MBR)
+ * @return	0 on success, -1 if the image could not be opened
+ */
+int FSIMG_Open(const char *path);
+
+/**
+ * @brief	Detach the disk layer from the image file
+ * @return	Nothing
+ */
+void FSIMG_Close(void);
+
+/**
+ * @brief	Set latency injected on every disk access
+ * @param	cmd_us	: Fixed latency per read/write command in microseconds
+ * @param	sect_us	: Additional latency per sector in microseconds
+ * @return	Nothing
+ */
+void FSIMG_SetLatency(unsigned long cmd_us, unsigned long sect_us);
+
+/**
+ * @brief	Trace every sector access to a stream
+ * @param	fp	: Stream receiving one "R|W sector count" line per access, NULL to disable
+ * @return	Nothing
+ */
+void FSIMG_SetTrace(FILE *fp);
+
+/**
+ * @brief	Get the disk access counters
+ * @param	stats	: Pointer to the structure receiving the counters
+ * @return	Nothing
+ */
+void FSIMG_GetStats(FSIMG_STATS_T *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef __FS_IMAGE_H_ */
@@ -0,0 +1,127 @@
+/*
+ * @brief FreeRTOS subset on POSIX threads (for host builds)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#ifndef __FREERTOS_HOST_H_
+#define __FREERTOS_HOST_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup LPCOPEN_FSLIBS_CHANFATFS_RTOSHOST FreeRTOS subset for host builds
+ * @ingroup LPCOPEN_FSLIBS_CHANFATFS
+ * The FreeRTOS V8 queue, semaphore and task calls used by fs_wbehind.c,
+ * implemented on POSIX threads so the write-behind task runs in the host
+ * benchmark. Tasks are threads without priorities, a tick is 1 ms.
+ * @{
+ */
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void *);
+typedef struct host_queue *QueueHandle_t;
+typedef QueueHandle_t SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+
+#define pdFALSE                  ((BaseType_t) 0)
+#define pdTRUE                   ((BaseType_t) 1)
+#define pdPASS                   pdTRUE
+#define pdFAIL                   pdFALSE
+#define portMAX_DELAY            ((TickType_t) 0xffffffffUL)
+#define configTICK_RATE_HZ       1000
+#define portTICK_PERIOD_MS       ((TickType_t) 1000 / configTICK_RATE_HZ)
+#define configMINIMAL_STACK_SIZE 128
+#define tskIDLE_PRIORITY         ((UBaseType_t) 0)
+
+/**
+ * @brief	Create a queue
+ * @param	uxQueueLength	: Maximum number of items
+ * @param	uxItemSize		: Size of an item in bytes, 0 for a semaphore
+ * @return	The queue, NULL if out of memory
+ */
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+
+/**
+ * @brief	Copy an item to the back of a queue
+ * @param	xQueue			: Queue
+ * @param	pvItemToQueue	: Item, ignored for a semaphore
+ * @param	xTicksToWait	: Ticks to wait while the queue is full
+ * @return	pdTRUE if the item was queued, pdFALSE on timeout
+ */
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+
+/**
+ * @brief	Take the item at the front of a queue
+ * @param	xQueue			: Queue
+ * @param	pvBuffer		: Receives the item, ignored for a semaphore
+ * @param	xTicksToWait	: Ticks to wait while the queue is empty
+ * @return	pdTRUE if an item was received, pdFALSE on timeout
+ */
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+
+/**
+ * @brief	Delete a queue or semaphore
+ * @param	xQueue	: Queue
+ * @return	Nothing
+ */
+void vQueueDelete(QueueHandle_t xQueue);
+
+/**
+ * @brief	Start a task as a detached thread
+ * @param	pxTaskCode		: Task function, must not return
+ * @param	pcName			: Ignored
+ * @param	usStackDepth	: Ignored
+ * @param	pvParameters	: Passed to the task function
+ * @param	uxPriority		: Ignored
+ * @param	pxCreatedTask	: Ignored, may be NULL
+ * @return	pdPASS on success, pdFAIL if the thread could not be created
+ */
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName, uint16_t usStackDepth,
+					   void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask);
+
+/**
+ * @brief	Milliseconds of the monotonic clock
+ * @return	Tick count
+ */
+TickType_t xTaskGetTickCount(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FREERTOS_HOST_H_ */
@@ -0,0 +1,227 @@
+/*
+ * @brief FreeRTOS subset on POSIX threads (for host builds)
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Ring of items guarded by a mutex, a semaphore has items without data */
+struct host_queue {
+	pthread_mutex_t lock;
+	pthread_cond_t changed;		/* Item added or removed */
+	UBaseType_t length;
+	UBaseType_t size;
+	UBaseType_t count;
+	UBaseType_t head;
+	unsigned char *items;
+};
+
+/* Start routine and argument of a task */
+struct host_task {
+	TaskFunction_t code;
+	void *param;
+};
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Absolute CLOCK_MONOTONIC time ticks from now */
+static void deadline(struct timespec *ts, TickType_t ticks)
+{
+	clock_gettime(CLOCK_MONOTONIC, ts);
+	ts->tv_sec += ticks / 1000;
+	ts->tv_nsec += (long) (ticks % 1000) * 1000000L;
+	if (ts->tv_nsec >= 1000000000L) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+/* Waits until cond holds, returns 0 on timeout. Called with the lock held. */
+static int wait_for(struct host_queue *q, int (*cond)(struct host_queue *), TickType_t ticks)
+{
+	struct timespec ts;
+
+	if (ticks != portMAX_DELAY) {
+		deadline(&ts, ticks);
+	}
+	while (!cond(q)) {
+		if (ticks == 0) {
+			return 0;
+		}
+		if (ticks == portMAX_DELAY) {
+			pthread_cond_wait(&q->changed, &q->lock);
+		}
+		else if (pthread_cond_timedwait(&q->changed, &q->lock, &ts) == ETIMEDOUT) {
+			return cond(q);
+		}
+	}
+	return 1;
+}
+
+static int has_space(struct host_queue *q)
+{
+	return q->count < q->length;
+}
+
+static int has_item(struct host_queue *q)
+{
+	return q->count > 0;
+}
+
+static void *task_main(void *arg)
+{
+	struct host_task task = *(struct host_task *) arg;
+
+	free(arg);
+	task.code(task.param);
+	return NULL;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Create a queue */
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+	struct host_queue *q;
+	pthread_condattr_t attr;
+
+	q = calloc(1, sizeof(*q));
+	if (!q) {
+		return NULL;
+	}
+	q->items = malloc(uxQueueLength * uxItemSize + 1);
+	if (!q->items) {
+		free(q);
+		return NULL;
+	}
+	q->length = uxQueueLength;
+	q->size = uxItemSize;
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&q->changed, &attr);
+	pthread_condattr_destroy(&attr);
+	return q;
+}
+
+/* Copy an item to the back of a queue */
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+	struct host_queue *q = xQueue;
+
+	pthread_mutex_lock(&q->lock);
+	if (!wait_for(q, has_space, xTicksToWait)) {
+		pthread_mutex_unlock(&q->lock);
+		return pdFALSE;
+	}
+	if (q->size) {
+		memcpy(&q->items[((q->head + q->count) % q->length) * q->size], pvItemToQueue, q->size);
+	}
+	q->count++;
+	pthread_cond_broadcast(&q->changed);
+	pthread_mutex_unlock(&q->lock);
+	return pdTRUE;
+}
+
+/* Take the item at the front of a queue */
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+	struct host_queue *q = xQueue;
+
+	pthread_mutex_lock(&q->lock);
+	if (!wait_for(q, has_item, xTicksToWait)) {
+		pthread_mutex_unlock(&q->lock);
+		return pdFALSE;
+	}
+	if (q->size) {
+		memcpy(pvBuffer, &q->items[q->head * q->size], q->size);
+	}
+	q->head = (q->head + 1) % q->length;
+	q->count--;
+	pthread_cond_broadcast(&q->changed);
+	pthread_mutex_unlock(&q->lock);
+	return pdTRUE;
+}
+
+/* Delete a queue or semaphore */
+void vQueueDelete(QueueHandle_t xQueue)
+{
+	pthread_cond_destroy(&xQueue->changed);
+	pthread_mutex_destroy(&xQueue->lock);
+	free(xQueue->items);
+	free(xQueue);
+}
+
+/* Start a task as a detached thread */
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName, uint16_t usStackDepth,
+					   void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask)
+{
+	struct host_task *task;
+	pthread_t thread;
+
+	(void) pcName;
+	(void) usStackDepth;
+	(void) uxPriority;
+	(void) pxCreatedTask;
+
+	task = malloc(sizeof(*task));
+	if (!task) {
+		return pdFAIL;
+	}
+	task->code = pxTaskCode;
+	task->param = pvParameters;
+	if (pthread_create(&thread, NULL, task_main, task) != 0) {
+		free(task);
+		return pdFAIL;
+	}
+	pthread_detach(thread);
+	return pdPASS;
+}
+
+/* Milliseconds of the monotonic clock */
+TickType_t xTaskGetTickCount(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (TickType_t) (ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
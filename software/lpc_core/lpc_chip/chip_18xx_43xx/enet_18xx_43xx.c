@@ -135,6 +135,79 @@ void Chip_ENET_StartMIIRead(LPC_ENET_T *pENET, uint8_t reg)
 	pENET->MAC_MII_ADDR |= MAC_MIIA_GB;
 }
 
+/* Starts the IEEE 1588 system time and timestamps all frames */
+uint32_t Chip_ENET_TSInit(LPC_ENET_T *pENET, uint32_t clkRate, const ENET_TIME_T *pTime)
+{
+	uint32_t ssinc, addend;
+
+	/* The accumulator overflows at about half the clock rate, each overflow
+	   adds ssinc nanoseconds to the system time */
+	ssinc = (2 * ENET_TS_NSEC_PER_SEC + clkRate - 1) / clkRate;
+	addend = (uint32_t) ((((uint64_t) ENET_TS_NSEC_PER_SEC / ssinc) << 32) / clkRate);
+
+	/* The trigger interrupt is not used */
+	pENET->MAC_INTR_MASK |= MAC_IM_TS;
+
+	pENET->MAC_TIMESTP_CTRL = MAC_TS_TSENA | MAC_TS_TSCTRL | MAC_TS_TSENAL;
+	pENET->SUBSECOND_INCR = ssinc;
+
+	Chip_ENET_TSSetAddend(pENET, addend);
+	pENET->MAC_TIMESTP_CTRL |= MAC_TS_TSCFUP;
+
+	Chip_ENET_TSSetTime(pENET, pTime);
+
+	return addend;
+}
+
+/* Reads the IEEE 1588 system time */
+void Chip_ENET_TSGetTime(LPC_ENET_T *pENET, ENET_TIME_T *pTime)
+{
+	uint32_t sec;
+
+	/* Re-read if the seconds rolled over between the two reads */
+	do {
+		sec = pENET->SECONDS;
+		pTime->nanoseconds = pENET->NANOSECONDS;
+		pTime->seconds = pENET->SECONDS;
+	} while (sec != pTime->seconds);
+}
+
+/* Sets the IEEE 1588 system time */
+void Chip_ENET_TSSetTime(LPC_ENET_T *pENET, const ENET_TIME_T *pTime)
+{
+	while (pENET->MAC_TIMESTP_CTRL & (MAC_TS_TSINIT | MAC_TS_TSUPDT)) {}
+
+	pENET->SECONDSUPDATE = pTime->seconds;
+	pENET->NANOSECONDSUPDATE = pTime->nanoseconds;
+	pENET->MAC_TIMESTP_CTRL |= MAC_TS_TSINIT;
+}
+
+/* Adds or subtracts an offset to the IEEE 1588 system time */
+void Chip_ENET_TSUpdateTime(LPC_ENET_T *pENET, const ENET_TIME_T *pOffset, bool subtract)
+{
+	while (pENET->MAC_TIMESTP_CTRL & (MAC_TS_TSINIT | MAC_TS_TSUPDT)) {}
+
+	pENET->SECONDSUPDATE = pOffset->seconds;
+	if (subtract) {
+		/* Digital rollover subtracts the complement of the nanoseconds */
+		pENET->NANOSECONDSUPDATE = MAC_TSNS_ADDSUB |
+								   (ENET_TS_NSEC_PER_SEC - pOffset->nanoseconds);
+	}
+	else {
+		pENET->NANOSECONDSUPDATE = pOffset->nanoseconds;
+	}
+	pENET->MAC_TIMESTP_CTRL |= MAC_TS_TSUPDT;
+}
+
+/* Sets the addend of the fine update accumulator */
+void Chip_ENET_TSSetAddend(LPC_ENET_T *pENET, uint32_t addend)
+{
+	while (pENET->MAC_TIMESTP_CTRL & MAC_TS_TSADDR) {}
+
+	pENET->ADDEND = addend;
+	pENET->MAC_TIMESTP_CTRL |= MAC_TS_TSADDR;
+}
+
 /* Sets full or half duplex for the interface */
 void Chip_ENET_SetDuplex(LPC_ENET_T *pENET, bool full)
 {
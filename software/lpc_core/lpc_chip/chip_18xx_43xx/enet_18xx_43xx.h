@@ -175,6 +175,7 @@ typedef struct {							/*!< ETHERNET Structure */
  * @brief MAC_INTR_MASK register bit defines
  */
 #define MAC_IM_PMT     (1 << 3)		/*!< PMT Interrupt Mask */
+#define MAC_IM_TS      (1 << 9)		/*!< Time Stamp Interrupt Mask */
 
 /*
  * @brief MAC_ADDR0_HIGH register bit defines
@@ -206,6 +207,16 @@ typedef struct {							/*!< ETHERNET Structure */
 #define MAC_TS_TSCLKT(n) ((n) << 16)	/*!< Select the type of clock node, n = see menual */
 #define MAC_TS_TSENMA  (1 << 18)	/*!< Enable MAC address for PTP frame filtering */
 
+/*
+ * @brief NANOSECONDSUPDATE register bit defines
+ */
+#define MAC_TSNS_ADDSUB (1UL << 31)	/*!< Subtract the update value from the system time */
+
+/*
+ * @brief Nanoseconds per second of the system time in digital rollover mode
+ */
+#define ENET_TS_NSEC_PER_SEC (1000000000UL)
+
 /*
  * @brief DMA_BUS_MODE register bit defines
  */
@@ -387,13 +398,16 @@ typedef struct {							/*!< ETHERNET Structure */
 /*
  * @brief REC_DESC_ENH_T only EXTSTAT field bit defines
  */
-#define RDES_ENH_IPPL(n)  (((n) & 0x7) >> 2)	/*!< IP Payload Type mask and shift, enhanced descripto */
+#define RDES_ENH_IPPL(n)  ((n) & 0x7)	/*!< IP Payload Type mask, enhanced descripto */
+#define RDES_ENH_IPPL_UDP  1		/*!< IP Payload Type UDP, enhanced descripto */
+#define RDES_ENH_IPPL_TCP  2		/*!< IP Payload Type TCP, enhanced descripto */
+#define RDES_ENH_IPPL_ICMP 3		/*!< IP Payload Type ICMP, enhanced descripto */
 #define RDES_ENH_IPHE     (1 << 3)	/*!< IP Header Error, enhanced descripto */
 #define RDES_ENH_IPPLE    (1 << 4)	/*!< IP Payload Error, enhanced descripto */
 #define RDES_ENH_IPCSB    (1 << 5)	/*!< IP Checksum Bypassed, enhanced descripto */
 #define RDES_ENH_IPV4     (1 << 6)	/*!< IPv4 Packet Received, enhanced descripto */
 #define RDES_ENH_IPV6     (1 << 7)	/*!< IPv6 Packet Received, enhanced descripto */
-#define RDES_ENH_MTMSK(n) (((n) & 0xF) >> 8)	/*!< Message Type mask and shift, enhanced descripto */
+#define RDES_ENH_MTMSK(n) (((n) >> 8) & 0xF)	/*!< Message Type mask and shift, enhanced descripto */
 
 /*
  * @brief Maximum size of an ethernet buffer
@@ -448,6 +462,14 @@ typedef struct {
 	__IO uint32_t RTSH;			/*!< Timestamp value high */
 } ENET_ENHRXDESC_T;
 
+/**
+ * @brief IEEE 1588 system time or frame timestamp
+ */
+typedef struct {
+	uint32_t seconds;			/*!< Seconds */
+	uint32_t nanoseconds;		/*!< Nanoseconds, 0 to 999999999 */
+} ENET_TIME_T;
+
 /**
  * @brief	Resets the ethernet interface
  * @param	pENET	: The base of ENET peripheral on the chip
@@ -651,6 +673,51 @@ STATIC INLINE void Chip_ENET_TXStart(LPC_ENET_T *pENET)
 	pENET->DMA_TRANS_POLL_DEMAND = 1;
 }
 
+/**
+ * @brief	Starts the IEEE 1588 system time and timestamps all frames
+ * @param	pENET	: The base of ENET peripheral on the chip
+ * @param	clkRate	: Rate of the PTP reference (ENET register) clock in Hz
+ * @param	pTime	: Initial system time
+ * @return	Addend value giving the nominal rate, see Chip_ENET_TSSetAddend()
+ * @note	The system time runs in fine update mode with digital (nanosecond)
+ * rollover. Timestamps are written to the enhanced descriptors of received
+ * frames and of transmitted frames queued with TDES_ENH_TTSE.
+ */
+uint32_t Chip_ENET_TSInit(LPC_ENET_T *pENET, uint32_t clkRate, const ENET_TIME_T *pTime);
+
+/**
+ * @brief	Reads the IEEE 1588 system time
+ * @param	pENET	: The base of ENET peripheral on the chip
+ * @param	pTime	: Pointer to time to fill
+ * @return	Nothing
+ */
+void Chip_ENET_TSGetTime(LPC_ENET_T *pENET, ENET_TIME_T *pTime);
+
+/**
+ * @brief	Sets the IEEE 1588 system time
+ * @param	pENET	: The base of ENET peripheral on the chip
+ * @param	pTime	: New system time
+ * @return	Nothing
+ */
+void Chip_ENET_TSSetTime(LPC_ENET_T *pENET, const ENET_TIME_T *pTime);
+
+/**
+ * @brief	Adds or subtracts an offset to the IEEE 1588 system time
+ * @param	pENET		: The base of ENET peripheral on the chip
+ * @param	pOffset		: Offset magnitude
+ * @param	subtract	: true to move the time back, false to move it forward
+ * @return	Nothing
+ */
+void Chip_ENET_TSUpdateTime(LPC_ENET_T *pENET, const ENET_TIME_T *pOffset, bool subtract);
+
+/**
+ * @brief	Sets the addend of the fine update accumulator
+ * @param	pENET	: The base of ENET peripheral on the chip
+ * @param	addend	: New addend, larger values speed up the system time
+ * @return	Nothing
+ */
+void Chip_ENET_TSSetAddend(LPC_ENET_T *pENET, uint32_t addend);
+
 /**
  * @brief	Initialize ethernet interface
  * @param	pENET	: The base of ENET peripheral on the chip
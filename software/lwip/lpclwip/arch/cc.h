@@ -90,8 +90,37 @@ typedef uintptr_t          mem_ptr_t;
 //	#define ALIGNED(n)  __align(n)
 #endif 
 
+/* Set to 0 (normally in lwipopts.h) to use the lwIP reference checksum
+   instead of the word based routines in lpc_chksum.c */
+#ifndef LPC_FAST_CHKSUM
+#define LPC_FAST_CHKSUM 1
+#endif
+
+#if LPC_FAST_CHKSUM
+/**
+ * @brief	Computes the Internet checksum of a buffer
+ * @param	dataptr	: Data to sum, any alignment
+ * @param	len		: Number of bytes to sum
+ * @return	Non-inverted 16-bit one's complement sum in network order
+ */
+u16_t lpc_chksum(void *dataptr, int len);
+
+/**
+ * @brief	Copies a buffer and computes the Internet checksum of the copy
+ * @param	dst		: Destination, any alignment
+ * @param	src		: Source, any alignment
+ * @param	len		: Number of bytes to copy
+ * @return	Same as lpc_chksum() on the copied data
+ * @note	The source is read once, the copy and the sum share the loads
+ */
+u16_t lpc_chksum_copy(void *dst, const void *src, u16_t len);
+
+#define LWIP_CHKSUM lpc_chksum
+#define LWIP_CHKSUM_COPY(dst, src, len) lpc_chksum_copy(dst, src, len)
+#else
 /* Used with IP headers only */
 #define LWIP_CHKSUM_ALGORITHM 1
+#endif
 
 #ifdef LWIP_DEBUG
 /**
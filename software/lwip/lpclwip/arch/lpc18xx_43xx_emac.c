@@ -36,6 +36,7 @@
 #include "lwip/pbuf.h"
 #include "lwip/stats.h"
 #include "lwip/snmp.h"
+#include "arch/perf.h"
 #include "netif/etharp.h"
 #include "netif/ppp_oe.h"
 
@@ -62,6 +63,112 @@ extern void msDelay(uint32_t ms);
 #error LPC_CHECK_SLOWMEM must be 0 or 1
 #endif
 
+/* Maximum time in milliseconds the transmit function waits for free TX
+   descriptors before the packet is dropped with ERR_MEM */
+#ifndef LPC_TX_DESC_TIMEOUT
+#define LPC_TX_DESC_TIMEOUT 50
+#endif
+
+/* Set to 1 (normally in lwipopts.h, together with the CHECKSUM_GEN_x and
+   CHECKSUM_CHECK_x options set to 0) to let the MAC insert the IP, UDP, TCP
+   and ICMP checksums of transmitted frames and to drop received frames
+   that fail the MAC checksum check. TX checksum insertion requires the
+   TX FIFO to run in store and forward mode. */
+#ifndef LPC_CHECKSUM_OFFLOAD
+#define LPC_CHECKSUM_OFFLOAD 0
+#endif
+
+#if (LPC_CHECKSUM_OFFLOAD == 0) && \
+	(!CHECKSUM_GEN_IP || !CHECKSUM_GEN_UDP || !CHECKSUM_GEN_TCP || !CHECKSUM_GEN_ICMP)
+#error Disabling lwIP checksum generation requires LPC_CHECKSUM_OFFLOAD
+#endif
+
+#if LPC_CHECKSUM_OFFLOAD == 1
+/* Insert IP header and payload checksums, pseudo-header computed by MAC */
+#define LPC_TX_CIC TDES_ENH_CIC(3)
+#else
+#define LPC_TX_CIC TDES_ENH_CIC(0)
+#endif
+
+/* Set to 1 to receive into a driver owned pool of custom pbufs instead of
+   allocating RX pbufs from the lwIP heap. Freed pool pbufs are handed
+   straight back to the RX descriptor ring. */
+#ifndef LPC_RX_PBUF_POOL
+#define LPC_RX_PBUF_POOL 0
+#endif
+
+#if LPC_RX_PBUF_POOL == 1
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error LPC_RX_PBUF_POOL requires LWIP_SUPPORT_CUSTOM_PBUF
+#endif
+
+/* Number of full size frame buffers in the RX pool. Buffers beyond the
+   descriptor count cover packets held by the stack (TCP out-of-sequence
+   queue, reassembly, application receive mailboxes). */
+#ifndef LPC_NUM_RX_POOL_PBUFS
+#define LPC_NUM_RX_POOL_PBUFS (LPC_NUM_BUFF_RXDESCS * 2)
+#endif
+
+#if LPC_NUM_RX_POOL_PBUFS < LPC_NUM_BUFF_RXDESCS
+#error LPC_NUM_RX_POOL_PBUFS must be at least LPC_NUM_BUFF_RXDESCS
+#endif
+
+/* Placement attribute for the RX pool, used to locate it in a fast SRAM
+   bank via a linker script section */
+#ifndef LPC_RX_POOL_ATTR
+#define LPC_RX_POOL_ATTR
+#endif
+
+/* The RX ring state is shared with the pool free function, which runs in
+   the context of whichever task releases the packet */
+#define LPC_RX_DECL_PROTECT(lev)    SYS_ARCH_DECL_PROTECT(lev)
+#define LPC_RX_PROTECT(lev)         SYS_ARCH_PROTECT(lev)
+#define LPC_RX_UNPROTECT(lev)       SYS_ARCH_UNPROTECT(lev)
+#else
+#define LPC_RX_DECL_PROTECT(lev)
+#define LPC_RX_PROTECT(lev)
+#define LPC_RX_UNPROTECT(lev)
+#endif
+
+#if NO_SYS == 0
+/* RX interrupt coalescing. When non-zero, the first RX interrupt masks
+   further RX interrupts and the receive task polls the ring, handing at
+   most this many frames to lwIP before giving up the CPU. RX interrupts
+   are re-enabled once the ring is empty. 0 selects one wakeup per RX
+   interrupt. */
+#ifndef LPC_RX_POLL_BUDGET
+#define LPC_RX_POLL_BUDGET 0
+#endif
+
+/* Ticks the receive task sleeps when it used up its budget with frames
+   still pending. 0 only yields to tasks of the same priority; 1 or more
+   also lets lower priority tasks run during a flood at the cost of ring
+   overruns. */
+#ifndef LPC_RX_POLL_DELAY
+#define LPC_RX_POLL_DELAY 0
+#endif
+#endif
+
+/* IEEE 1588 hardware timestamps. When enabled, every received pbuf and
+   every transmitted frame carries the system time at which its SFD passed
+   the MAC in pbuf->ts. Requires LWIP_PBUF_TIMESTAMP. */
+#ifndef LPC_PTP_TIMESTAMPS
+#define LPC_PTP_TIMESTAMPS 0
+#endif
+
+#if (LPC_PTP_TIMESTAMPS == 1) && !LWIP_PBUF_TIMESTAMP
+#error LPC_PTP_TIMESTAMPS requires LWIP_PBUF_TIMESTAMP
+#endif
+
+#if LPC_PTP_TIMESTAMPS == 1
+#define LPC_TX_TTSE TDES_ENH_TTSE
+#else
+#define LPC_TX_TTSE 0
+#endif
+
+/* RX group interrupt enables */
+#define LPC_RX_INTS (DMA_IE_RIE | DMA_IE_RUE | DMA_IE_OVE)
+
 /** @ingroup NET_LWIP_LPC18XX43XX_EMAC_DRIVER
  * @{
  */
@@ -101,17 +208,38 @@ struct lpc_enetdata {
 	volatile u32_t tx_free_descs;	/**< Number of free TX descriptors */
 	u32_t tx_fill_idx;	/**< Current free TX descriptor index */
 	u32_t tx_reclaim_idx;	/**< Next incoming TX packet descriptor index */
+	u32_t tx_frames;	/**< Frames queued for transmit */
+	u32_t tx_stalls;	/**< Frames that had to wait for TX descriptors */
+	u32_t tx_timeouts;	/**< Frames dropped after LPC_TX_DESC_TIMEOUT */
+	u32_t tx_errors;	/**< Frames completed with a TX error status */
+	u32_t tx_bounced;	/**< Segments sent from a bounce buffer */
 	struct pbuf *rxpbufs[LPC_NUM_BUFF_RXDESCS];	/**< Saved pbuf pointers for RX */
 
 	volatile u32_t rx_free_descs;	/**< Number of free RX descriptors */
 	volatile u32_t rx_get_idx;	/**< Index to next RX descriptor that id to be received */
 	u32_t rx_next_idx;	/**< Index to next RX descriptor that needs a pbuf */
+	u32_t rx_refill_fail;	/**< Descriptor refills that found no buffer */
+	volatile u32_t rx_dma_unavail;	/**< Frames that found the RX ring empty */
+	volatile u32_t rx_irqs;	/**< RX interrupts that woke the receive task */
+	u32_t rx_frames;	/**< Frames handled by the receive task */
+	u32_t rx_max_batch;	/**< Most frames handled for one RX interrupt */
+	u32_t rx_budget_hits;	/**< Times the receive task used up its budget */
+	u32_t rx_drops;	/**< Frames dropped for receive or checksum errors */
+#if LPC_RX_PBUF_POOL == 1
+	struct pbuf *rx_pool_free;	/**< Free list of RX pool pbufs */
+	u32_t rx_pool_nfree;	/**< Number of pbufs on the free list */
+	u32_t rx_pool_min;	/**< Free list low water mark */
+#endif
 #if NO_SYS == 0
 	sys_sem_t RxSem;/**< RX receive thread wakeup semaphore */
 	sys_sem_t TxCleanSem;	/**< TX cleanup thread wakeup semaphore */
 	sys_mutex_t TXLockMutex;/**< TX critical section mutex */
 	SemaphoreHandle_t xTXDCountSem;	/**< TX free buffer counting semaphore */
 #endif
+#if LPC_PTP_TIMESTAMPS == 1
+	u32_t ptp_addend;	/**< Timestamp addend for the nominal clock rate */
+	lpc_emac_tx_ts_fn tx_ts_cb;	/**< Called with each TX timestamp */
+#endif
 };
 
 /* LPC EMAC driver work data */
@@ -126,6 +254,22 @@ struct lpc_slowmem_array_t {
 };
 
 const static struct lpc_slowmem_array_t slmem[] = LPC_SLOWMEM_ARRAY;
+
+/* TX bounce buffers, one per TX descriptor. A pbuf segment in slow memory
+   is copied into the bounce buffer of the descriptor that sends it. */
+static u32_t lpc_tx_bounce[LPC_NUM_BUFF_TXDESCS][EMAC_ETH_MAX_FLEN / sizeof(u32_t)];
+#endif
+
+#if LPC_RX_PBUF_POOL == 1
+/* RX pool buffer. The frame buffer directly follows the pbuf so lwIP can
+   move the payload back over stripped headers the same way it does for
+   PBUF_POOL pbufs. */
+struct lpc_rx_pbuf {
+	struct pbuf_custom pc;
+	u32_t buff[EMAC_ETH_MAX_FLEN / sizeof(u32_t)];
+};
+
+static struct lpc_rx_pbuf lpc_rx_pool[LPC_NUM_RX_POOL_PBUFS] LPC_RX_POOL_ATTR;
 #endif
 
 /*****************************************************************************
@@ -171,6 +315,77 @@ static void lpc_rxqueue_pbuf(struct lpc_enetdata *lpc_netifdata,
 	lpc_netifdata->rx_next_idx = idx;
 }
 
+#if LPC_RX_PBUF_POOL == 1
+static void lpc_rxpool_free(struct pbuf *p);
+
+/* (Re)initializes a pool pbuf for a full size frame */
+static struct pbuf *lpc_rxpool_init_pbuf(struct lpc_rx_pbuf *rb)
+{
+	rb->pc.custom_free_function = lpc_rxpool_free;
+
+	/* PBUF_POOL keeps pbuf_realloc() from trimming the buffer through the
+	   heap; the custom flag routes pbuf_free() back to this driver */
+	return pbuf_alloced_custom(PBUF_RAW, (u16_t) EMAC_ETH_MAX_FLEN, PBUF_POOL,
+							   &rb->pc, rb->buff, (u16_t) sizeof(rb->buff));
+}
+
+/* Takes a pbuf from the RX pool, called with the RX ring protected */
+static struct pbuf *lpc_rxpool_get(struct lpc_enetdata *lpc_netifdata)
+{
+	struct pbuf *p = lpc_netifdata->rx_pool_free;
+
+	if (p == NULL) {
+		return NULL;
+	}
+
+	lpc_netifdata->rx_pool_free = p->next;
+	lpc_netifdata->rx_pool_nfree--;
+	if (lpc_netifdata->rx_pool_nfree < lpc_netifdata->rx_pool_min) {
+		lpc_netifdata->rx_pool_min = lpc_netifdata->rx_pool_nfree;
+	}
+
+	return lpc_rxpool_init_pbuf((struct lpc_rx_pbuf *) p);
+}
+
+/* Custom pbuf free function for the RX pool. The buffer goes straight back
+   to the descriptor ring if a descriptor is waiting for one, otherwise it
+   is kept on the free list. */
+static void lpc_rxpool_free(struct pbuf *p)
+{
+	struct lpc_enetdata *lpc_netifdata = &lpc_enetdata;
+	LPC_RX_DECL_PROTECT(lev);
+
+	LPC_RX_PROTECT(lev);
+	if (lpc_netifdata->rx_free_descs > 0) {
+		lpc_rxqueue_pbuf(lpc_netifdata,
+						 lpc_rxpool_init_pbuf((struct lpc_rx_pbuf *) p));
+
+		/* Restart reception in case the DMA suspended on an empty ring */
+		LPC_ETHERNET->DMA_REC_POLL_DEMAND = 1;
+	}
+	else {
+		p->next = lpc_netifdata->rx_pool_free;
+		lpc_netifdata->rx_pool_free = p;
+		lpc_netifdata->rx_pool_nfree++;
+	}
+	LPC_RX_UNPROTECT(lev);
+}
+
+/* Places all RX pool pbufs on the free list */
+static void lpc_rxpool_setup(struct lpc_enetdata *lpc_netifdata)
+{
+	s32_t idx;
+
+	lpc_netifdata->rx_pool_free = NULL;
+	for (idx = LPC_NUM_RX_POOL_PBUFS - 1; idx >= 0; idx--) {
+		lpc_rx_pool[idx].pc.pbuf.next = lpc_netifdata->rx_pool_free;
+		lpc_netifdata->rx_pool_free = &lpc_rx_pool[idx].pc.pbuf;
+	}
+	lpc_netifdata->rx_pool_nfree = LPC_NUM_RX_POOL_PBUFS;
+	lpc_netifdata->rx_pool_min = LPC_NUM_RX_POOL_PBUFS;
+}
+#endif
+
 /* This function sets up the descriptor list used for receive packets */
 static err_t lpc_rx_setup(struct lpc_enetdata *lpc_netifdata)
 {
@@ -180,6 +395,16 @@ static err_t lpc_rx_setup(struct lpc_enetdata *lpc_netifdata)
 	lpc_netifdata->rx_get_idx = 0;
 	lpc_netifdata->rx_next_idx = 0;
 	lpc_netifdata->rx_free_descs = LPC_NUM_BUFF_RXDESCS;
+	lpc_netifdata->rx_refill_fail = 0;
+	lpc_netifdata->rx_dma_unavail = 0;
+	lpc_netifdata->rx_irqs = 0;
+	lpc_netifdata->rx_frames = 0;
+	lpc_netifdata->rx_max_batch = 0;
+	lpc_netifdata->rx_budget_hits = 0;
+	lpc_netifdata->rx_drops = 0;
+#if LPC_RX_PBUF_POOL == 1
+	lpc_rxpool_setup(lpc_netifdata);
+#endif
 
 	/* Clear initial RX descriptor list */
 	memset(lpc_netifdata->prdesc, 0, sizeof(lpc_netifdata->prdesc));
@@ -211,8 +436,13 @@ static err_t lpc_rx_setup(struct lpc_enetdata *lpc_netifdata)
 static struct pbuf *lpc_low_level_input(struct netif *netif) {
 	struct lpc_enetdata *lpc_netifdata = netif->state;
 	u32_t status, ridx;
+#if LPC_PTP_TIMESTAMPS == 1
+	u32_t ts_sec, ts_nsec;
+#endif
 	int rxerr = 0;
 	struct pbuf *p;
+	PERF_START;
+	LPC_RX_DECL_PROTECT(lev);
 
 #ifdef LOCK_RX_THREAD
 #if NO_SYS == 0
@@ -221,6 +451,14 @@ static struct pbuf *lpc_low_level_input(struct netif *netif) {
 #endif
 #endif
 
+#if NO_SYS == 1
+	/* Count frames the DMA could not store because the ring was empty */
+	if (LPC_ETHERNET->DMA_STAT & DMA_ST_RU) {
+		LPC_ETHERNET->DMA_STAT = DMA_ST_RU;
+		lpc_netifdata->rx_dma_unavail++;
+	}
+#endif
+
 	/* If there are no used descriptors, then this call was
 	   not for a received packet, try to setup some descriptors now */
 	if (lpc_netifdata->rx_free_descs == LPC_NUM_BUFF_RXDESCS) {
@@ -251,6 +489,12 @@ static struct pbuf *lpc_low_level_input(struct netif *netif) {
 
 	/* Get receive packet status */
 	status = lpc_netifdata->prdesc[ridx].STATUS;
+#if LPC_PTP_TIMESTAMPS == 1
+	/* Latch the timestamp while the descriptor is still ours, it is
+	   given back to the DMA below */
+	ts_sec = lpc_netifdata->prdesc[ridx].RTSH;
+	ts_nsec = lpc_netifdata->prdesc[ridx].RTSL;
+#endif
 
 	/* Check packet for errors */
 	if (status & RDES_ES) {
@@ -288,7 +532,45 @@ static struct pbuf *lpc_low_level_input(struct netif *netif) {
 		}
 	}
 
+#if LPC_CHECKSUM_OFFLOAD == 1
+	/* lwIP no longer verifies checksums, so drop frames the MAC flagged.
+	   Frames the MAC could not check (IP checksum bypassed) are passed. */
+	if ((!rxerr) && (status & RDES_ESA)) {
+		u32_t extsts = lpc_netifdata->prdesc[ridx].EXTSTAT;
+
+		if (extsts & RDES_ENH_IPHE) {
+			IP_STATS_INC(ip.chkerr);
+			IP_STATS_INC(ip.drop);
+			rxerr = 1;
+		}
+		else if (extsts & RDES_ENH_IPPLE) {
+			switch (RDES_ENH_IPPL(extsts)) {
+			case RDES_ENH_IPPL_UDP:
+				UDP_STATS_INC(udp.chkerr);
+				UDP_STATS_INC(udp.drop);
+				break;
+
+			case RDES_ENH_IPPL_TCP:
+				TCP_STATS_INC(tcp.chkerr);
+				TCP_STATS_INC(tcp.drop);
+				break;
+
+			case RDES_ENH_IPPL_ICMP:
+				ICMP_STATS_INC(icmp.chkerr);
+				ICMP_STATS_INC(icmp.drop);
+				break;
+
+			default:
+				IP_STATS_INC(ip.drop);
+				break;
+			}
+			rxerr = 1;
+		}
+	}
+#endif
+
 	/* Increment free descriptor count and next get index */
+	LPC_RX_PROTECT(lev);
 	lpc_netifdata->rx_free_descs++;
 	ridx++;
 	if (ridx >= LPC_NUM_BUFF_RXDESCS) {
@@ -299,19 +581,30 @@ static struct pbuf *lpc_low_level_input(struct netif *netif) {
 	/* If an error occurred, just re-queue the pbuf */
 	if (rxerr) {
 		lpc_rxqueue_pbuf(lpc_netifdata, p);
+		LPC_RX_UNPROTECT(lev);
 		p = NULL;
+		lpc_netifdata->rx_drops++;
 
 		LWIP_DEBUGF(EMAC_DEBUG | LWIP_DBG_TRACE,
 					("lpc_low_level_input: RX error condition status 0x%08x\n",
 					 status));
 	}
 	else {
+		LPC_RX_UNPROTECT(lev);
+
 		/* Attempt to queue a new pbuf for the descriptor */
 		lpc_rx_queue(netif);
 
 		/* Get length of received packet */
 		p->len = p->tot_len = (u16_t) RDES_FLMSK(status);
 
+#if LPC_PTP_TIMESTAMPS == 1
+		if (status & RDES_TSA) {
+			p->ts.sec = ts_sec;
+			p->ts.nsec = ts_nsec;
+		}
+#endif
+
 		LINK_STATS_INC(link.recv);
 
 		LWIP_DEBUGF(EMAC_DEBUG | LWIP_DBG_TRACE,
@@ -329,6 +622,7 @@ static struct pbuf *lpc_low_level_input(struct netif *netif) {
 #endif
 #endif
 
+	PERF_STOP("lpc_low_level_input");
 	return p;
 }
 
@@ -342,15 +636,20 @@ static err_t lpc_tx_setup(struct lpc_enetdata *lpc_netifdata)
 	lpc_netifdata->tx_free_descs = LPC_NUM_BUFF_TXDESCS;
 	lpc_netifdata->tx_fill_idx = 0;
 	lpc_netifdata->tx_reclaim_idx = 0;
+	lpc_netifdata->tx_frames = 0;
+	lpc_netifdata->tx_stalls = 0;
+	lpc_netifdata->tx_timeouts = 0;
+	lpc_netifdata->tx_errors = 0;
+	lpc_netifdata->tx_bounced = 0;
 
 	/* Link/wrap descriptors */
 	for (idx = 0; idx < LPC_NUM_BUFF_TXDESCS; idx++) {
-		lpc_netifdata->ptdesc[idx].CTRLSTAT = TDES_ENH_TCH | TDES_ENH_CIC(3);
+		lpc_netifdata->ptdesc[idx].CTRLSTAT = TDES_ENH_TCH | LPC_TX_CIC;
 		lpc_netifdata->ptdesc[idx].B2ADD =
 			(u32_t) &lpc_netifdata->ptdesc[idx + 1];
 	}
 	lpc_netifdata->ptdesc[LPC_NUM_BUFF_TXDESCS - 1].CTRLSTAT =
-		TDES_ENH_TCH | TDES_ENH_TER | TDES_ENH_CIC(3);
+		TDES_ENH_TCH | TDES_ENH_TER | LPC_TX_CIC;
 	lpc_netifdata->ptdesc[LPC_NUM_BUFF_TXDESCS - 1].B2ADD =
 		(u32_t) &lpc_netifdata->ptdesc[0];
 
@@ -360,71 +659,100 @@ static err_t lpc_tx_setup(struct lpc_enetdata *lpc_netifdata)
 	return ERR_OK;
 }
 
-/* Low level output of a packet. Never call this from an interrupt context,
-   as it may block until TX descriptors become available */
-static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
+#if LPC_CHECK_SLOWMEM == 1
+/* Returns non-zero if any part of a buffer is in a slow memory region */
+static int lpc_is_slowmem(const void *buff, u32_t len)
 {
-	struct lpc_enetdata *lpc_netifdata = netif->state;
-	u32_t idx, fidx, dn;
-	struct pbuf *p = sendp;
+	u32_t start = (u32_t) buff, end = start + len - 1;
+	u32_t idx;
 
-#if LPC_CHECK_SLOWMEM == 1
-	struct pbuf *q, *wp;
-
-	u8_t *dst;
-	int pcopy = 0;
-
-	/* Check packet address to determine if it's in slow memory and
-	   relocate if necessary */
-	for (q = p; ((q != NULL) && (pcopy == 0)); q = q->next) {
-		fidx = 0;
-		for (idx = 0; idx < sizeof(slmem);
-			 idx += sizeof(struct lpc_slowmem_array_t)) {
-			if ((q->payload >= (void *) slmem[fidx].start) &&
-				(q->payload <= (void *) slmem[fidx].end)) {
-				/* Needs copy */
-				pcopy = 1;
-			}
+	for (idx = 0; idx < (sizeof(slmem) / sizeof(slmem[0])); idx++) {
+		if ((start <= slmem[idx].end) && (end >= slmem[idx].start)) {
+			return 1;
 		}
 	}
 
-	if (pcopy) {
-		/* Create a new pbuf with the total pbuf size */
-		wp = pbuf_alloc(PBUF_RAW, (u16_t) EMAC_ETH_MAX_FLEN, PBUF_RAM);
-		if (!wp) {
-			/* Exit with error */
-			return ERR_MEM;
+	return 0;
+}
+#endif
+
+/* Reserve dn TX descriptors for a packet. With an RTOS, the caller blocks
+   on the counting semaphore given by the TX cleanup task for every reclaimed
+   descriptor. Without an RTOS, completed descriptors are reclaimed here. */
+static err_t lpc_tx_wait_descs(struct lpc_enetdata *lpc_netifdata, u32_t dn)
+{
+#if NO_SYS == 0
+	u32_t taken;
+	int stalled = 0;
+
+	if (dn > LPC_NUM_BUFF_TXDESCS) {
+		return ERR_MEM;
+	}
+
+	for (taken = 0; taken < dn; taken++) {
+		if (xSemaphoreTake(lpc_netifdata->xTXDCountSem, 0) == pdTRUE) {
+			continue;
 		}
 
-		/* Copy pbuf */
-		dst = (u8_t *) wp->payload;
-		wp->tot_len = 0;
-		for (q = p; q != NULL; q = q->next) {
-			MEMCPY(dst, (u8_t *) q->payload, q->len);
-			dst += q->len;
-			wp->tot_len += q->len;
+		stalled = 1;
+		if (xSemaphoreTake(lpc_netifdata->xTXDCountSem,
+						   LPC_TX_DESC_TIMEOUT / portTICK_PERIOD_MS) != pdTRUE) {
+			/* Return the descriptors reserved so far */
+			while (taken--) {
+				xSemaphoreGive(lpc_netifdata->xTXDCountSem);
+			}
+			lpc_netifdata->tx_stalls++;
+			lpc_netifdata->tx_timeouts++;
+			return ERR_MEM;
 		}
-		wp->len = wp->tot_len;
+	}
+
+	if (stalled) {
+		lpc_netifdata->tx_stalls++;
+	}
+#else
+	u32_t start = sys_now();
 
-		/* LWIP will free original pbuf on exit of function */
+	if (dn > LPC_NUM_BUFF_TXDESCS) {
+		return ERR_MEM;
+	}
+
+	if (dn > lpc_netifdata->tx_free_descs) {
+		lpc_netifdata->tx_stalls++;
+	}
 
-		p = sendp = wp;
+	while (dn > lpc_netifdata->tx_free_descs) {
+		lpc_tx_reclaim(lpc_netifdata->netif);
+		if ((sys_now() - start) >= LPC_TX_DESC_TIMEOUT) {
+			lpc_netifdata->tx_timeouts++;
+			return ERR_MEM;
+		}
 	}
 #endif
 
+	return ERR_OK;
+}
+
+/* Low level output of a packet. Never call this from an interrupt context,
+   as it may block until TX descriptors become available */
+static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
+{
+	struct lpc_enetdata *lpc_netifdata = netif->state;
+	u32_t idx, fidx, dn;
+	struct pbuf *p = sendp;
+	PERF_START;
+
 	/* Zero-copy TX buffers may be fragmented across mutliple payload
 	   chains. Determine the number of descriptors needed for the
 	   transfer. The pbuf chaining can be a mess! */
 	dn = (u32_t) pbuf_clen(p);
 
-	/* Wait until enough descriptors are available for the transfer. */
-	/* THIS WILL BLOCK UNTIL THERE ARE ENOUGH DESCRIPTORS AVAILABLE */
-	while (dn > lpc_tx_ready(netif))
-#if NO_SYS == 0
-	{xSemaphoreTake(lpc_netifdata->xTXDCountSem, 0); }
-#else
-	{msDelay(1); }
-#endif
+	/* Wait until enough descriptors are available for the transfer */
+	if (lpc_tx_wait_descs(lpc_netifdata, dn) != ERR_OK) {
+		LINK_STATS_INC(link.memerr);
+		LINK_STATS_INC(link.drop);
+		return ERR_MEM;
+	}
 
 	/* Get the next free descriptor index */
 	fidx = idx = lpc_netifdata->tx_fill_idx;
@@ -439,6 +767,16 @@ static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
 		dn--;
 
 		/* Setup packet address and length */
+#if LPC_CHECK_SLOWMEM == 1
+		/* The DMA cannot fetch from slow memory, so send segments located
+		   there from this descriptor's bounce buffer */
+		if (lpc_is_slowmem(p->payload, p->len)) {
+			MEMCPY(lpc_tx_bounce[idx], p->payload, p->len);
+			lpc_netifdata->ptdesc[idx].B1ADD = (u32_t) lpc_tx_bounce[idx];
+			lpc_netifdata->tx_bounced++;
+		}
+		else
+#endif
 		lpc_netifdata->ptdesc[idx].B1ADD = (u32_t) p->payload;
 		lpc_netifdata->ptdesc[idx].BSIZE = (u32_t) TDES_ENH_BS1(p->len);
 
@@ -449,18 +787,11 @@ static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
 		/* For first packet only, first flag */
 		lpc_netifdata->tx_free_descs--;
 		if (idx == fidx) {
-			lpc_netifdata->ptdesc[idx].CTRLSTAT |= TDES_ENH_FS;
-#if LPC_CHECK_SLOWMEM == 1
-			/* If this is a copied pbuf, then avoid getting the extra reference
-			   or the TX reclaim will be off by 1 */
-			if (!pcopy) {
-				pbuf_ref(p);
-			}
-#else
+			lpc_netifdata->ptdesc[idx].CTRLSTAT |= TDES_ENH_FS | LPC_TX_TTSE;
+
 			/* Increment reference count on this packet so LWIP doesn't
 			   attempt to free it on return from this call */
 			pbuf_ref(p);
-#endif
 		}
 		else {
 			lpc_netifdata->ptdesc[idx].CTRLSTAT |= TDES_OWN;
@@ -482,8 +813,8 @@ static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
 												   TDES_ENH_IC;
 		}
 
-		/* IP checksumming requires full buffering in IP */
-		lpc_netifdata->ptdesc[idx].CTRLSTAT |= TDES_ENH_CIC(3);
+		/* Checksum insertion, requires TX store and forward mode */
+		lpc_netifdata->ptdesc[idx].CTRLSTAT |= LPC_TX_CIC;
 
 		LWIP_DEBUGF(EMAC_DEBUG | LWIP_DBG_TRACE,
 					("lpc_low_level_output: pbuf packet %p sent, chain %d,"
@@ -501,6 +832,7 @@ static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
 	}
 
 	lpc_netifdata->tx_fill_idx = idx;
+	lpc_netifdata->tx_frames++;
 
 	LINK_STATS_INC(link.xmit);
 
@@ -515,6 +847,7 @@ static err_t lpc_low_level_output(struct netif *netif, struct pbuf *sendp)
 	sys_mutex_unlock(&lpc_netifdata->TXLockMutex);
 #endif
 
+	PERF_STOP("lpc_low_level_output");
 	return ERR_OK;
 }
 
@@ -532,20 +865,83 @@ static err_t lpc_etharp_output(struct netif *netif, struct pbuf *q,
 }
 
 #if NO_SYS == 0
+/* Returns non-zero if the next RX descriptor holds a received frame. A
+   descriptor without a buffer is not owned by the DMA either, so an empty
+   ring is checked first. */
+static int lpc_rx_pending(struct lpc_enetdata *lpc_netifdata)
+{
+	return (lpc_netifdata->rx_free_descs < LPC_NUM_BUFF_RXDESCS) &&
+		   !(lpc_netifdata->prdesc[lpc_netifdata->rx_get_idx].STATUS & RDES_OWN);
+}
+
 /* Packet reception task
    This task is called when a packet is received. It will
    pass the packet to the LWIP core */
 static void vPacketReceiveTask(void *pvParameters) {
 	struct lpc_enetdata *lpc_netifdata = pvParameters;
+	u32_t batch;
+#if LPC_RX_POLL_BUDGET > 0
+	u32_t frames;
+	SYS_ARCH_DECL_PROTECT(lev);
+#endif
 
 	while (1) {
 		/* Wait for receive task to wakeup */
 		sys_arch_sem_wait(&lpc_netifdata->RxSem, 0);
 
+		/* Refill descriptors left without a buffer by an earlier
+		   allocation failure */
+		lpc_rx_queue(lpc_netifdata->netif);
+
+		batch = 0;
+#if LPC_RX_POLL_BUDGET > 0
+		/* RX interrupts were masked by the interrupt handler, poll the
+		   ring until it is empty */
+		while (1) {
+			frames = 0;
+			while ((frames < LPC_RX_POLL_BUDGET) && lpc_rx_pending(lpc_netifdata)) {
+				lpc_enetif_input(lpc_netifdata->netif);
+				frames++;
+			}
+			batch += frames;
+
+			if (frames == LPC_RX_POLL_BUDGET) {
+				/* Budget used up with frames possibly still pending, give
+				   other tasks a chance before polling again */
+				lpc_netifdata->rx_budget_hits++;
+#if LPC_RX_POLL_DELAY > 0
+				vTaskDelay(LPC_RX_POLL_DELAY);
+#else
+				taskYIELD();
+#endif
+				continue;
+			}
+
+			/* Ring is empty, unmask RX interrupts. A frame may have arrived
+			   after the last check with its interrupt status already cleared,
+			   so check once more and keep polling if so. */
+			SYS_ARCH_PROTECT(lev);
+			LPC_ETHERNET->DMA_INT_EN |= LPC_RX_INTS;
+			SYS_ARCH_UNPROTECT(lev);
+			if (!lpc_rx_pending(lpc_netifdata)) {
+				break;
+			}
+
+			SYS_ARCH_PROTECT(lev);
+			LPC_ETHERNET->DMA_INT_EN &= ~LPC_RX_INTS;
+			SYS_ARCH_UNPROTECT(lev);
+		}
+#else
 		/* Process receive packets */
-		while (!(lpc_netifdata->prdesc[lpc_netifdata->rx_get_idx].STATUS
-				 & RDES_OWN)) {
+		while (lpc_rx_pending(lpc_netifdata)) {
 			lpc_enetif_input(lpc_netifdata->netif);
+			batch++;
+		}
+#endif
+
+		lpc_netifdata->rx_frames += batch;
+		if (batch > lpc_netifdata->rx_max_batch) {
+			lpc_netifdata->rx_max_batch = batch;
 		}
 	}
 }
@@ -578,7 +974,18 @@ static err_t low_level_init(struct netif *netif)
 	/* Save MAC address */
 	Chip_ENET_SetADDR(LPC_ETHERNET, netif->hwaddr);
 
-	/* Initial MAC configuration for checksum offload, full duplex,
+#if LPC_PTP_TIMESTAMPS == 1
+	{
+		static const ENET_TIME_T zero = {0, 0};
+
+		/* Start the system time at 0, timestamps are relative to init
+		   until set with lpc_emac_ptp_set_time() */
+		lpc_netifdata->ptp_addend = Chip_ENET_TSInit(LPC_ETHERNET,
+									Chip_Clock_GetRate(CLK_MX_ETHERNET), &zero);
+	}
+#endif
+
+	/* Initial MAC configuration for RX checksum checking, full duplex,
 	   100Mbps, disable receive own in half duplex, inter-frame gap
 	   of 64-bits */
 	LPC_ETHERNET->MAC_CONFIG = MAC_CFG_BL(0) | MAC_CFG_IPC | MAC_CFG_DM |
@@ -619,9 +1026,15 @@ static err_t low_level_init(struct netif *netif)
 	/* Flush transmit FIFO */
 	LPC_ETHERNET->DMA_OP_MODE = DMA_OM_FTF;
 
+#if LPC_CHECKSUM_OFFLOAD == 1
+	/* Setup DMA to flush receive FIFOs at 32 bytes. The TX FIFO has to
+	   hold the whole frame so the MAC can insert the checksums. */
+	LPC_ETHERNET->DMA_OP_MODE |= DMA_OM_RTC(1) | DMA_OM_TSF;
+#else
 	/* Setup DMA to flush receive FIFOs at 32 bytes, service TX FIFOs at
 	   64 bytes */
 	LPC_ETHERNET->DMA_OP_MODE |= DMA_OM_RTC(1) | DMA_OM_TTC(0);
+#endif
 
 	/* Clear all MAC interrupts */
 	LPC_ETHERNET->DMA_STAT = DMA_ST_ALL;
@@ -631,8 +1044,8 @@ static err_t low_level_init(struct netif *netif)
 #if NO_SYS == 1
 		0;
 #else
-		DMA_IE_TIE | DMA_IE_OVE | DMA_IE_UNE | DMA_IE_RIE | DMA_IE_NIE |
-		DMA_IE_AIE | DMA_IE_TUE | DMA_IE_RUE;
+		DMA_IE_TIE | DMA_IE_UNE | DMA_IE_NIE | DMA_IE_AIE | DMA_IE_TUE |
+		LPC_RX_INTS;
 #endif
 
 	/* Enable receive and transmit DMA processes */
@@ -658,6 +1071,26 @@ s32_t lpc_rx_queue(struct netif *netif)
 
 	s32_t queued = 0;
 
+#if LPC_RX_PBUF_POOL == 1
+	LPC_RX_DECL_PROTECT(lev);
+
+	/* Refill from the RX pool, no heap allocation on this path */
+	LPC_RX_PROTECT(lev);
+	while (lpc_netifdata->rx_free_descs > 0) {
+		p = lpc_rxpool_get(lpc_netifdata);
+		if (p == NULL) {
+			/* The next freed pool pbuf refills the ring */
+			lpc_netifdata->rx_refill_fail++;
+			break;
+		}
+
+		lpc_rxqueue_pbuf(lpc_netifdata, p);
+		queued++;
+	}
+	LPC_RX_UNPROTECT(lev);
+
+	return queued;
+#else
 	/* Attempt to requeue as many packets as possible */
 	while (lpc_netifdata->rx_free_descs > 0) {
 		/* Allocate a pbuf from the pool. We need to allocate at the
@@ -669,6 +1102,7 @@ s32_t lpc_rx_queue(struct netif *netif)
 						("lpc_rx_queue: could not allocate RX pbuf index %d, "
 						 "free %d)\n", lpc_netifdata->rx_next_idx,
 						 lpc_netifdata->rx_free_descs));
+			lpc_netifdata->rx_refill_fail++;
 			return queued;
 		}
 
@@ -685,6 +1119,7 @@ s32_t lpc_rx_queue(struct netif *netif)
 	}
 
 	return queued;
+#endif
 }
 
 /* Attempt to read a packet from the EMAC interface */
@@ -732,6 +1167,7 @@ void lpc_tx_reclaim(struct netif *netif)
 	struct lpc_enetdata *lpc_netifdata = netif->state;
 	s32_t ridx;
 	u32_t status;
+	PERF_START;
 
 #if NO_SYS == 0
 	/* Get exclusive access */
@@ -756,6 +1192,7 @@ void lpc_tx_reclaim(struct netif *netif)
 			LWIP_DEBUGF(EMAC_DEBUG | LWIP_DBG_TRACE,
 						("lpc_tx_reclaim: TX error condition status 0x%x\n", status));
 			LINK_STATS_INC(link.err);
+			lpc_netifdata->tx_errors++;
 
 #if LINK_STATS == 1
 			/* Error conditions that cause a packet drop */
@@ -776,6 +1213,19 @@ void lpc_tx_reclaim(struct netif *netif)
 
 		/* Free the pbuf associate with this descriptor */
 		if (lpc_netifdata->txpbufs[ridx]) {
+#if LPC_PTP_TIMESTAMPS == 1
+			/* The timestamp is reported in the last descriptor of
+			   the frame, which is the one holding the pbuf */
+			if (status & TDES_TTSS) {
+				struct pbuf *p = lpc_netifdata->txpbufs[ridx];
+
+				p->ts.sec = lpc_netifdata->ptdesc[ridx].TTSH;
+				p->ts.nsec = lpc_netifdata->ptdesc[ridx].TTSL;
+				if (lpc_netifdata->tx_ts_cb) {
+					lpc_netifdata->tx_ts_cb(p, &p->ts);
+				}
+			}
+#endif
 			pbuf_free(lpc_netifdata->txpbufs[ridx]);
 		}
 
@@ -796,6 +1246,8 @@ void lpc_tx_reclaim(struct netif *netif)
 	/* Restore access */
 	sys_mutex_unlock(&lpc_netifdata->TXLockMutex);
 #endif
+
+	PERF_STOP("lpc_tx_reclaim");
 }
 
 /* Polls if an available TX descriptor is ready */
@@ -822,8 +1274,21 @@ void ETH_IRQHandler(void)
 	/* Get pending interrupts */
 	ints = LPC_ETHERNET->DMA_STAT;
 
-	/* RX group interrupt(s) */
-	if (ints & (DMA_ST_RI | DMA_ST_OVF | DMA_ST_RU)) {
+	/* A frame arrived while the RX ring was empty */
+	if (ints & DMA_ST_RU) {
+		lpc_enetdata.rx_dma_unavail++;
+	}
+
+	/* RX group interrupt(s), status bits of masked RX interrupts are
+	   ignored while the receive task is polling */
+	if ((ints & (DMA_ST_RI | DMA_ST_OVF | DMA_ST_RU)) &&
+		(LPC_ETHERNET->DMA_INT_EN & DMA_IE_RIE)) {
+#if LPC_RX_POLL_BUDGET > 0
+		/* Mask RX interrupts until the receive task has emptied the ring */
+		LPC_ETHERNET->DMA_INT_EN &= ~LPC_RX_INTS;
+#endif
+		lpc_enetdata.rx_irqs++;
+
 		/* Give semaphore to wakeup RX receive task. Note the FreeRTOS
 		   method is used instead of the LWIP arch method. */
 		xSemaphoreGiveFromISR(lpc_enetdata.RxSem, &xRecTaskWoken);
@@ -844,6 +1309,110 @@ void ETH_IRQHandler(void)
 #endif
 }
 
+/* Returns receive path and RX pool statistics */
+void lpc_emac_get_rx_stats(struct lpc_emac_rx_stats *stats)
+{
+	LPC_RX_DECL_PROTECT(lev);
+
+	LPC_RX_PROTECT(lev);
+#if LPC_RX_PBUF_POOL == 1
+	stats->pool_size = LPC_NUM_RX_POOL_PBUFS;
+	stats->pool_free = lpc_enetdata.rx_pool_nfree;
+	stats->pool_min_free = lpc_enetdata.rx_pool_min;
+#else
+	stats->pool_size = 0;
+	stats->pool_free = 0;
+	stats->pool_min_free = 0;
+#endif
+	stats->ring_free = lpc_enetdata.rx_free_descs;
+	stats->refill_fail = lpc_enetdata.rx_refill_fail;
+	stats->dma_unavail = lpc_enetdata.rx_dma_unavail;
+	stats->irqs = lpc_enetdata.rx_irqs;
+	stats->frames = lpc_enetdata.rx_frames;
+	stats->max_batch = lpc_enetdata.rx_max_batch;
+	stats->budget_hits = lpc_enetdata.rx_budget_hits;
+	stats->drops = lpc_enetdata.rx_drops;
+	LPC_RX_UNPROTECT(lev);
+}
+
+/* Returns transmit path statistics */
+void lpc_emac_get_tx_stats(struct lpc_emac_tx_stats *stats)
+{
+	stats->frames = lpc_enetdata.tx_frames;
+	stats->stalls = lpc_enetdata.tx_stalls;
+	stats->timeouts = lpc_enetdata.tx_timeouts;
+	stats->errors = lpc_enetdata.tx_errors;
+	stats->bounced = lpc_enetdata.tx_bounced;
+	stats->ring_free = lpc_enetdata.tx_free_descs;
+}
+
+#if LPC_PTP_TIMESTAMPS == 1
+/* Registers the TX timestamp callback */
+void lpc_emac_set_tx_ts_callback(lpc_emac_tx_ts_fn cb)
+{
+	lpc_enetdata.tx_ts_cb = cb;
+}
+
+/* Reads the hardware clock */
+void lpc_emac_ptp_get_time(struct pbuf_ts *ts)
+{
+	ENET_TIME_T t;
+
+	Chip_ENET_TSGetTime(LPC_ETHERNET, &t);
+	ts->sec = t.seconds;
+	ts->nsec = t.nanoseconds;
+}
+
+/* Sets the hardware clock */
+void lpc_emac_ptp_set_time(const struct pbuf_ts *ts)
+{
+	ENET_TIME_T t;
+
+	t.seconds = ts->sec;
+	t.nanoseconds = ts->nsec;
+	Chip_ENET_TSSetTime(LPC_ETHERNET, &t);
+}
+
+/* Moves the hardware clock by a signed offset */
+void lpc_emac_ptp_step(s32_t offset_ns)
+{
+	ENET_TIME_T t;
+	u32_t mag;
+
+	mag = (offset_ns < 0) ? (u32_t) -offset_ns : (u32_t) offset_ns;
+	t.seconds = mag / ENET_TS_NSEC_PER_SEC;
+	t.nanoseconds = mag % ENET_TS_NSEC_PER_SEC;
+	Chip_ENET_TSUpdateTime(LPC_ETHERNET, &t, offset_ns < 0);
+}
+
+/* Trims the hardware clock rate */
+void lpc_emac_ptp_adj_freq(s32_t ppb)
+{
+	long long diff;
+
+	/* The system time advances by addend / 2^32 of the subsecond
+	   increment per clock, so the rate scales linearly with it */
+	diff = ((long long) lpc_enetdata.ptp_addend * ppb) / 1000000000LL;
+	Chip_ENET_TSSetAddend(LPC_ETHERNET, (u32_t) (lpc_enetdata.ptp_addend + diff));
+}
+
+/* Clock offset and path delay from a timestamp exchange */
+void lpc_emac_ptp_offset(const struct pbuf_ts *t1, const struct pbuf_ts *t2,
+						 const struct pbuf_ts *t3, const struct pbuf_ts *t4,
+						 s32_t *offset_ns, s32_t *delay_ns)
+{
+	long long ms, sm;
+
+	/* master to slave and slave to master differences */
+	ms = ((long long) t2->sec - t1->sec) * 1000000000LL + ((long long) t2->nsec - t1->nsec);
+	sm = ((long long) t4->sec - t3->sec) * 1000000000LL + ((long long) t4->nsec - t3->nsec);
+
+	*offset_ns = (s32_t) ((ms - sm) / 2);
+	*delay_ns = (s32_t) ((ms + sm) / 2);
+}
+
+#endif /* LPC_PTP_TIMESTAMPS == 1 */
+
 /* Set up the MAC interface duplex */
 void lpc_emac_set_duplex(int full_duplex)
 {
@@ -876,6 +1445,11 @@ err_t lpc_enetif_init(struct netif *netif)
 
 	lpc_enetdata.netif = netif;
 
+#if LWIP_PERF
+	/* Start the cycle counter used by the PERF_START/PERF_STOP probes */
+	lpc_perf_init();
+#endif
+
 	/* set MAC hardware address */
 	Board_ENET_GetMacADDR(netif->hwaddr);
 	netif->hwaddr_len = ETHARP_HWADDR_LEN;
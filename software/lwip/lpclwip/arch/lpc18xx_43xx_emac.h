@@ -53,6 +53,35 @@ extern "C"
  * @{
  */
 
+/**
+ * @brief	EMAC receive path statistics
+ */
+struct lpc_emac_rx_stats {
+	u32_t pool_size;		/**< RX pool pbufs, 0 when RX pbufs come from the lwIP heap */
+	u32_t pool_free;		/**< RX pool pbufs held by neither the ring nor the stack */
+	u32_t pool_min_free;	/**< Lowest pool_free value since init */
+	u32_t ring_free;		/**< RX descriptors currently without a buffer */
+	u32_t refill_fail;		/**< Descriptor refills that found no buffer */
+	u32_t dma_unavail;		/**< Times the DMA found the RX ring empty */
+	u32_t irqs;				/**< RX interrupts that woke the receive task (RTOS only) */
+	u32_t frames;			/**< Frames handled by the receive task (RTOS only) */
+	u32_t max_batch;		/**< Most frames handled for a single RX interrupt */
+	u32_t budget_hits;		/**< Times the receive task used up LPC_RX_POLL_BUDGET */
+	u32_t drops;			/**< Frames dropped for receive or checksum errors */
+};
+
+/**
+ * @brief	EMAC transmit path statistics
+ */
+struct lpc_emac_tx_stats {
+	u32_t frames;			/**< Frames queued for transmit */
+	u32_t stalls;			/**< Frames that had to wait for free TX descriptors */
+	u32_t timeouts;			/**< Frames dropped after waiting LPC_TX_DESC_TIMEOUT */
+	u32_t errors;			/**< Frames completed with a TX error status */
+	u32_t bounced;			/**< Segments copied to a slow memory bounce buffer */
+	u32_t ring_free;		/**< TX descriptors currently free */
+};
+
 /**
  * @brief	Attempt to read a packet from the EMAC interface
  * @param	netif	: lwip network interface structure pointer
@@ -92,6 +121,94 @@ void lpc_tx_reclaim(struct netif *netif);
  */
 err_t lpc_enetif_init(struct netif *netif);
 
+/**
+ * @brief	Get receive path statistics
+ * @param	stats	: Pointer to structure to fill
+ * @return	Nothing
+ * @note	refill_fail and dma_unavail count RX ring starvation. With
+ * LPC_RX_PBUF_POOL enabled, a low pool_min_free means packets are held by
+ * the stack long enough to starve the ring and LPC_NUM_RX_POOL_PBUFS should
+ * be raised. frames / irqs gives the average number of frames handled per
+ * RX interrupt, which LPC_RX_POLL_BUDGET raises under load.
+ */
+void lpc_emac_get_rx_stats(struct lpc_emac_rx_stats *stats);
+
+/**
+ * @brief	Get transmit path statistics
+ * @param	stats	: Pointer to structure to fill
+ * @return	Nothing
+ * @note	stalls counts TX descriptor starvation, timeouts the frames it
+ * caused to be dropped.
+ */
+void lpc_emac_get_tx_stats(struct lpc_emac_tx_stats *stats);
+
+/* IEEE 1588 timestamp support, implemented when the driver is built with
+   LPC_PTP_TIMESTAMPS enabled */
+#if LWIP_PBUF_TIMESTAMP
+/**
+ * @brief	TX timestamp callback type
+ * @param	p	: Transmitted packet, freed after the callback returns
+ * @param	ts	: System time at which the frame left the MAC
+ * @return	Nothing
+ * @note	Called from the TX cleanup task (or lpc_tx_reclaim() without an
+ * RTOS) with the TX lock held, so it must not transmit.
+ */
+typedef void (*lpc_emac_tx_ts_fn)(struct pbuf *p, const struct pbuf_ts *ts);
+
+/**
+ * @brief	Registers a function called with the timestamp of each sent frame
+ * @param	cb	: Callback function, or NULL to disable
+ * @return	Nothing
+ */
+void lpc_emac_set_tx_ts_callback(lpc_emac_tx_ts_fn cb);
+
+/**
+ * @brief	Reads the IEEE 1588 hardware clock
+ * @param	ts	: Pointer to time to fill
+ * @return	Nothing
+ */
+void lpc_emac_ptp_get_time(struct pbuf_ts *ts);
+
+/**
+ * @brief	Sets the IEEE 1588 hardware clock
+ * @param	ts	: New time
+ * @return	Nothing
+ */
+void lpc_emac_ptp_set_time(const struct pbuf_ts *ts);
+
+/**
+ * @brief	Steps the IEEE 1588 hardware clock
+ * @param	offset_ns	: Nanoseconds to add, negative to move back
+ * @return	Nothing
+ */
+void lpc_emac_ptp_step(s32_t offset_ns);
+
+/**
+ * @brief	Trims the IEEE 1588 hardware clock rate
+ * @param	ppb	: Rate correction in parts per billion relative to nominal
+ * @return	Nothing
+ */
+void lpc_emac_ptp_adj_freq(s32_t ppb);
+
+/**
+ * @brief	Computes clock offset and path delay from a timestamp exchange
+ * @param	t1			: Time the master sent Sync, in master time
+ * @param	t2			: Time this node received Sync, in local time
+ * @param	t3			: Time this node sent Delay_Req, in local time
+ * @param	t4			: Time the master received Delay_Req, in master time
+ * @param	offset_ns	: Returns local time minus master time
+ * @param	delay_ns	: Returns the mean one way path delay
+ * @return	Nothing
+ * @note	t2 and t3 are the pbuf->ts values of the received and sent
+ * frames. Correct the clock with lpc_emac_ptp_step(-offset_ns) and
+ * lpc_emac_ptp_adj_freq(). Assumes a symmetric path.
+ */
+void lpc_emac_ptp_offset(const struct pbuf_ts *t1, const struct pbuf_ts *t2,
+						 const struct pbuf_ts *t3, const struct pbuf_ts *t4,
+						 s32_t *offset_ns, s32_t *delay_ns);
+
+#endif /* LWIP_PBUF_TIMESTAMP */
+
 /**
  * @brief	Set up the MAC interface duplex
  * @param	full_duplex	: 0 = half duplex, 1 = full duplex
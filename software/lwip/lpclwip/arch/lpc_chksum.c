@@ -0,0 +1,202 @@
+/*
+ * @brief LWIP word-at-a-time checksum and copy-checksum
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+
+#include <string.h>
+
+#if LPC_FAST_CHKSUM
+
+/** @ingroup NET_LWIP_ARCH
+ * @{
+ */
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* The data is summed as native 32-bit words read from aligned addresses.
+   Bytes at odd addresses land in the upper byte of a 16-bit lane, so the
+   folded sum is byte swapped when the buffer starts at an odd address
+   (RFC1071 byte order independence). Carries out of bit 31 are added back
+   (end-around carry), which keeps a 32-bit accumulator exact. */
+
+#if defined(__GNUC__) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+/* Cortex-M3/M4: one ADCS per word, the carry flag chains the 4 words */
+#define LPC_CSUM_ADD4(acc, w0, w1, w2, w3) \
+	__asm ("adds %0, %0, %1\n\t" \
+		   "adcs %0, %0, %2\n\t" \
+		   "adcs %0, %0, %3\n\t" \
+		   "adcs %0, %0, %4\n\t" \
+		   "adc  %0, %0, #0" \
+		   : "+r" (acc) : "r" (w0), "r" (w1), "r" (w2), "r" (w3) : "cc")
+#else
+#define LPC_CSUM_ADD4(acc, w0, w1, w2, w3) \
+	do { \
+		acc = lpc_csum_add(acc, w0); \
+		acc = lpc_csum_add(acc, w1); \
+		acc = lpc_csum_add(acc, w2); \
+		acc = lpc_csum_add(acc, w3); \
+	} while (0)
+#endif
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* One's complement 32-bit add */
+static u32_t lpc_csum_add(u32_t acc, u32_t w)
+{
+	acc += w;
+	return acc + (acc < w);
+}
+
+/* Adds a byte at the given address to the sum */
+static u32_t lpc_csum_byte(u32_t acc, const u8_t *pb)
+{
+	return lpc_csum_add(acc, (u32_t) *pb << (((mem_ptr_t) pb & 1) * 8));
+}
+
+/* Folds the 32-bit sum to 16 bits, swapped back for odd start addresses */
+static u16_t lpc_csum_fold(u32_t acc, int odd)
+{
+	acc = (acc >> 16) + (acc & 0xFFFF);
+	acc = (acc >> 16) + (acc & 0xFFFF);
+	if (odd) {
+		acc = ((acc & 0xFF) << 8) | (acc >> 8);
+	}
+
+	return (u16_t) acc;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Internet checksum of a buffer (LWIP_CHKSUM) */
+u16_t lpc_chksum(void *dataptr, int len)
+{
+	const u8_t *pb = (const u8_t *) dataptr;
+	const u32_t *pw;
+	int odd = (int) ((mem_ptr_t) pb & 1);
+	u32_t acc = 0;
+
+	/* Leading bytes up to a word boundary */
+	while ((len > 0) && (((mem_ptr_t) pb & 3) != 0)) {
+		acc = lpc_csum_byte(acc, pb++);
+		len--;
+	}
+
+	pw = (const u32_t *) pb;
+	while (len >= 16) {
+		LPC_CSUM_ADD4(acc, pw[0], pw[1], pw[2], pw[3]);
+		pw += 4;
+		len -= 16;
+	}
+	while (len >= 4) {
+		acc = lpc_csum_add(acc, *pw++);
+		len -= 4;
+	}
+
+	/* Trailing bytes */
+	pb = (const u8_t *) pw;
+	while (len > 0) {
+		acc = lpc_csum_byte(acc, pb++);
+		len--;
+	}
+
+	return lpc_csum_fold(acc, odd);
+}
+
+/* Copies a buffer and returns the checksum of the copied data in a single
+   pass over the source (LWIP_CHKSUM_COPY) */
+u16_t lpc_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	const u8_t *pb = (const u8_t *) src;
+	u8_t *pd = (u8_t *) dst;
+	const u32_t *pw;
+	int odd = (int) ((mem_ptr_t) pb & 1);
+	int rem = len;
+	u32_t acc = 0, w0, w1, w2, w3;
+
+	/* Align the source, the destination may stay unaligned */
+	while ((rem > 0) && (((mem_ptr_t) pb & 3) != 0)) {
+		acc = lpc_csum_byte(acc, pb);
+		*pd++ = *pb++;
+		rem--;
+	}
+
+	/* Word loads from the source. The stores go through memcpy() so the
+	   compiler emits plain (possibly unaligned) word stores, which the
+	   Cortex-M3/M4 handles for normal memory. */
+	pw = (const u32_t *) pb;
+	while (rem >= 16) {
+		w0 = pw[0];
+		w1 = pw[1];
+		w2 = pw[2];
+		w3 = pw[3];
+		memcpy(pd, &w0, 4);
+		memcpy(pd + 4, &w1, 4);
+		memcpy(pd + 8, &w2, 4);
+		memcpy(pd + 12, &w3, 4);
+		LPC_CSUM_ADD4(acc, w0, w1, w2, w3);
+		pw += 4;
+		pd += 16;
+		rem -= 16;
+	}
+	while (rem >= 4) {
+		w0 = *pw++;
+		memcpy(pd, &w0, 4);
+		acc = lpc_csum_add(acc, w0);
+		pd += 4;
+		rem -= 4;
+	}
+
+	pb = (const u8_t *) pw;
+	while (rem > 0) {
+		acc = lpc_csum_byte(acc, pb);
+		*pd++ = *pb++;
+		rem--;
+	}
+
+	return lpc_csum_fold(acc, odd);
+}
+
+/**
+ * @}
+ */
+
+#endif /* LPC_FAST_CHKSUM */
@@ -30,6 +30,15 @@
  */
 
 #include "lwip/opt.h"
+#include "arch/perf.h"
+
+#if LWIP_PERF
+#include "board.h"
+
+#if defined(CORE_M0)
+#error LWIP_PERF requires the DWT cycle counter of the Cortex-M3/M4
+#endif
+#endif
 
 /** @defgroup NET_LWIP_DEBUG LWIP debug re-direction
  * @ingroup NET_LWIP
@@ -73,6 +82,87 @@ void assert_loop(void)
 
  #endif /* LWIP_DEBUG */
 
+#if LWIP_PERF
+/* List of probes that have recorded at least one sample */
+static struct lpc_perf_probe *perf_probes;
+
+/* Enables the DWT cycle counter */
+void lpc_perf_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* Adds a sample to a probe */
+void lpc_perf_record(struct lpc_perf_probe *probe, u32_t cycles)
+{
+	u32_t primask = __get_PRIMASK();
+
+	/* Probes such as pbuf_free are hit from several tasks and interrupts */
+	__disable_irq();
+
+	if (!probe->linked) {
+		probe->linked = 1;
+		probe->next = perf_probes;
+		perf_probes = probe;
+	}
+
+	if ((probe->count == 0) || (cycles < probe->min)) {
+		probe->min = cycles;
+	}
+	if (cycles > probe->max) {
+		probe->max = cycles;
+	}
+	probe->count++;
+	probe->sum += cycles;
+
+	__set_PRIMASK(primask);
+}
+
+/* Clears the accumulators of all registered probes */
+void lpc_perf_reset(void)
+{
+	struct lpc_perf_probe *probe;
+	u32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	for (probe = perf_probes; probe != NULL; probe = probe->next) {
+		probe->count = 0;
+		probe->max = 0;
+		probe->sum = 0;
+	}
+	__set_PRIMASK(primask);
+}
+
+/* Prints count, min, max and mean cycles of all probes */
+void lpc_perf_dump(void)
+{
+	struct lpc_perf_probe *probe, snap;
+	u32_t primask;
+
+	DEBUGOUT("%-24s %10s %10s %10s %10s (cycles @ %lu Hz)\r\n", "probe", "count",
+			 "min", "max", "mean", (unsigned long) SystemCoreClock);
+
+	for (probe = perf_probes; probe != NULL; probe = probe->next) {
+		/* Copy the probe so the line is consistent */
+		primask = __get_PRIMASK();
+		__disable_irq();
+		snap = *probe;
+		__set_PRIMASK(primask);
+
+		if (snap.count == 0) {
+			continue;
+		}
+
+		DEBUGOUT("%-24s %10lu %10lu %10lu %10lu\r\n", snap.name,
+				 (unsigned long) snap.count, (unsigned long) snap.min,
+				 (unsigned long) snap.max, (unsigned long) (snap.sum / snap.count));
+	}
+}
+
+#endif /* LWIP_PERF */
+
 /**
  * @}
  */
@@ -32,7 +32,92 @@
 #ifndef __PERF_H__
 #define __PERF_H__
 
+#include "lwip/opt.h"
+
+/* Set to 1 (normally in lwipopts.h) to time the lwIP PERF_START/PERF_STOP
+   blocks and the EMAC driver with the Cortex-M3/M4 DWT cycle counter */
+#ifndef LWIP_PERF
+#define LWIP_PERF 0
+#endif
+
+#if LWIP_PERF
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @ingroup NET_LWIP_DEBUG
+ * @{
+ */
+
+/**
+ * @brief Cycle accumulator for one PERF_STOP() call site
+ */
+struct lpc_perf_probe {
+	const char *name;				/**< Probe name given to PERF_STOP() */
+	struct lpc_perf_probe *next;	/**< Next registered probe */
+	u32_t linked;					/**< Non-zero once on the probe list */
+	u32_t count;					/**< Number of samples */
+	u32_t min;						/**< Fewest cycles of a sample */
+	u32_t max;						/**< Most cycles of a sample */
+	unsigned long long sum;			/**< Total cycles of all samples */
+};
+
+/* DWT cycle count register, accessed directly so lwIP core files do not
+   need the CMSIS headers */
+#define LPC_PERF_CYCCNT (*(volatile u32_t *) 0xE0001004)
+
+/* PERF_START declares the start timestamp, so it must be placed where a
+   declaration is allowed (C99 when it follows statements). Each PERF_STOP()
+   call site owns a static probe that registers itself on first use. Paths
+   returning without PERF_STOP() are not sampled. */
+#define PERF_START    u32_t lpc_perf_t0 = LPC_PERF_CYCCNT
+#define PERF_STOP(x)  do { \
+		static struct lpc_perf_probe lpc_perf_p = {x}; \
+		lpc_perf_record(&lpc_perf_p, LPC_PERF_CYCCNT - lpc_perf_t0); \
+	} while (0)
+
+/**
+ * @brief	Enables the DWT cycle counter
+ * @return	Nothing
+ * @note	Called by the EMAC driver init function when LWIP_PERF is enabled
+ */
+void lpc_perf_init(void);
+
+/**
+ * @brief	Adds a sample to a probe
+ * @param	probe	: Probe to update, registered on its first sample
+ * @param	cycles	: Cycles spent between PERF_START and PERF_STOP()
+ * @return	Nothing
+ * @note	Safe to call from tasks and interrupts
+ */
+void lpc_perf_record(struct lpc_perf_probe *probe, u32_t cycles);
+
+/**
+ * @brief	Clears the accumulators of all registered probes
+ * @return	Nothing
+ */
+void lpc_perf_reset(void);
+
+/**
+ * @brief	Prints count, min, max and mean cycles of all probes
+ * @return	Nothing
+ * @note	Output goes to the board debug UART (DEBUGOUT)
+ */
+void lpc_perf_dump(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#else
 #define PERF_START    /* null definition */
 #define PERF_STOP(x)  /* null definition */
+#endif /* LWIP_PERF */
 
 #endif /* __PERF_H__ */
@@ -40,13 +40,48 @@
 #include "queue.h"
 #include "semphr.h"
 
+/* Set to 1 (normally in lwipopts.h) to build the mailboxes as lock-free
+   rings instead of FreeRTOS queues. A post only makes a kernel call when
+   the receiving task is blocked on an empty mailbox. Each mailbox must
+   have a single receiving task, which holds for the lwIP tcpip_thread,
+   netconn and socket mailboxes. */
+#ifndef SYS_ARCH_FAST_MBOX
+#define SYS_ARCH_FAST_MBOX				0
+#endif
+
+/* Set to 1 (normally in lwipopts.h) to implement SYS_ARCH_PROTECT by
+   raising BASEPRI to SYS_ARCH_PROTECT_PRIO instead of entering a FreeRTOS
+   critical section. Cortex-M0 cores have no BASEPRI and fall back to
+   PRIMASK. */
+#ifndef SYS_ARCH_BASEPRI_PROTECT
+#define SYS_ARCH_BASEPRI_PROTECT		0
+#endif
+
+/* BASEPRI value (already shifted like configMAX_SYSCALL_INTERRUPT_PRIORITY)
+   used by SYS_ARCH_PROTECT. Interrupts of a higher priority (lower value)
+   keep running inside lwIP critical regions, so they must not call lwIP.
+   Any non-zero value also masks the PendSV and SysTick interrupts, so a
+   value as low as configKERNEL_INTERRUPT_PRIORITY still stops task
+   switches. */
+#ifndef SYS_ARCH_PROTECT_PRIO
+#define SYS_ARCH_PROTECT_PRIO			configMAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+
+#if SYS_ARCH_FAST_MBOX
+#define SYS_MBOX_NULL					NULL
+#else
 #define SYS_MBOX_NULL					( ( QueueHandle_t ) NULL )
+#endif
 #define SYS_SEM_NULL					( ( SemaphoreHandle_t ) NULL )
 #define SYS_DEFAULT_THREAD_STACK_DEPTH	configMINIMAL_STACK_SIZE
 
 typedef SemaphoreHandle_t sys_sem_t;
 typedef SemaphoreHandle_t sys_mutex_t;
+#if SYS_ARCH_FAST_MBOX
+typedef struct sys_mbox_ring *sys_mbox_t;
+#else
 typedef QueueHandle_t sys_mbox_t;
+#endif
 typedef TaskHandle_t sys_thread_t;
 typedef int sys_prot_t;
 
@@ -46,6 +46,376 @@
 #include "lwip/opt.h"
 #include "lwip/stats.h"
 
+#if SYS_ARCH_FAST_MBOX || SYS_ARCH_BASEPRI_PROTECT
+#include "chip.h"
+#endif
+
+#if SYS_ARCH_BASEPRI_PROTECT && (__CORTEX_M >= 3) && (SYS_ARCH_PROTECT_PRIO == 0)
+#error SYS_ARCH_PROTECT_PRIO must be non-zero, a BASEPRI of 0 masks nothing
+#endif
+
+#if SYS_ARCH_FAST_MBOX
+/*---------------------------------------------------------------------------*
+ * Lock-free mailbox
+ *---------------------------------------------------------------------------*
+ * A bounded ring of slots with a sequence number each. Posting tasks
+ * reserve a slot by advancing head with LDREX/STREX (a PRIMASK section on
+ * the Cortex-M0), store the message and publish it through the slot
+ * sequence. The single receiving task reads at tail without any lock. The
+ * wake semaphore is only given when the receiver announced in waiting that
+ * it is about to block, so a busy tcpip_thread is fed without a kernel
+ * call per message.
+ *---------------------------------------------------------------------------*/
+struct sys_mbox_slot {
+	volatile u32_t seq;
+	void *msg;
+};
+
+struct sys_mbox_ring {
+	volatile u32_t head;			/* Next slot to reserve, shared by posters */
+	u32_t tail;						/* Next slot to read, receiver only */
+	u32_t mask;						/* Number of slots - 1 */
+	volatile u32_t waiting;			/* Receiver is (about to be) blocked */
+	SemaphoreHandle_t wake;			/* Given by a poster to unblock the receiver */
+	struct sys_mbox_slot slot[1];	/* mask + 1 slots */
+};
+
+/* Puts a message in the ring, returns 0 if the ring is full */
+static int prvMboxPut( struct sys_mbox_ring *pxRing, void *pvMsg )
+{
+struct sys_mbox_slot *pxSlot;
+u32_t ulPos;
+s32_t lDiff;
+
+	for( ;; )
+	{
+	#if __CORTEX_M >= 3
+		ulPos = __LDREXW( ( uint32_t * ) &pxRing->head );
+		pxSlot = &pxRing->slot[ ulPos & pxRing->mask ];
+		lDiff = ( s32_t ) ( pxSlot->seq - ulPos );
+
+		if( lDiff == 0 )
+		{
+			if( __STREXW( ulPos + 1, ( uint32_t * ) &pxRing->head ) == 0 )
+			{
+				break;
+			}
+		}
+		else
+		{
+			__CLREX();
+		}
+	#else
+		UBaseType_t uxMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+		ulPos = pxRing->head;
+		pxSlot = &pxRing->slot[ ulPos & pxRing->mask ];
+		lDiff = ( s32_t ) ( pxSlot->seq - ulPos );
+
+		if( lDiff == 0 )
+		{
+			pxRing->head = ulPos + 1;
+		}
+
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxMask );
+
+		if( lDiff == 0 )
+		{
+			break;
+		}
+	#endif
+
+		if( lDiff < 0 )
+		{
+			/* The slot still holds a message of the previous lap */
+			return 0;
+		}
+
+		/* Another poster took this slot, retry with the new head */
+	}
+
+	pxSlot->msg = pvMsg;
+	__DMB();
+	pxSlot->seq = ulPos + 1;
+	__DMB();
+
+	if( pxRing->waiting != 0 )
+	{
+		pxRing->waiting = 0;
+		xSemaphoreGive( pxRing->wake );
+	}
+
+	return 1;
+}
+
+/* Gets the oldest message from the ring, returns 0 if the ring is empty */
+static int prvMboxGet( struct sys_mbox_ring *pxRing, void **ppvMsg )
+{
+struct sys_mbox_slot *pxSlot;
+u32_t ulPos = pxRing->tail;
+
+	pxSlot = &pxRing->slot[ ulPos & pxRing->mask ];
+
+	if( pxSlot->seq != ulPos + 1 )
+	{
+		return 0;
+	}
+
+	__DMB();
+	*ppvMsg = pxSlot->msg;
+	__DMB();
+
+	/* Hand the slot over to the poster of the next lap */
+	pxSlot->seq = ulPos + pxRing->mask + 1;
+	pxRing->tail = ulPos + 1;
+
+	return 1;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates a new mailbox. The size is rounded up to a power of 2.
+ * Inputs:
+ *      int size                -- Size of elements in the mailbox
+ * Outputs:
+ *      sys_mbox_t              -- Handle to new mailbox
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_new( sys_mbox_t *pxMailBox, int iSize )
+{
+struct sys_mbox_ring *pxRing;
+u32_t ulSlots = 1, ulIndex;
+
+	while( ulSlots < ( u32_t ) iSize )
+	{
+		ulSlots <<= 1;
+	}
+
+	pxRing = pvPortMalloc( sizeof( struct sys_mbox_ring ) +
+						   ( ( ulSlots - 1 ) * sizeof( struct sys_mbox_slot ) ) );
+	*pxMailBox = pxRing;
+
+	if( pxRing == NULL )
+	{
+		SYS_STATS_INC( mbox.err );
+		return ERR_MEM;
+	}
+
+	vSemaphoreCreateBinary( pxRing->wake );
+
+	if( pxRing->wake == NULL )
+	{
+		vPortFree( pxRing );
+		*pxMailBox = NULL;
+		SYS_STATS_INC( mbox.err );
+		return ERR_MEM;
+	}
+
+	/* Binary semaphores are created given */
+	xSemaphoreTake( pxRing->wake, 0 );
+
+	pxRing->head = 0;
+	pxRing->tail = 0;
+	pxRing->mask = ulSlots - 1;
+	pxRing->waiting = 0;
+
+	for( ulIndex = 0; ulIndex < ulSlots; ulIndex++ )
+	{
+		pxRing->slot[ ulIndex ].seq = ulIndex;
+	}
+
+	SYS_STATS_INC_USED( mbox );
+
+	return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Deallocates a mailbox. If there are messages still present in the
+ *      mailbox when the mailbox is deallocated, it is an indication of a
+ *      programming error in lwIP and the developer should be notified.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *---------------------------------------------------------------------------*/
+void sys_mbox_free( sys_mbox_t *pxMailBox )
+{
+struct sys_mbox_ring *pxRing = *pxMailBox;
+unsigned long ulMessagesWaiting;
+
+	ulMessagesWaiting = pxRing->head - pxRing->tail;
+	configASSERT( ( ulMessagesWaiting == 0 ) );
+
+	#if SYS_STATS
+	{
+		if( ulMessagesWaiting != 0UL )
+		{
+			SYS_STATS_INC( mbox.err );
+		}
+
+		SYS_STATS_DEC( mbox.used );
+	}
+	#endif /* SYS_STATS */
+
+	vQueueDelete( pxRing->wake );
+	vPortFree( pxRing );
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_post
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Post the "msg" to the mailbox. A full mailbox is retried once per
+ *      tick, posters have no wait list.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void *data              -- Pointer to data to post
+ *---------------------------------------------------------------------------*/
+void sys_mbox_post( sys_mbox_t *pxMailBox, void *pxMessageToPost )
+{
+	while( prvMboxPut( *pxMailBox, pxMessageToPost ) == 0 )
+	{
+		vTaskDelay( 1 );
+	}
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_trypost
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Try to post the "msg" to the mailbox.  Returns immediately with
+ *      error if cannot.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void *msg               -- Pointer to data to post
+ * Outputs:
+ *      err_t                   -- ERR_OK if message posted, else ERR_MEM
+ *                                  if not.
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_trypost( sys_mbox_t *pxMailBox, void *pxMessageToPost )
+{
+err_t xReturn;
+
+	if( prvMboxPut( *pxMailBox, pxMessageToPost ) != 0 )
+	{
+		xReturn = ERR_OK;
+	}
+	else
+	{
+		/* The mailbox was already full. */
+		xReturn = ERR_MEM;
+		SYS_STATS_INC( mbox.err );
+	}
+
+	return xReturn;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_fetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Blocks the thread until a message arrives in the mailbox, but does
+ *      not block the thread longer than "timeout" milliseconds. See the
+ *      queue based version below for the full description.
+ *
+ *      The receiver sets waiting and checks the ring once more before it
+ *      blocks, so a message posted in between is either seen by that check
+ *      or followed by a give of the wake semaphore. A stale give only
+ *      causes one extra pass of the loop.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ *      u32_t timeout           -- Number of milliseconds until timeout
+ * Outputs:
+ *      u32_t                   -- SYS_ARCH_TIMEOUT if timeout, else number
+ *                                  of milliseconds until received.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_fetch( sys_mbox_t *pxMailBox, void **ppvBuffer, u32_t ulTimeOut )
+{
+	struct sys_mbox_ring *pxRing = *pxMailBox;
+	void *pvDummy;
+	TickType_t xStartTime, xElapsed, xWait;
+
+	xStartTime = xTaskGetTickCount();
+	xWait = ulTimeOut / portTICK_PERIOD_MS;
+
+	if( NULL == ppvBuffer )
+	{
+		ppvBuffer = &pvDummy;
+	}
+
+	while( prvMboxGet( pxRing, ppvBuffer ) == 0 )
+	{
+		pxRing->waiting = 1;
+		__DMB();
+
+		if( prvMboxGet( pxRing, ppvBuffer ) != 0 )
+		{
+			break;
+		}
+
+		if( ulTimeOut != 0UL )
+		{
+			xElapsed = xTaskGetTickCount() - xStartTime;
+
+			if( xElapsed >= xWait )
+			{
+				/* Timed out. */
+				pxRing->waiting = 0;
+				*ppvBuffer = NULL;
+				return SYS_ARCH_TIMEOUT;
+			}
+
+			xSemaphoreTake( pxRing->wake, xWait - xElapsed );
+		}
+		else
+		{
+			xSemaphoreTake( pxRing->wake, portMAX_DELAY );
+		}
+	}
+
+	pxRing->waiting = 0;
+
+	xElapsed = ( xTaskGetTickCount() - xStartTime ) * portTICK_PERIOD_MS;
+
+	if( ( ulTimeOut == 0UL ) && ( xElapsed == 0UL ) )
+	{
+		xElapsed = 1UL;
+	}
+
+	return xElapsed;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_tryfetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Similar to sys_arch_mbox_fetch, but if message is not ready
+ *      immediately, we'll return with SYS_MBOX_EMPTY.  On success, 0 is
+ *      returned.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ * Outputs:
+ *      u32_t                   -- SYS_MBOX_EMPTY if no messages.  Otherwise,
+ *                                  return ERR_OK.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_tryfetch( sys_mbox_t *pxMailBox, void **ppvBuffer )
+{
+void *pvDummy;
+
+	if( ppvBuffer == NULL )
+	{
+		ppvBuffer = &pvDummy;
+	}
+
+	return ( prvMboxGet( *pxMailBox, ppvBuffer ) != 0 ) ? ERR_OK : SYS_MBOX_EMPTY;
+}
+
+#else /* SYS_ARCH_FAST_MBOX */
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_mbox_new
  *---------------------------------------------------------------------------*
@@ -257,6 +627,8 @@ unsigned long ulReturn;
 	return ulReturn;
 }
 
+#endif /* SYS_ARCH_FAST_MBOX */
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_sem_new
  *---------------------------------------------------------------------------*
@@ -498,13 +870,36 @@ sys_thread_t sys_thread_new( const char *pcName, void( *pxThread )( void *pvPara
  *
  *      sys_arch_protect() is only required if your port is supporting an
  *      operating system.
+ *
+ *      With SYS_ARCH_BASEPRI_PROTECT the previous BASEPRI (PRIMASK on the
+ *      Cortex-M0) is returned. This skips the critical nesting count of
+ *      the kernel, works from interrupts and leaves interrupts above
+ *      SYS_ARCH_PROTECT_PRIO unmasked.
  * Outputs:
- *      sys_prot_t              -- Previous protection level (not used here)
+ *      sys_prot_t              -- Previous protection level
  *---------------------------------------------------------------------------*/
 sys_prot_t sys_arch_protect( void )
 {
+#if SYS_ARCH_BASEPRI_PROTECT
+#if __CORTEX_M >= 3
+	uint32_t ulPrevious = __get_BASEPRI();
+
+	/* Only raise the mask, a nested call must not unmask anything */
+	if( ( ulPrevious == 0 ) || ( ulPrevious > ( SYS_ARCH_PROTECT_PRIO ) ) )
+	{
+		__set_BASEPRI( SYS_ARCH_PROTECT_PRIO );
+		__DSB();
+		__ISB();
+	}
+
+	return ( sys_prot_t ) ulPrevious;
+#else
+	return ( sys_prot_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+#endif
+#else
 	vPortEnterCritical();
 	return ( sys_prot_t ) 1;
+#endif
 }
 
 /*---------------------------------------------------------------------------*
@@ -516,12 +911,20 @@ sys_prot_t sys_arch_protect( void )
  *      sys_arch_protect() for more information. This function is only
  *      required if your port is supporting an operating system.
  * Inputs:
- *      sys_prot_t              -- Previous protection level (not used here)
+ *      sys_prot_t              -- Previous protection level
  *---------------------------------------------------------------------------*/
 void sys_arch_unprotect( sys_prot_t xValue )
 {
+#if SYS_ARCH_BASEPRI_PROTECT
+#if __CORTEX_M >= 3
+	__set_BASEPRI( ( uint32_t ) xValue );
+#else
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( ( UBaseType_t ) xValue );
+#endif
+#else
 	(void) xValue;
 	taskEXIT_CRITICAL();
+#endif
 }
 
 /*
@@ -0,0 +1,172 @@
+/*
+ * @brief Host test of the LPC lwIP checksum routines against inet_chksum()
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2014
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+/* Builds and runs on the host (from software/lwip):
+ *
+ *   I="-Ilpclwip -Ilwip/src/include -Ilwip/src/include/ipv4 -Ilwip/test/unit"
+ *   gcc $I -DLPC_FAST_CHKSUM=0 -c lwip/src/core/ipv4/inet_chksum.c lwip/src/core/def.c
+ *   gcc $I -O2 -o chksum_test lpclwip/test/chksum_test.c \
+ *       lpclwip/arch/lpc_chksum.c inet_chksum.o def.o
+ *   ./chksum_test
+ *
+ * The reference objects are built with LPC_FAST_CHKSUM=0 so inet_chksum()
+ * uses the lwIP reference algorithm. Every length up to TEST_MAXLEN is
+ * checked at all source and destination word alignments.
+ */
+
+#include "lwip/opt.h"
+#include "lwip/inet_chksum.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !LPC_FAST_CHKSUM
+#error chksum_test.c must be built with LPC_FAST_CHKSUM enabled
+#endif
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Longest buffer tested at every length, covers a full Ethernet frame */
+#define TEST_MAXLEN     1600
+
+/* Guard bytes around the copy destination */
+#define TEST_GUARD      8
+#define TEST_GUARD_VAL  0xA5
+
+static u32_t src_buff[(0xFFFF + 8) / 4];
+static u32_t dst_buff[(0xFFFF + 8 + (2 * TEST_GUARD)) / 4];
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void fill_random(u8_t *p, int len)
+{
+	while (len-- > 0) {
+		*p++ = (u8_t) rand();
+	}
+}
+
+/* Checks both routines on one buffer, returns 0 if they match inet_chksum */
+static int check_one(int len, int salign, int dalign)
+{
+	u8_t *src = (u8_t *) src_buff + salign;
+	u8_t *dst = (u8_t *) dst_buff + TEST_GUARD + dalign;
+	u16_t ref, sum, csum;
+	int i;
+
+	ref = (u16_t) ~inet_chksum(src, (u16_t) len);
+	sum = lpc_chksum(src, len);
+
+	memset(dst_buff, TEST_GUARD_VAL, sizeof(dst_buff));
+	csum = lpc_chksum_copy(dst, src, (u16_t) len);
+
+	if (sum != ref) {
+		printf("lpc_chksum: len %d align %d: 0x%04x, expected 0x%04x\n",
+			   len, salign, sum, ref);
+		return 1;
+	}
+	if (csum != ref) {
+		printf("lpc_chksum_copy: len %d align %d/%d: 0x%04x, expected 0x%04x\n",
+			   len, salign, dalign, csum, ref);
+		return 1;
+	}
+	if (memcmp(dst, src, len) != 0) {
+		printf("lpc_chksum_copy: len %d align %d/%d: data mismatch\n",
+			   len, salign, dalign);
+		return 1;
+	}
+	for (i = 0; i < TEST_GUARD + dalign; i++) {
+		if ((dst - 1 - i)[0] != TEST_GUARD_VAL) {
+			printf("lpc_chksum_copy: len %d align %d/%d: underrun\n",
+				   len, salign, dalign);
+			return 1;
+		}
+	}
+	for (i = 0; i < TEST_GUARD; i++) {
+		if (dst[len + i] != TEST_GUARD_VAL) {
+			printf("lpc_chksum_copy: len %d align %d/%d: overrun\n",
+				   len, salign, dalign);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* LWIP_PLATFORM_ASSERT target of arch/cc.h (no LWIP_DEBUG) */
+void assert_loop(void)
+{
+	printf("lwIP assertion failed\n");
+	exit(2);
+}
+
+int main(void)
+{
+	int len, salign, dalign, checks = 0;
+
+	srand(1);
+
+	/* Every length at every alignment with random data */
+	for (len = 0; len <= TEST_MAXLEN; len++) {
+		for (salign = 0; salign < 4; salign++) {
+			for (dalign = 0; dalign < 4; dalign++) {
+				fill_random((u8_t *) src_buff, len + 4);
+				failures += check_one(len, salign, dalign);
+				checks++;
+			}
+		}
+	}
+
+	/* Carry heavy data up to the longest pbuf */
+	for (salign = 0; salign < 4; salign++) {
+		memset(src_buff, 0xFF, sizeof(src_buff));
+		failures += check_one(0xFFFF, salign, salign ^ 1);
+		memset(src_buff, 0, sizeof(src_buff));
+		failures += check_one(0xFFFF, salign, salign);
+		fill_random((u8_t *) src_buff, sizeof(src_buff));
+		failures += check_one(0xFFFF - salign, salign, 3 - salign);
+		checks += 3;
+	}
+
+	printf("%d checks, %d failures\n", checks, failures);
+
+	return failures != 0;
+}
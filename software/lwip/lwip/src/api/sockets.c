@@ -80,6 +80,10 @@ struct lwip_sock {
   int err;
   /** counter of how many threads are waiting for this socket using select */
   int select_waiting;
+#if LWIP_PBUF_TIMESTAMP
+  /** hardware timestamp of the data last taken from the network */
+  struct pbuf_ts rcvts;
+#endif /* LWIP_PBUF_TIMESTAMP */
 };
 
 /** Description for a task waiting in select */
@@ -256,6 +260,10 @@ alloc_socket(struct netconn *newconn, int accepted)
       SYS_ARCH_UNPROTECT(lev);
       sockets[i].lastdata   = NULL;
       sockets[i].lastoffset = 0;
+#if LWIP_PBUF_TIMESTAMP
+      sockets[i].rcvts.sec  = 0;
+      sockets[i].rcvts.nsec = 0;
+#endif /* LWIP_PBUF_TIMESTAMP */
       sockets[i].rcvevent   = 0;
       /* TCP sendbuf is empty, but the socket is not yet writable until connected
        * (unless it has been created by accept()). */
@@ -624,6 +632,13 @@ lwip_recvfrom(int s, void *mem, size_t len, int flags,
       }
       LWIP_ASSERT("buf != NULL", buf != NULL);
       sock->lastdata = buf;
+#if LWIP_PBUF_TIMESTAMP
+      if (netconn_type(sock->conn) == NETCONN_TCP) {
+        sock->rcvts = ((struct pbuf *)buf)->ts;
+      } else {
+        sock->rcvts = ((struct netbuf *)buf)->p->ts;
+      }
+#endif /* LWIP_PBUF_TIMESTAMP */
     }
 
     if (netconn_type(sock->conn) == NETCONN_TCP) {
@@ -1505,6 +1520,14 @@ lwip_getsockopt(int s, int level, int optname, void *optval, socklen_t *optlen)
       }
       break;
 
+#if LWIP_PBUF_TIMESTAMP
+    case SO_TIMESTAMPNS:
+      if (*optlen < sizeof(struct pbuf_ts)) {
+        err = EINVAL;
+      }
+      break;
+#endif /* LWIP_PBUF_TIMESTAMP */
+
     case SO_NO_CHECK:
       if (*optlen < sizeof(int)) {
         err = EINVAL;
@@ -1748,6 +1771,11 @@ lwip_getsockopt_internal(void *arg)
       *(int*)optval = (udp_flags(sock->conn->pcb.udp) & UDP_FLAGS_NOCHKSUM) ? 1 : 0;
       break;
 #endif /* LWIP_UDP*/
+#if LWIP_PBUF_TIMESTAMP
+    case SO_TIMESTAMPNS:
+      *(struct pbuf_ts *)optval = sock->rcvts;
+      break;
+#endif /* LWIP_PBUF_TIMESTAMP */
     default:
       LWIP_ASSERT("unhandled optname", 0);
       break;
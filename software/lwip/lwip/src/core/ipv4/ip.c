@@ -312,6 +312,8 @@ ip_input(struct pbuf *p, struct netif *inp)
   int check_ip_src=1;
 #endif /* IP_ACCEPT_LINK_LAYER_ADDRESSING */
 
+  PERF_START;
+
   IP_STATS_INC(ip.recv);
   snmp_inc_ipinreceives();
 
@@ -609,6 +611,7 @@ ip_input(struct pbuf *p, struct netif *inp)
   ip_addr_set_any(&current_iphdr_src);
   ip_addr_set_any(&current_iphdr_dest);
 
+  PERF_STOP("ip_input");
   return ERR_OK;
 }
 
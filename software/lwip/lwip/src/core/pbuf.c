@@ -84,6 +84,12 @@
    aligned there. Therefore, PBUF_POOL_BUFSIZE_ALIGNED can be used here. */
 #define PBUF_POOL_BUFSIZE_ALIGNED LWIP_MEM_ALIGN_SIZE(PBUF_POOL_BUFSIZE)
 
+#if LWIP_PBUF_TIMESTAMP
+#define PBUF_TS_CLEAR(p) do { (p)->ts.sec = 0; (p)->ts.nsec = 0; } while(0)
+#else /* LWIP_PBUF_TIMESTAMP */
+#define PBUF_TS_CLEAR(p)
+#endif /* LWIP_PBUF_TIMESTAMP */
+
 #if !LWIP_TCP || !TCP_QUEUE_OOSEQ || !PBUF_POOL_FREE_OOSEQ
 #define PBUF_POOL_IS_EMPTY()
 #else /* !LWIP_TCP || !TCP_QUEUE_OOSEQ || !PBUF_POOL_FREE_OOSEQ */
@@ -294,6 +300,7 @@ pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
                   ((u8_t*)p->payload + p->len <=
                    (u8_t*)p + SIZEOF_STRUCT_PBUF + PBUF_POOL_BUFSIZE_ALIGNED));
       q->ref = 1;
+      PBUF_TS_CLEAR(q);
       /* calculate remaining length to be allocated */
       rem_len -= q->len;
       /* remember this pbuf for linkage in next iteration */
@@ -344,6 +351,7 @@ pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
   p->ref = 1;
   /* set flags */
   p->flags = 0;
+  PBUF_TS_CLEAR(p);
   LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_TRACE, ("pbuf_alloc(length=%"U16_F") == %p\n", length, (void *)p));
   return p;
 }
@@ -407,6 +415,7 @@ pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_cust
   p->pbuf.len = p->pbuf.tot_len = length;
   p->pbuf.type = type;
   p->pbuf.ref = 1;
+  PBUF_TS_CLEAR(&p->pbuf);
   return &p->pbuf;
 }
 #endif /* LWIP_SUPPORT_CUSTOM_PBUF */
@@ -620,6 +629,7 @@ pbuf_free(struct pbuf *p)
   u16_t type;
   struct pbuf *q;
   u8_t count;
+  PERF_START;
 
   if (p == NULL) {
     LWIP_ASSERT("p != NULL", p != NULL);
@@ -630,8 +640,6 @@ pbuf_free(struct pbuf *p)
   }
   LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_TRACE, ("pbuf_free(%p)\n", (void *)p));
 
-  PERF_START;
-
   LWIP_ASSERT("pbuf_free: sane type",
     p->type == PBUF_RAM || p->type == PBUF_ROM ||
     p->type == PBUF_REF || p->type == PBUF_POOL);
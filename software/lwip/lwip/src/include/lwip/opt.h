@@ -1104,6 +1104,16 @@
 #define PBUF_POOL_BUFSIZE               LWIP_MEM_ALIGN_SIZE(TCP_MSS+40+PBUF_LINK_HLEN)
 #endif
 
+/**
+ * LWIP_PBUF_TIMESTAMP==1: Add a hardware timestamp (struct pbuf_ts) to every
+ * pbuf. The netif driver fills it for received frames, it is zero otherwise.
+ * Sockets return the timestamp of the last received data with the
+ * SO_TIMESTAMPNS socket option.
+ */
+#ifndef LWIP_PBUF_TIMESTAMP
+#define LWIP_PBUF_TIMESTAMP             0
+#endif
+
 /*
    ------------------------------------------------
    ---------- Network Interfaces options ----------
@@ -76,6 +76,14 @@ typedef enum {
 /** indicates this pbuf includes a TCP FIN flag */
 #define PBUF_FLAG_TCP_FIN   0x20U
 
+#if LWIP_PBUF_TIMESTAMP
+/** Hardware timestamp of a frame, seconds and nanoseconds */
+struct pbuf_ts {
+  u32_t sec;
+  u32_t nsec;
+};
+#endif /* LWIP_PBUF_TIMESTAMP */
+
 struct pbuf {
   /** next pbuf in singly linked pbuf chain */
   struct pbuf *next;
@@ -107,6 +115,11 @@ struct pbuf {
    * the stack itself, or pbuf->next pointers from a chain.
    */
   u16_t ref;
+
+#if LWIP_PBUF_TIMESTAMP
+  /** hardware timestamp, set by the netif driver (zero if none) */
+  struct pbuf_ts ts;
+#endif /* LWIP_PBUF_TIMESTAMP */
 };
 
 #if LWIP_SUPPORT_CUSTOM_PBUF
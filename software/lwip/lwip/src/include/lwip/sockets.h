@@ -102,6 +102,7 @@ typedef u32_t socklen_t;
 #define SO_TYPE      0x1008    /* get socket type */
 #define SO_CONTIMEO  0x1009    /* Unimplemented: connect timeout */
 #define SO_NO_CHECK  0x100a    /* don't create UDP checksum */
+#define SO_TIMESTAMPNS 0x100b  /* get hardware RX timestamp (struct pbuf_ts) of the last received data */
 
 
 /*